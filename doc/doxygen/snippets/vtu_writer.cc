@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @brief Illustrate usage of VtuWriter
+ * @copyright MIT License
+ */
+
+#include <lf/io/io.h>
+
+namespace lf::io {
+
+void vtuUsage() {
+  //! [usage]
+  std::shared_ptr<mesh::Mesh> mesh;  // initialize mesh somehow
+
+  // data stored with codim=0 entities
+  std::shared_ptr<mesh::utils::MeshDataSet<double>> cell_data;
+
+  // A Mesh function representing the function sin(x)*cos(y)
+  auto mf = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d& x) { return std::sin(x[0]) * std::cos(x[1]); });
+
+  // zlib compressed output, double values are not converted to float
+  io::VtuWriterOptions options;
+  options.compress = true;
+  options.double_precision = true;
+  io::VtuWriter vtu_writer(mesh, "filename.vtu", 0, options);
+  // every call writes the array to disk right away
+  vtu_writer.WriteCellData("cellData", *cell_data);
+  vtu_writer.WritePointData("mfPoint", mf);
+  // writes the final file, otherwise done by the destructor
+  vtu_writer.Close();
+  //! [usage]
+}
+
+}  // namespace lf::io
@@ -0,0 +1,80 @@
+/** @file assembly_benchmark.cc
+ *  @brief Runtime of the assembly of Galerkin matrices with and without the
+ *  debugging output hooks
+ *
+ *  Usage: `assembly_benchmark [cells_per_direction] [repetitions]`
+ *
+ *  Assembles the Galerkin matrix of \f$-\Delta u + u\f$ for linear and
+ *  quadratic Lagrangian finite elements on a structured triangular mesh of the
+ *  unit square with lf::assemble::AssembleMatrixLocally() and
+ *  lf::uscalfe::ReactionDiffusionElementMatrixProvider.
+ *
+ *  By default the SWITCHEDSTATEMENT hooks in the assembly loops are evaluated
+ *  as usual. If LehrFEM++ is configured with the CMake option
+ *  `LF_PRODUCTION_MODE=ON`, they are compiled out of the libraries and of this
+ *  program alike. Comparing the timings of two builds, one with and one
+ *  without the option, shows the cost of the hooks.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "lf/assemble/assemble.h"
+#include "lf/mesh/hybrid2d/hybrid2d.h"
+#include "lf/mesh/utils/utils.h"
+#include "lf/uscalfe/uscalfe.h"
+
+namespace {
+
+// Average time of `reps` assemblies in milliseconds
+template <class FE_SPACE>
+double TimeAssembly(const std::shared_ptr<FE_SPACE> &fe_space,
+                    unsigned int reps) {
+  const lf::assemble::DofHandler &dofh{fe_space->LocGlobMap()};
+  const lf::mesh::utils::MeshFunctionConstant<double> one(1.0);
+  lf::uscalfe::ReactionDiffusionElementMatrixProvider provider(fe_space, one,
+                                                               one);
+  lf::assemble::COOMatrix<double> matrix(dofh.NumDofs(), dofh.NumDofs());
+  double trace = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int r = 0; r < reps; ++r) {
+    matrix.setZero();
+    lf::assemble::AssembleMatrixLocally(0, dofh, dofh, provider, matrix);
+    trace += matrix.triplets().front().value();
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  // prevent that the assembly is optimized away
+  std::cout << "(checksum " << trace << ") ";
+  return elapsed.count() / reps;
+}
+
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+  const unsigned int n = (argc > 1) ? std::stoul(argv[1]) : 400;
+  const unsigned int reps = (argc > 2) ? std::stoul(argv[2]) : 5;
+
+#ifdef LF_PRODUCTION_MODE
+  std::cout << "Production mode: debugging output compiled out" << std::endl;
+#else
+  std::cout << "Default mode: debugging output hooks active" << std::endl;
+#endif
+
+  auto factory = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  lf::mesh::hybrid2d::TPTriagMeshBuilder builder(std::move(factory));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(n)
+      .setNumYCells(n);
+  const std::shared_ptr<const lf::mesh::Mesh> mesh = builder.Build();
+  std::cout << "Mesh with " << mesh->NumEntities(0) << " cells" << std::endl;
+
+  const double t_o1 = TimeAssembly(
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh), reps);
+  std::cout << "linear FE: " << t_o1 << " ms" << std::endl;
+  const double t_o2 = TimeAssembly(
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO2<double>>(mesh), reps);
+  std::cout << "quadratic FE: " << t_o2 << " ms" << std::endl;
+  return 0;
+}
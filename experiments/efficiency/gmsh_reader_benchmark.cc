@@ -0,0 +1,79 @@
+/** @file gmsh_reader_benchmark.cc
+ *  @brief Load time and peak memory consumption of lf::io::ReadGmshFile()
+ *
+ *  Usage: `gmsh_reader_benchmark <file.msh> [mmap|copy] [num_threads]`
+ *
+ *  - `mmap` (default): the file is mapped into memory and parsed directly
+ *  - `copy`: the file is first copied into a `std::string` character by
+ *    character (the former behavior of `ReadGmshFile()`) and then parsed
+ *  - `num_threads` (default 1): number of threads used to decode the nodes
+ *    and elements of binary v4.1 files
+ *
+ *  Peak memory is a property of the whole process, therefore only one of the
+ *  two variants is run per invocation.
+ */
+
+#include <boost/timer/timer.hpp>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include "lf/io/io.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Peak resident set size in MB, negative if not available
+double PeakRssMB() {
+#if defined(__APPLE__)
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#elif defined(__unix__)
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#else
+  return -1.0;
+#endif
+}
+
+int main(int argc, const char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <file.msh> [mmap|copy] [num_threads]" << std::endl;
+    return 1;
+  }
+  const std::string filename(argv[1]);
+  const std::string mode((argc > 2) ? argv[2] : "mmap");
+  const unsigned int num_threads = (argc > 3) ? std::stoul(argv[3]) : 1;
+
+  std::cout << "Reading " << filename << " (" << mode << ", " << num_threads
+            << " threads)" << std::endl;
+  std::size_t num_nodes = 0;
+  {
+    boost::timer::auto_cpu_timer t;
+    std::variant<lf::io::GMshFileV2, lf::io::GMshFileV4> msh_file;
+    if (mode == "copy") {
+      std::ifstream in(filename, std::ios_base::in | std::ios_base::binary);
+      std::string storage;
+      in.unsetf(std::ios::skipws);
+      std::copy(std::istream_iterator<char>(in), std::istream_iterator<char>(),
+                std::back_inserter(storage));
+      msh_file = lf::io::ReadGmshFile(
+          storage.data(), storage.data() + storage.size(), filename,
+          num_threads);
+    } else {
+      msh_file = lf::io::ReadGmshFile(filename, num_threads);
+    }
+    if (const auto *v2 = std::get_if<lf::io::GMshFileV2>(&msh_file)) {
+      num_nodes = v2->Nodes.size();
+    } else {
+      num_nodes = std::get<lf::io::GMshFileV4>(msh_file).nodes.num_nodes;
+    }
+  }
+  std::cout << num_nodes << " nodes read" << std::endl;
+  std::cout << "Peak RSS: " << PeakRssMB() << " MB" << std::endl;
+  return 0;
+}
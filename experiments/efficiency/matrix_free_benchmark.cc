@@ -0,0 +1,97 @@
+/** @file matrix_free_benchmark.cc
+ *  @brief Runtime of matrix-vector products with an assembled Galerkin matrix
+ *  and with lf::uscalfe::MatrixFreeReactionDiffusionOperator
+ *
+ *  Usage: `matrix_free_benchmark [cells_per_direction] [repetitions]`
+ *
+ *  For Lagrangian finite elements of degree 1, 2 and 3 on a structured
+ *  quadrilateral mesh of the unit square, the Galerkin matrix of
+ *  \f$-\Delta u + u\f$ is built once with
+ *  lf::uscalfe::ReactionDiffusionElementMatrixProvider and
+ *  lf::assemble::AssembleMatrixLocally() and once as a matrix-free operator,
+ *  which uses sum factorization on the quadrilaterals. The time of the setup
+ *  and the average time of a product with a vector are reported for both.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "lf/assemble/assemble.h"
+#include "lf/mesh/hybrid2d/hybrid2d.h"
+#include "lf/mesh/utils/utils.h"
+#include "lf/uscalfe/uscalfe.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+// Average time of `reps` products y = A*x in milliseconds
+template <class MATRIX>
+double TimeProducts(const MATRIX &A, unsigned int reps) {
+  const Eigen::VectorXd x{Eigen::VectorXd::LinSpaced(A.cols(), -1.0, 1.0)};
+  Eigen::VectorXd y(A.rows());
+  double checksum = 0.0;
+  const auto start = Clock::now();
+  for (unsigned int r = 0; r < reps; ++r) {
+    y.noalias() = A * x;
+    checksum += y[r % y.size()];
+  }
+  const Milliseconds elapsed = Clock::now() - start;
+  // prevent that the products are optimized away
+  std::cout << "(checksum " << checksum << ") ";
+  return elapsed.count() / reps;
+}
+
+template <class FE_SPACE>
+void Compare(const std::shared_ptr<FE_SPACE> &fe_space, unsigned int reps) {
+  const lf::mesh::utils::MeshFunctionConstant<double> one(1.0);
+  const lf::assemble::DofHandler &dofh{fe_space->LocGlobMap()};
+  std::cout << dofh.NumDofs() << " dofs" << std::endl;
+
+  auto start = Clock::now();
+  lf::uscalfe::ReactionDiffusionElementMatrixProvider provider(fe_space, one,
+                                                               one);
+  lf::assemble::COOMatrix<double> coo(dofh.NumDofs(), dofh.NumDofs());
+  lf::assemble::AssembleMatrixLocally(0, dofh, dofh, provider, coo);
+  const Eigen::SparseMatrix<double> A{coo.makeSparse()};
+  const Milliseconds t_assemble = Clock::now() - start;
+  std::cout << "  assembled:   setup " << t_assemble.count() << " ms, "
+            << std::flush;
+  const double t_assembled = TimeProducts(A, reps);
+  std::cout << "product " << t_assembled << " ms" << std::endl;
+
+  start = Clock::now();
+  const lf::uscalfe::MatrixFreeReactionDiffusionOperator op(fe_space, one,
+                                                            one);
+  const Milliseconds t_setup = Clock::now() - start;
+  std::cout << "  matrix-free: setup " << t_setup.count() << " ms, "
+            << std::flush;
+  const double t_matrix_free = TimeProducts(op, reps);
+  std::cout << "product " << t_matrix_free << " ms" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+  const unsigned int n = (argc > 1) ? std::stoul(argv[1]) : 200;
+  const unsigned int reps = (argc > 2) ? std::stoul(argv[2]) : 20;
+
+  lf::mesh::hybrid2d::TPQuadMeshBuilder builder(
+      std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(n)
+      .setNumYCells(n);
+  const std::shared_ptr<const lf::mesh::Mesh> mesh = builder.Build();
+  std::cout << "Mesh with " << mesh->NumEntities(0) << " quadrilaterals"
+            << std::endl;
+
+  std::cout << "Degree 1: ";
+  Compare(std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh), reps);
+  std::cout << "Degree 2: ";
+  Compare(std::make_shared<lf::uscalfe::FeSpaceLagrangeO2<double>>(mesh), reps);
+  std::cout << "Degree 3: ";
+  Compare(std::make_shared<lf::uscalfe::FeSpaceLagrangeO3<double>>(mesh), reps);
+  return 0;
+}
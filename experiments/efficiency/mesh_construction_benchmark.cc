@@ -0,0 +1,57 @@
+/** @file mesh_construction_benchmark.cc
+ *  @brief Runtime of lf::mesh::hybrid2d::MeshFactory::Build() for meshes of
+ *  various sizes
+ *
+ *  Usage: `mesh_construction_benchmark [max_cells_per_direction]`
+ *
+ *  For every size a structured triangular mesh of the unit square with
+ *  `2*n*n` cells is registered with a MeshFactory, only the call to `Build()`
+ *  is timed. This covers the creation of the edges from the cells and the
+ *  setup of all topological relationships.
+ */
+
+#include <boost/timer/timer.hpp>
+#include <iostream>
+#include <string>
+#include "lf/mesh/hybrid2d/hybrid2d.h"
+
+int main(int argc, const char *argv[]) {
+  const unsigned int max_n = (argc > 1) ? std::stoul(argv[1]) : 1024;
+
+  std::cout << "Mesh construction benchmark, " << lf::base::DefaultNumThreads()
+            << " hardware threads" << std::endl;
+  for (unsigned int n = 32; n <= max_n; n *= 2) {
+    lf::mesh::hybrid2d::MeshFactory factory(2);
+    // nodes of an (n+1) x (n+1) grid
+    for (unsigned int j = 0; j <= n; ++j) {
+      for (unsigned int i = 0; i <= n; ++i) {
+        factory.AddPoint(Eigen::Vector2d(static_cast<double>(i) / n,
+                                         static_cast<double>(j) / n));
+      }
+    }
+    // every square is split into two triangles
+    for (unsigned int j = 0; j < n; ++j) {
+      for (unsigned int i = 0; i < n; ++i) {
+        const unsigned int p0 = j * (n + 1) + i;
+        const unsigned int p1 = p0 + 1;
+        const unsigned int p2 = p0 + n + 2;
+        const unsigned int p3 = p0 + n + 1;
+        factory.AddEntity(lf::base::RefEl::kTria(),
+                          std::vector<lf::base::size_type>{p0, p1, p2},
+                          nullptr);
+        factory.AddEntity(lf::base::RefEl::kTria(),
+                          std::vector<lf::base::size_type>{p0, p2, p3},
+                          nullptr);
+      }
+    }
+    std::cout << 2 * n * n << " cells:";
+    std::shared_ptr<lf::mesh::Mesh> mesh;
+    {
+      boost::timer::auto_cpu_timer t;
+      mesh = factory.Build();
+    }
+    LF_VERIFY_MSG(mesh->NumEntities(1) == 3 * n * n + 2 * n,
+                  "Wrong number of edges");
+  }
+  return 0;
+}
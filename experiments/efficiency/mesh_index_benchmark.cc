@@ -0,0 +1,111 @@
+/** @file mesh_index_benchmark.cc
+ *  @brief Cost of a call to lf::mesh::Mesh::Index()
+ *
+ *  Usage: `mesh_index_benchmark [cells_per_direction] [repetitions]`
+ *
+ *  Compares the current implementation, which reads the index stored in the
+ *  lf::mesh::Entity base class, with the former implementation of
+ *  `lf::mesh::hybrid2d::Mesh::Index()`, which was a virtual method that
+ *  dispatched on the type of the entity and used a `dynamic_cast` to the
+ *  concrete entity type. The latter is reproduced below.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "lf/mesh/hybrid2d/hybrid2d.h"
+#include "lf/mesh/utils/utils.h"
+
+namespace {
+
+using size_type = lf::base::size_type;
+
+// Interface with a virtual Index() method, as lf::mesh::Mesh used to have
+class IndexInterface {
+ public:
+  IndexInterface() = default;
+  IndexInterface(const IndexInterface &) = delete;
+  IndexInterface(IndexInterface &&) = delete;
+  IndexInterface &operator=(const IndexInterface &) = delete;
+  IndexInterface &operator=(IndexInterface &&) = delete;
+  virtual ~IndexInterface() = default;
+  [[nodiscard]] virtual size_type Index(const lf::mesh::Entity &e) const = 0;
+};
+
+// The former implementation of lf::mesh::hybrid2d::Mesh::Index()
+class LegacyIndex : public IndexInterface {
+ public:
+  [[nodiscard]] size_type Index(const lf::mesh::Entity &e) const override {
+    namespace h2d = lf::mesh::hybrid2d;
+    switch (e.Codim()) {
+      case 0: {
+        if (e.RefEl() == lf::base::RefEl::kTria()) {
+          return dynamic_cast<const h2d::Triangle &>(e).index();
+        }
+        if (e.RefEl() == lf::base::RefEl::kQuad()) {
+          return dynamic_cast<const h2d::Quadrilateral &>(e).index();
+        }
+        LF_VERIFY_MSG(false, "Illegal cell type");
+      }
+      case 1:
+        return dynamic_cast<const h2d::Segment &>(e).index();
+      case 2:
+        return dynamic_cast<const h2d::Point &>(e).index();
+      default:
+        LF_VERIFY_MSG(false, "Illegal codim");
+    }
+  }
+};
+
+// Sum of the indices of all entities, repeated `reps` times. Returns the time
+// per call in nanoseconds.
+template <class INDEX_FN>
+double TimePerCall(const lf::mesh::Mesh &mesh, unsigned int reps,
+                   INDEX_FN &&index_fn) {
+  std::size_t sum = 0;
+  std::size_t num_calls = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int r = 0; r < reps; ++r) {
+    for (unsigned int codim = 0; codim <= 2; ++codim) {
+      for (const lf::mesh::Entity *e : mesh.Entities(codim)) {
+        sum += index_fn(*e);
+      }
+      num_calls += mesh.NumEntities(codim);
+    }
+  }
+  const std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  // prevent that the loop is optimized away
+  std::cout << "(checksum " << sum << ") ";
+  return elapsed.count() / static_cast<double>(num_calls);
+}
+
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+  const unsigned int n = (argc > 1) ? std::stoul(argv[1]) : 300;
+  const unsigned int reps = (argc > 2) ? std::stoul(argv[2]) : 20;
+
+  auto factory = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  lf::mesh::hybrid2d::TPTriagMeshBuilder builder(std::move(factory));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(n)
+      .setNumYCells(n);
+  const std::shared_ptr<const lf::mesh::Mesh> mesh = builder.Build();
+  std::cout << "Mesh with " << mesh->NumEntities(0) << " cells, "
+            << mesh->NumEntities(1) << " edges, " << mesh->NumEntities(2)
+            << " nodes" << std::endl;
+
+  const std::unique_ptr<const IndexInterface> legacy =
+      std::make_unique<LegacyIndex>();
+  const double t_legacy = TimePerCall(
+      *mesh, reps, [&](const lf::mesh::Entity &e) { return legacy->Index(e); });
+  std::cout << "virtual + dynamic_cast: " << t_legacy << " ns/call"
+            << std::endl;
+
+  const double t_now = TimePerCall(
+      *mesh, reps, [&](const lf::mesh::Entity &e) { return mesh->Index(e); });
+  std::cout << "lf::mesh::Mesh::Index(): " << t_now << " ns/call" << std::endl;
+  return 0;
+}
@@ -0,0 +1,75 @@
+/** @file refinement_benchmark.cc
+ *  @brief Runtime of uniform and adaptive refinement with
+ *  lf::refinement::MeshHierarchy
+ *
+ *  Usage: `refinement_benchmark [cells_per_direction] [levels]`
+ *
+ *  Starting from a structured triangular mesh of the unit square with
+ *  `2*n*n` cells, a hierarchy with the given number of levels is generated
+ *  twice: with MeshHierarchy::RefineRegular() and with
+ *  MeshHierarchy::RefineRegularParallel(). Every refinement step is timed.
+ *
+ *  Then the same mesh is refined adaptively towards the corner at the
+ *  origin: only the edges touching the corner are marked, so that every call
+ *  of MeshHierarchy::RefineMarked() changes the large mesh only locally. This
+ *  is done without and with MeshHierarchy::SetIncrementalRefinement(), which
+ *  lets the refined meshes share the geometry of all copied entities.
+ */
+
+#include <boost/timer/timer.hpp>
+#include <iostream>
+#include <string>
+#include "lf/mesh/hybrid2d/hybrid2d.h"
+#include "lf/mesh/utils/utils.h"
+#include "lf/refinement/refinement.h"
+
+int main(int argc, const char *argv[]) {
+  const unsigned int n = (argc > 1) ? std::stoul(argv[1]) : 128;
+  const unsigned int levels = (argc > 2) ? std::stoul(argv[2]) : 4;
+
+  std::cout << "Uniform refinement benchmark, " << lf::base::DefaultNumThreads()
+            << " hardware threads" << std::endl;
+  lf::mesh::hybrid2d::TPTriagMeshBuilder builder(
+      std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(n)
+      .setNumYCells(n);
+  const std::shared_ptr<lf::mesh::Mesh> mesh = builder.Build();
+
+  for (const bool parallel : {false, true}) {
+    std::cout << (parallel ? "RefineRegularParallel()" : "RefineRegular()")
+              << std::endl;
+    lf::refinement::MeshHierarchy multi_mesh(
+        mesh, std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2));
+    for (unsigned int level = 1; level <= levels; ++level) {
+      std::cout << multi_mesh.getMesh(level - 1)->NumEntities(0) << " cells:";
+      boost::timer::auto_cpu_timer t;
+      if (parallel) {
+        multi_mesh.RefineRegularParallel();
+      } else {
+        multi_mesh.RefineRegular();
+      }
+    }
+  }
+
+  for (const bool incremental : {false, true}) {
+    std::cout << "RefineMarked() towards a corner"
+              << (incremental ? ", incremental" : "") << std::endl;
+    lf::refinement::MeshHierarchy multi_mesh(
+        mesh, std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2));
+    multi_mesh.SetIncrementalRefinement(incremental);
+    for (unsigned int level = 1; level <= 4 * levels; ++level) {
+      multi_mesh.MarkEdges(
+          [](const lf::mesh::Mesh & /*mesh*/, const lf::mesh::Entity &edge) {
+            const Eigen::MatrixXd corners =
+                lf::geometry::Corners(*edge.Geometry());
+            return corners.colwise().norm().minCoeff() < 1.0E-12;
+          });
+      std::cout << multi_mesh.getMesh(level - 1)->NumEntities(0) << " cells:";
+      boost::timer::auto_cpu_timer t;
+      multi_mesh.RefineMarked();
+    }
+  }
+  return 0;
+}
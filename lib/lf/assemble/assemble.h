@@ -17,9 +17,11 @@
 
 #include "assembler.h"
 #include "assembly_types.h"
+#include "cell_dof_map.h"
 #include "coomatrix.h"
 #include "dofhandler.h"
 #include "fix_dof.h"
+#include "sparsity_pattern.h"
 
 /** @brief D.o.f. index mapping and assembly facilities
  *
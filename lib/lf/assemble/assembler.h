@@ -16,9 +16,13 @@
 #ifndef _LF_ASSEMBLE_H
 #define _LF_ASSEMBLE_H
 
+#include <lf/base/base.h>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 
 #include "dofhandler.h"
+#include "sparsity_pattern.h"
 
 namespace lf::assemble {
 
@@ -246,6 +250,209 @@ TMPMATRIX AssembleMatrixLocally(
   return AssembleMatrixLocally<TMPMATRIX, ENTITY_MATRIX_PROVIDER>(
       codim, dof_handler, dof_handler, entity_matrix_provider);
 }
+
+/**
+ * @brief Multithreaded variant of @ref AssembleMatrixLocally()
+ *
+ * @tparam TMPMATRIX a type fitting the concept of COOMatrix
+ * @tparam ENTITY_MATRIX_PROVIDER a type providing the computation of element
+ * matrices, must model the concept \ref entity_matrix_provider
+ * @param codim co-dimension of mesh entities which should be traversed
+ *              in the course of assembly
+ * @param dof_handler_trial a dof handler object for _column space_, see @ref
+ * DofHandler
+ * @param dof_handler_test a dof handler object for _row space_, see @ref
+ * DofHandler
+ * @param entity_matrix_provider @ref entity_matrix_provider object for passing
+ * all kinds of data
+ * @param matrix matrix object to which the assembled matrix will be added.
+ * @param num_threads number of threads among which the entities are
+ *        distributed.
+ *
+ * The range of entities of co-dimension `codim` is split into `num_threads`
+ * contiguous chunks. Every thread computes the element matrices for the
+ * entities of its chunk and stores their contributions in a thread-private
+ * triplet buffer, so that no locking is required. Afterwards the buffers are
+ * transferred to `matrix` in the order of the chunks, which means that
+ * `matrix.AddToEntry()` is called with exactly the same sequence of arguments
+ * as in the sequential function @ref AssembleMatrixLocally(). In particular,
+ * for `TMPMATRIX = COOMatrix` the result of `makeSparse()` agrees bit by bit
+ * with that of sequential assembly.
+ *
+ * #### Additional requirements for ENTITY_MATRIX_PROVIDER
+ *
+ * The methods `isActive()` and `Eval()` of `entity_matrix_provider` are called
+ * concurrently for different entities. Hence they must not modify shared
+ * state, e.g. the element matrix must not be stored in a member variable of
+ * the provider object. The type returned by `Eval()` must provide a `Scalar`
+ * typedef, as all Eigen matrix types do.
+ *
+ * @note The debugging output controlled by @ref ass_mat_dbg_ctrl is not
+ * available for this function.
+ */
+template <typename TMPMATRIX, class ENTITY_MATRIX_PROVIDER>
+void AssembleMatrixLocallyParallel(
+    dim_t codim, const DofHandler &dof_handler_trial,
+    const DofHandler &dof_handler_test,
+    ENTITY_MATRIX_PROVIDER &entity_matrix_provider, TMPMATRIX &matrix,
+    unsigned int num_threads = lf::base::DefaultNumThreads()) {
+  // Scalar type of the element matrices
+  using elem_mat_t = std::decay_t<decltype(
+      entity_matrix_provider.Eval(std::declval<const lf::mesh::Entity &>()))>;
+  using Scalar = typename elem_mat_t::Scalar;
+  using Triplet = Eigen::Triplet<Scalar>;
+
+  // Fetch pointer to underlying mesh
+  auto mesh = dof_handler_trial.Mesh();
+  LF_ASSERT_MSG(mesh == dof_handler_test.Mesh(),
+                "Trial and test space must be defined on the same mesh");
+  const auto entities = mesh->Entities(codim);
+  num_threads = std::max(1U, num_threads);
+
+  // One triplet buffer per chunk of entities
+  std::vector<std::vector<Triplet>> buffers(num_threads);
+  lf::base::ParallelForChunks(
+      entities.size(), num_threads,
+      [&](unsigned int chunk, std::size_t begin, std::size_t end) {
+        std::vector<Triplet> &buffer{buffers[chunk]};
+        for (std::size_t k = begin; k < end; ++k) {
+          const lf::mesh::Entity &entity{*entities[k]};
+          // Some entities may be skipped
+          if (!entity_matrix_provider.isActive(entity)) {
+            continue;
+          }
+          const size_type nrows_loc = dof_handler_test.NumLocalDofs(entity);
+          const size_type ncols_loc = dof_handler_trial.NumLocalDofs(entity);
+          nonstd::span<const gdof_idx_t> row_idx(
+              dof_handler_test.GlobalDofIndices(entity));
+          nonstd::span<const gdof_idx_t> col_idx(
+              dof_handler_trial.GlobalDofIndices(entity));
+          const auto elem_mat{entity_matrix_provider.Eval(entity)};
+          LF_ASSERT_MSG(elem_mat.rows() >= nrows_loc,
+                        "nrows mismatch " << elem_mat.rows() << " <-> "
+                                          << nrows_loc << ", entity "
+                                          << mesh->Index(entity));
+          LF_ASSERT_MSG(elem_mat.cols() >= ncols_loc,
+                        "ncols mismatch " << elem_mat.cols() << " <-> "
+                                          << ncols_loc << ", entity "
+                                          << mesh->Index(entity));
+          for (int i = 0; i < nrows_loc; i++) {
+            for (int j = 0; j < ncols_loc; j++) {
+              buffer.emplace_back(row_idx[i], col_idx[j], elem_mat(i, j));
+            }
+          }
+        }
+      });
+  // Transfer the contributions in the order of a sequential traversal
+  for (const std::vector<Triplet> &buffer : buffers) {
+    for (const Triplet &trp : buffer) {
+      matrix.AddToEntry(trp.row(), trp.col(), trp.value());
+    }
+  }
+}  // end AssembleMatrixLocallyParallel
+
+/**
+ * @brief Multithreaded entity-wise local assembly of a matrix from local
+ * matrices
+ *
+ * @return assembled matrix in a format determined by the template argument
+ *         TPMATRIX
+ * @sa AssembleMatrixLocallyParallel(dim_t codim, const DofHandler
+ * &dof_handler_trial, const DofHandler &dof_handler_test,
+ * ENTITY_MATRIX_PROVIDER &entity_matrix_provider, TMPMATRIX &matrix, unsigned
+ * int num_threads)
+ */
+template <typename TMPMATRIX, class ENTITY_MATRIX_PROVIDER>
+TMPMATRIX AssembleMatrixLocallyParallel(
+    dim_t codim, const DofHandler &dof_handler_trial,
+    const DofHandler &dof_handler_test,
+    ENTITY_MATRIX_PROVIDER &entity_matrix_provider,
+    unsigned int num_threads = lf::base::DefaultNumThreads()) {
+  TMPMATRIX matrix{dof_handler_test.NumDofs(), dof_handler_trial.NumDofs()};
+  matrix.setZero();
+  AssembleMatrixLocallyParallel<TMPMATRIX, ENTITY_MATRIX_PROVIDER>(
+      codim, dof_handler_trial, dof_handler_test, entity_matrix_provider,
+      matrix, num_threads);
+  return matrix;
+}
+
+/**
+ * @brief Multithreaded entity-wise local assembly of a matrix from local
+ * matrices when test and trial space are the same.
+ *
+ * @sa AssembleMatrixLocallyParallel(dim_t codim, const DofHandler
+ * &dof_handler_trial, const DofHandler &dof_handler_test,
+ * ENTITY_MATRIX_PROVIDER &entity_matrix_provider, TMPMATRIX &matrix, unsigned
+ * int num_threads)
+ */
+template <typename TMPMATRIX, class ENTITY_MATRIX_PROVIDER>
+TMPMATRIX AssembleMatrixLocallyParallel(
+    dim_t codim, const DofHandler &dof_handler,
+    ENTITY_MATRIX_PROVIDER &entity_matrix_provider,
+    unsigned int num_threads = lf::base::DefaultNumThreads()) {
+  return AssembleMatrixLocallyParallel<TMPMATRIX, ENTITY_MATRIX_PROVIDER>(
+      codim, dof_handler, dof_handler, entity_matrix_provider, num_threads);
+}
+
+/**
+ * @brief Assembly of a finite element matrix directly into the non-zero
+ * values of a compressed sparse matrix with precomputed sparsity pattern
+ *
+ * @tparam SCALAR scalar type of the sparse matrix
+ * @tparam ENTITY_MATRIX_PROVIDER a type providing the computation of element
+ * matrices, must model the concept \ref entity_matrix_provider
+ * @param codim co-dimension of mesh entities which should be traversed
+ *              in the course of assembly
+ * @param pattern sparsity pattern and scatter map, must have been built for
+ *        co-dimension `codim`, see @ref SparsityPattern
+ * @param entity_matrix_provider @ref entity_matrix_provider object for passing
+ * all kinds of data
+ * @param matrix a compressed sparse matrix created by
+ * `pattern.MakeSparseMatrix()`
+ *
+ * Element matrix entries are added to the slots of `matrix.valuePtr()`
+ * recorded in `pattern`. Thus no triplets are generated and neither memory
+ * allocation nor sorting is involved: this is the function of choice when the
+ * same matrix has to be assembled repeatedly, e.g., in every timestep.
+ *
+ * @note As for the other versions of @ref AssembleMatrixLocally() the values
+ * of `matrix` are not set to zero. Call `matrix.coeffs().setZero()` before
+ * re-assembling a matrix from scratch.
+ */
+template <typename SCALAR, class ENTITY_MATRIX_PROVIDER>
+void AssembleMatrixLocally(dim_t codim, const SparsityPattern &pattern,
+                           ENTITY_MATRIX_PROVIDER &entity_matrix_provider,
+                           Eigen::SparseMatrix<SCALAR> &matrix) {
+  LF_ASSERT_MSG(pattern.IsCompatible(matrix),
+                "Matrix was not created from this sparsity pattern");
+  LF_ASSERT_MSG(pattern.HasCodim(codim),
+                "Sparsity pattern lacks scatter map for codim " << codim);
+  auto mesh = pattern.Mesh();
+  SCALAR *values = matrix.valuePtr();
+  for (const lf::mesh::Entity *entity : mesh->Entities(codim)) {
+    if (entity_matrix_provider.isActive(*entity)) {
+      // Positions of element matrix entries in the array of values
+      const nonstd::span<const SparsityPattern::StorageIndex> slots(
+          pattern.Slots(*entity));
+      const size_type ncols_loc = pattern.NumLocalCols(*entity);
+      const size_type nrows_loc =
+          (ncols_loc > 0) ? slots.size() / ncols_loc : 0;
+      const auto elem_mat{entity_matrix_provider.Eval(*entity)};
+      LF_ASSERT_MSG(elem_mat.rows() >= nrows_loc,
+                    "nrows mismatch " << elem_mat.rows() << " <-> " << nrows_loc
+                                      << ", entity " << mesh->Index(*entity));
+      LF_ASSERT_MSG(elem_mat.cols() >= ncols_loc,
+                    "ncols mismatch " << elem_mat.cols() << " <-> " << ncols_loc
+                                      << ", entity " << mesh->Index(*entity));
+      auto slot_it = slots.begin();
+      for (int i = 0; i < nrows_loc; i++) {
+        for (int j = 0; j < ncols_loc; j++) {
+          values[*slot_it++] += elem_mat(i, j);
+        }
+      }
+    }  // end if(isActive() )
+  }    // end main assembly loop
+}
 /** @} */  // end of group assemble_matrix_locally
 
 /**
@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @brief Implementation of CellDofMap and of the reverse Cuthill-McKee
+ *        numbering of global shape functions
+ * @copyright MIT License
+ */
+
+#include "cell_dof_map.h"
+
+#include <algorithm>
+
+namespace lf::assemble {
+
+CellDofMap::CellDofMap(const DofHandler &dof_handler)
+    : mesh_(dof_handler.Mesh()), num_dofs_(dof_handler.NumDofs()) {
+  const size_type num_cells = mesh_->NumEntities(0);
+  offsets_.resize(num_cells + 1);
+  offsets_[0] = 0;
+  for (glb_idx_t cell_idx = 0; cell_idx < num_cells; ++cell_idx) {
+    const lf::mesh::Entity *cell = mesh_->EntityByIndex(0, cell_idx);
+    offsets_[cell_idx + 1] =
+        offsets_[cell_idx] + dof_handler.NumLocalDofs(*cell);
+  }
+  dofs_.resize(offsets_[num_cells]);
+  for (glb_idx_t cell_idx = 0; cell_idx < num_cells; ++cell_idx) {
+    const lf::mesh::Entity *cell = mesh_->EntityByIndex(0, cell_idx);
+    const nonstd::span<const gdof_idx_t> cell_dofs =
+        dof_handler.GlobalDofIndices(*cell);
+    std::copy(cell_dofs.begin(), cell_dofs.end(),
+              dofs_.begin() + offsets_[cell_idx]);
+  }
+}
+
+std::vector<gdof_idx_t> ReverseCuthillMcKeeDofOrdering(
+    const CellDofMap &cell_dofs) {
+  const size_type num_dofs = cell_dofs.NumDofs();
+  const size_type num_cells = cell_dofs.NumCells();
+
+  // Upper bound for the number of neighbors of every dof: all other dofs of
+  // all cells it belongs to
+  std::vector<size_type> offsets(num_dofs + 1, 0);
+  for (glb_idx_t cell_idx = 0; cell_idx < num_cells; ++cell_idx) {
+    const size_type num_loc_dofs = cell_dofs.NumLocalDofs(cell_idx);
+    for (const gdof_idx_t dof : cell_dofs.GlobalDofIndices(cell_idx)) {
+      offsets[dof + 1] += num_loc_dofs - 1;
+    }
+  }
+  for (size_type i = 0; i < num_dofs; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  // Fill in neighbors (with duplicates)
+  std::vector<size_type> neighbors(offsets[num_dofs]);
+  std::vector<size_type> fill(offsets.begin(), offsets.end() - 1);
+  for (glb_idx_t cell_idx = 0; cell_idx < num_cells; ++cell_idx) {
+    const nonstd::span<const gdof_idx_t> dofs =
+        cell_dofs.GlobalDofIndices(cell_idx);
+    for (const gdof_idx_t i : dofs) {
+      for (const gdof_idx_t j : dofs) {
+        if (i != j) {
+          neighbors[fill[i]++] = static_cast<size_type>(j);
+        }
+      }
+    }
+  }
+
+  // Remove duplicates and compact the neighbor lists
+  size_type pos = 0;
+  size_type begin = 0;
+  for (size_type i = 0; i < num_dofs; ++i) {
+    const auto first = neighbors.begin() + begin;
+    const auto last = neighbors.begin() + fill[i];
+    std::sort(first, last);
+    const auto unique_end = std::unique(first, last);
+    begin = offsets[i + 1];
+    offsets[i + 1] = pos + (unique_end - first);
+    // The list either stays in place or moves to the left. std::copy()
+    // requires the destination to start outside the source range.
+    const auto dest = neighbors.begin() + pos;
+    if (dest != first) {
+      std::copy(first, unique_end, dest);
+    }
+    pos = offsets[i + 1];
+  }
+  neighbors.resize(pos);
+
+  const std::vector<size_type> new_index =
+      lf::base::ReverseCuthillMcKee(offsets, neighbors);
+  return {new_index.begin(), new_index.end()};
+}
+
+}  // namespace lf::assemble
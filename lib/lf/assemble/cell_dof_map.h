@@ -0,0 +1,129 @@
+#ifndef _LF_CELL_DOF_MAP_H
+#define _LF_CELL_DOF_MAP_H
+/***************************************************************************
+ * LehrFEM++ - A simple C++ finite element libray for teaching
+ * Developed from 2018 at the Seminar of Applied Mathematics of ETH Zurich,
+ * lead developers Dr. R. Casagrande and Prof. R. Hiptmair
+ ***************************************************************************/
+
+/**
+ * @file
+ * @brief Compact cell-to-dof index map and bandwidth reducing numbering of
+ *        global shape functions
+ * @copyright MIT License
+ */
+
+#include <memory>
+#include <vector>
+
+#include "dofhandler.h"
+
+namespace lf::assemble {
+
+/**
+ * @brief Global dof indices of all cells of a mesh in one contiguous array
+ *
+ * The object is a snapshot of DofHandler::GlobalDofIndices() for all cells
+ * (entities of co-dimension 0), stored in compressed sparse row (CSR) format:
+ * the global indices of the shape functions covering the cell with index `k`
+ * are `Dofs()[Offsets()[k]] ... Dofs()[Offsets()[k+1]-1]`.
+ *
+ * Looking up the indices of a cell by its index involves neither a virtual
+ * function call nor a distinction of the cell type. Loops over the cells in
+ * the order of their indices traverse the dof indices sequentially in memory.
+ *
+ * @note The map is not updated when the @ref DofHandler it was built from is
+ * modified, e.g., by `Renumber()`.
+ */
+class CellDofMap {
+ public:
+  /**
+   * @brief Collect the global dof indices of all cells
+   * @param dof_handler @ref DofHandler providing the local-to-global map
+   */
+  explicit CellDofMap(const DofHandler &dof_handler);
+
+  CellDofMap(const CellDofMap &) = default;
+  CellDofMap(CellDofMap &&) noexcept = default;
+  CellDofMap &operator=(const CellDofMap &) = default;
+  CellDofMap &operator=(CellDofMap &&) noexcept = default;
+  ~CellDofMap() = default;
+
+  /** @brief number of cells of the underlying mesh */
+  [[nodiscard]] size_type NumCells() const { return offsets_.size() - 1; }
+
+  /** @brief total number of global shape functions */
+  [[nodiscard]] size_type NumDofs() const { return num_dofs_; }
+
+  /** @brief The mesh on which the finite element space lives */
+  [[nodiscard]] std::shared_ptr<const lf::mesh::Mesh> Mesh() const {
+    return mesh_;
+  }
+
+  /**
+   * @brief global indices of the shape functions covering a cell
+   * @param cell_index index of the cell in the mesh
+   *
+   * Returns the same range as DofHandler::GlobalDofIndices() for that cell.
+   */
+  [[nodiscard]] nonstd::span<const gdof_idx_t> GlobalDofIndices(
+      glb_idx_t cell_index) const {
+    LF_ASSERT_MSG(cell_index < NumCells(),
+                  "Cell index " << cell_index << " out of range");
+    return {dofs_.data() + offsets_[cell_index],
+            dofs_.data() + offsets_[cell_index + 1]};
+  }
+
+  /** @brief global indices of the shape functions covering a cell */
+  [[nodiscard]] nonstd::span<const gdof_idx_t> GlobalDofIndices(
+      const lf::mesh::Entity &cell) const {
+    LF_ASSERT_MSG(cell.Codim() == 0, "Entity is not a cell");
+    return GlobalDofIndices(mesh_->Index(cell));
+  }
+
+  /** @brief number of shape functions covering a cell */
+  [[nodiscard]] size_type NumLocalDofs(glb_idx_t cell_index) const {
+    return offsets_[cell_index + 1] - offsets_[cell_index];
+  }
+
+  /** @brief offsets of the index ranges of the cells, length NumCells()+1 */
+  [[nodiscard]] nonstd::span<const size_type> Offsets() const {
+    return offsets_;
+  }
+
+  /** @brief concatenated global dof indices of all cells */
+  [[nodiscard]] nonstd::span<const gdof_idx_t> Dofs() const { return dofs_; }
+
+ private:
+  std::shared_ptr<const lf::mesh::Mesh> mesh_;
+  size_type num_dofs_;
+  std::vector<size_type> offsets_;
+  std::vector<gdof_idx_t> dofs_;
+};
+
+/**
+ * @brief Reverse Cuthill-McKee numbering of the global shape functions
+ *
+ * @param cell_dofs cell-to-dof map of a finite element space
+ * @return vector `new_index` of length `cell_dofs.NumDofs()`, which can be
+ *         passed to `UniformFEDofHandler::Renumber()` or
+ *         `DynamicFEDofHandler::Renumber()`.
+ *
+ * Two global shape functions are regarded as coupled if they both cover a
+ * common cell, which is the sparsity graph of a Galerkin matrix assembled from
+ * cell contributions. The new numbering is computed with
+ * lf::base::ReverseCuthillMcKee() and reduces the bandwidth of this matrix.
+ *
+ * #### Example usage
+ * ~~~
+ * lf::assemble::UniformFEDofHandler dofh(mesh_p, {...});
+ * dofh.Renumber(lf::assemble::ReverseCuthillMcKeeDofOrdering(
+ *     lf::assemble::CellDofMap(dofh)));
+ * ~~~
+ */
+std::vector<gdof_idx_t> ReverseCuthillMcKeeDofOrdering(
+    const CellDofMap &cell_dofs);
+
+}  // namespace lf::assemble
+
+#endif
@@ -16,6 +16,35 @@
 
 namespace lf::assemble {
 
+namespace /* anonymous */ {
+
+// Replace the global dof indices stored in the index arrays of a dof handler
+// and permute the array of entities associated with the dofs accordingly
+void RenumberDofs(nonstd::span<const gdof_idx_t> new_index,
+                  std::array<std::vector<gdof_idx_t>, 3> &dofs,
+                  std::vector<const lf::mesh::Entity *> &dof_entities) {
+  const auto num_dofs = static_cast<gdof_idx_t>(dof_entities.size());
+  LF_VERIFY_MSG(static_cast<gdof_idx_t>(new_index.size()) == num_dofs,
+                "new_index has length " << new_index.size() << " instead of "
+                                        << num_dofs);
+  std::vector<const lf::mesh::Entity *> new_dof_entities(num_dofs, nullptr);
+  for (gdof_idx_t dof = 0; dof < num_dofs; ++dof) {
+    const gdof_idx_t new_dof = new_index[dof];
+    LF_VERIFY_MSG((new_dof >= 0) && (new_dof < num_dofs) &&
+                      (new_dof_entities[new_dof] == nullptr),
+                  "new_index is not a permutation");
+    new_dof_entities[new_dof] = dof_entities[dof];
+  }
+  dof_entities = std::move(new_dof_entities);
+  for (std::vector<gdof_idx_t> &codim_dofs : dofs) {
+    for (gdof_idx_t &dof : codim_dofs) {
+      dof = new_index[dof];
+    }
+  }
+}
+
+}  // namespace
+
 // Default output flag
 unsigned int DofHandler::output_ctrl_ = 0;
 
@@ -324,6 +353,10 @@ size_type UniformFEDofHandler::NumInteriorDofs(
   return NumInteriorDofs(entity.RefEl());
 }
 
+void UniformFEDofHandler::Renumber(nonstd::span<const gdof_idx_t> new_index) {
+  RenumberDofs(new_index, dofs_, dof_entities_);
+}
+
 // ----------------------------------------------------------------------
 // Implementation DynamicFEDofHandler
 // ----------------------------------------------------------------------
@@ -388,4 +421,8 @@ size_type DynamicFEDofHandler::NumInteriorDofs(
   return no_loc_dofs;
 }
 
+void DynamicFEDofHandler::Renumber(nonstd::span<const gdof_idx_t> new_index) {
+  RenumberDofs(new_index, dofs_, dof_entities_);
+}
+
 }  // namespace lf::assemble
@@ -312,6 +312,23 @@ class UniformFEDofHandler : public DofHandler {
     return mesh_;
   }
 
+  /**
+   * @brief Renumber the global shape functions
+   *
+   * @param new_index vector of length NumDofs(), a permutation of `0 ...
+   *        NumDofs()-1`: the global shape function with index `i` receives the
+   *        new index `new_index[i]`.
+   *
+   * The layout of the index arrays is not changed, only the indices stored in
+   * them. A typical application is a bandwidth reducing ordering, see
+   * ReverseCuthillMcKeeDofOrdering().
+   *
+   * @note After renumbering the global shape functions are no longer ordered
+   * according to the conventions stated in the documentation of @ref
+   * DofHandler.
+   */
+  void Renumber(nonstd::span<const gdof_idx_t> new_index);
+
  private:
   /**
    * @brief initialization of internal index arrays
@@ -658,6 +675,23 @@ class DynamicFEDofHandler : public DofHandler {
     return mesh_p_;
   }
 
+  /**
+   * @brief Renumber the global shape functions
+   *
+   * @param new_index vector of length NumDofs(), a permutation of `0 ...
+   *        NumDofs()-1`: the global shape function with index `i` receives the
+   *        new index `new_index[i]`.
+   *
+   * The layout of the index arrays is not changed, only the indices stored in
+   * them. A typical application is a bandwidth reducing ordering, see
+   * ReverseCuthillMcKeeDofOrdering().
+   *
+   * @note After renumbering the global shape functions are no longer ordered
+   * according to the conventions stated in the documentation of @ref
+   * DofHandler.
+   */
+  void Renumber(nonstd::span<const gdof_idx_t> new_index);
+
  private:
   /** The mesh on which the degrees of freedom are defined */
   std::shared_ptr<const lf::mesh::Mesh> mesh_p_;
@@ -15,10 +15,43 @@
  */
 
 #include <Eigen/Sparse>
+#include <utility>
+#include <vector>
 #include "coomatrix.h"
 
 namespace lf::assemble {
 
+/**
+ * @brief Evaluate a selector for fixed solution components once for every
+ *        component
+ *
+ * @tparam SCALAR underlying scalar type, e.g. double
+ * @tparam SELECTOR see FixFlaggedSolutionComponents()
+ * @param selectvals the selector
+ * @param N number of components
+ * @return a pair of a vector of flags, `true` for the fixed components, and a
+ *         vector of their prescribed values, which is zero for all other
+ *         components
+ *
+ * Selectors may be expensive to call, e.g. if they look up mesh data sets.
+ * This function calls `selectvals` exactly once for every index.
+ */
+template <typename SCALAR, typename SELECTOR>
+std::pair<std::vector<bool>, Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>
+EvaluateSelector(SELECTOR &&selectvals, lf::assemble::size_type N) {
+  std::pair<std::vector<bool>, Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>
+      result{std::vector<bool>(N, false),
+             Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>::Zero(N)};
+  for (lf::assemble::gdof_idx_t k = 0; k < N; ++k) {
+    const auto selval{selectvals(k)};
+    if (selval.first) {
+      result.first[k] = true;
+      result.second[k] = selval.second;
+    }
+  }
+  return result;
+}
+
 /**
  * @brief enforce prescribed solution components
  * @sa FixSolutionComponentsLse()
@@ -83,61 +116,175 @@ namespace lf::assemble {
  * Document](https://www.sam.math.ethz.ch/~grsam/NUMPDEFL/NUMPDE.pdf)
  * @lref{par:lfffsc}.
  *
+ * The selector is called exactly once for every component, see
+ * EvaluateSelector(). The total cost is linear in the number of components and
+ * the number of triplets of `A`.
+ *
  */
 template <typename SCALAR, typename SELECTOR, typename RHSVECTOR>
 void FixFlaggedSolutionComponents(SELECTOR &&selectvals, COOMatrix<SCALAR> &A,
                                   RHSVECTOR &b) {
+  LF_ASSERT_MSG(A.rows() == A.cols(), "Matrix must be square!");
+  // Query the selector only once for every component
+  const auto [fixed_flags, fixed_values] =
+      EvaluateSelector<SCALAR>(selectvals, A.cols());
+  FixFlaggedSolutionComponents(fixed_flags, fixed_values, A, b);
+}
+
+/**
+ * @brief enforce prescribed solution components flagged in a bitmap
+ * @sa FixFlaggedSolutionComponents(SELECTOR &&, COOMatrix<SCALAR> &,
+ *     RHSVECTOR &)
+ *
+ * @param fixed_flags `fixed_flags[k]` is `true`, if component `k` is fixed
+ * @param fixed_values the prescribed values of the fixed components, all
+ *        other entries are ignored
+ * @param A reference to the _square_ coefficient matrix in COO format
+ * @param b reference to the right-hand-side vector
+ *
+ * Same as the selector-based version, which evaluates the selector with
+ * EvaluateSelector() and then calls this function. The elimination of the
+ * rows and columns belonging to fixed components and the update of the
+ * right-hand side are done in a single pass through the triplets of `A`.
+ */
+template <typename SCALAR, typename RHSVECTOR>
+void FixFlaggedSolutionComponents(
+    const std::vector<bool> &fixed_flags,
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> &fixed_values,
+    COOMatrix<SCALAR> &A, RHSVECTOR &b) {
   const lf::assemble::size_type N(A.cols());
   LF_ASSERT_MSG(A.rows() == N, "Matrix must be square!");
   LF_ASSERT_MSG(N == b.size(),
                 "Mismatch N = " << N << " <-> b.size() = " << b.size());
-  {
-    // Multiply sparse matrix with the vector of fixed components and subtract
-    // result from right hand side
-    // To skip irrelevant components of fixed_vec rely on a temporary vector
-    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> tmp_vec(N);
-    for (lf::assemble::gdof_idx_t k = 0; k < N; ++k) {
-      const auto selval{selectvals(k)};
-      if (selval.first) {
-        tmp_vec[k] = selval.second;
-      } else {
-        tmp_vec[k] = SCALAR();
+  LF_ASSERT_MSG(N == fixed_flags.size() && N == fixed_values.size(),
+                "Mismatch N = " << N << " <-> " << fixed_flags.size() << ", "
+                                << fixed_values.size());
+  // Subtract the contributions of the fixed components from the right-hand
+  // side and drop all triplets in their rows and columns, keeping the order
+  // of the remaining ones
+  typename COOMatrix<SCALAR>::TripletVec &triplets{A.triplets()};
+  std::size_t num_kept = 0;
+  for (std::size_t t = 0; t < triplets.size(); ++t) {
+    const auto &trp{triplets[t]};
+    const bool fixed_row = fixed_flags[trp.row()];
+    const bool fixed_col = fixed_flags[trp.col()];
+    if (fixed_col && !fixed_row) {
+      b[trp.row()] -= trp.value() * fixed_values[trp.col()];
+    }
+    if (!fixed_row && !fixed_col) {
+      triplets[num_kept++] = trp;
+    }
+  }
+  triplets.erase(triplets.begin() + num_kept, triplets.end());
+  // Prescribed values in the right-hand side and unit diagonal entries
+  for (lf::assemble::gdof_idx_t k = 0; k < N; ++k) {
+    if (fixed_flags[k]) {
+      b[k] = fixed_values[k];
+      A.AddToEntry(k, k, 1.0);
+    }
+  }
+}
+
+/**
+ * @brief enforce prescribed solution components in a compressed sparse matrix
+ * @sa FixFlaggedSolutionComponents(SELECTOR &&, COOMatrix<SCALAR> &,
+ *     RHSVECTOR &)
+ *
+ * @param fixed_flags `fixed_flags[k]` is `true`, if component `k` is fixed
+ * @param fixed_values the prescribed values of the fixed components, all
+ *        other entries are ignored
+ * @param A reference to the _square_ coefficient matrix
+ * @param b reference to the right-hand-side vector
+ *
+ * The linear system is modified as by the version for matrices in COO format,
+ * in a single pass through the stored entries of `A`. This allows to impose
+ * the constraints on a matrix that is combined from assembled matrices, e.g.
+ * in every step of a timestepping scheme, without assembling it again.
+ *
+ * @note The sparsity pattern of `A` is not changed: the entries in the rows and
+ * columns of the fixed components are overwritten with explicit zeros, so that
+ * the symbolic analysis of a sparse solver can be reused. Call `A.prune()` to
+ * remove them. Only if a diagonal entry of a fixed component is not stored, it
+ * is inserted. Room for all missing diagonal entries is reserved at once, see
+ * `Eigen::SparseMatrix::reserve()`.
+ */
+template <typename SCALAR, int OPTIONS, typename STORAGE_INDEX,
+          typename RHSVECTOR>
+void FixFlaggedSolutionComponents(
+    const std::vector<bool> &fixed_flags,
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> &fixed_values,
+    Eigen::SparseMatrix<SCALAR, OPTIONS, STORAGE_INDEX> &A, RHSVECTOR &b) {
+  const lf::assemble::size_type N(A.cols());
+  LF_ASSERT_MSG(A.rows() == N, "Matrix must be square!");
+  LF_ASSERT_MSG(N == b.size(),
+                "Mismatch N = " << N << " <-> b.size() = " << b.size());
+  LF_ASSERT_MSG(N == fixed_flags.size() && N == fixed_values.size(),
+                "Mismatch N = " << N << " <-> " << fixed_flags.size() << ", "
+                                << fixed_values.size());
+  std::vector<bool> has_diagonal(N, false);
+  for (Eigen::Index outer = 0; outer < A.outerSize(); ++outer) {
+    for (typename Eigen::SparseMatrix<SCALAR, OPTIONS,
+                                      STORAGE_INDEX>::InnerIterator it(A,
+                                                                       outer);
+         it; ++it) {
+      const bool fixed_row = fixed_flags[it.row()];
+      const bool fixed_col = fixed_flags[it.col()];
+      if (fixed_col && !fixed_row) {
+        b[it.row()] -= it.value() * fixed_values[it.col()];
+      }
+      if (fixed_row || fixed_col) {
+        if (it.row() == it.col()) {
+          it.valueRef() = SCALAR(1.0);
+          has_diagonal[it.row()] = true;
+        } else {
+          it.valueRef() = SCALAR(0.0);
+        }
       }
     }
-    A.MatVecMult(-1.0, tmp_vec, b);
   }
-  // Set vector components of right-hand-side vector for prescribed values
+  // Room for the missing diagonal entries is reserved in a single pass, so that
+  // inserting one of them only shifts the entries of its own column (row)
+  Eigen::Matrix<STORAGE_INDEX, Eigen::Dynamic, 1> num_missing =
+      Eigen::Matrix<STORAGE_INDEX, Eigen::Dynamic, 1>::Zero(N);
   for (lf::assemble::gdof_idx_t k = 0; k < N; ++k) {
-    const auto selval{selectvals(k)};
-    if (selval.first) {
-      b[k] = selval.second;
+    if (fixed_flags[k]) {
+      b[k] = fixed_values[k];
+      num_missing[k] = has_diagonal[k] ? 0 : 1;
     }
   }
-  // Set rows and columns of the sparse matrix corresponding to the fixed
-  // solution components to zero
-  A.setZero([&selectvals](gdof_idx_t i, gdof_idx_t j) {
-    return (selectvals(i).first || selectvals(j).first);
-  });
-  // Old implementation, demonstrating what is going on
-  // lf::assemble::COOMatrix<double>::TripletVec::iterator new_last =
-  //     std::remove_if(
-  //         A.triplets().begin(), A.triplets().end(),
-  //         [&fixed_comp_flags](
-  //             typename lf::assemble::COOMatrix<double>::Triplet &triplet) {
-  //           return (fixed_comp_flags[triplet.row()] ||
-  //                   fixed_comp_flags[triplet.col()]);
-  //         });
-  // // Adjust size of triplet vector
-  // A.triplets().erase(new_last, A.triplets().end());
-  // Add Unit diagonal entries corrresponding to fixed components
-  for (lf::assemble::gdof_idx_t dofnum = 0; dofnum < N; ++dofnum) {
-    const auto selval{selectvals(dofnum)};
-    if (selval.first) {
-      A.AddToEntry(dofnum, dofnum, 1.0);
+  if (num_missing.sum() > 0) {
+    const bool compressed = A.isCompressed();
+    A.reserve(num_missing);
+    for (lf::assemble::gdof_idx_t k = 0; k < N; ++k) {
+      if (num_missing[k] > 0) {
+        A.insert(k, k) = SCALAR(1.0);
+      }
+    }
+    if (compressed) {
+      A.makeCompressed();
     }
   }
 }
 
+/**
+ * @brief enforce prescribed solution components in a compressed sparse matrix
+ * @sa FixFlaggedSolutionComponents(SELECTOR &&, COOMatrix<SCALAR> &,
+ *     RHSVECTOR &)
+ *
+ * Evaluates the selector with EvaluateSelector() and calls the bitmap-based
+ * version for sparse matrices.
+ */
+template <typename SCALAR, int OPTIONS, typename STORAGE_INDEX,
+          typename SELECTOR, typename RHSVECTOR>
+void FixFlaggedSolutionComponents(
+    SELECTOR &&selectvals,
+    Eigen::SparseMatrix<SCALAR, OPTIONS, STORAGE_INDEX> &A, RHSVECTOR &b) {
+  LF_ASSERT_MSG(A.rows() == A.cols(), "Matrix must be square!");
+  const auto [fixed_flags, fixed_values] =
+      EvaluateSelector<SCALAR>(selectvals, A.cols());
+  FixFlaggedSolutionComponents(fixed_flags, fixed_values, A, b);
+}
+
 /**
  * @brief Setting unknowns of a sparse linear system of equations
  *        to fixed values
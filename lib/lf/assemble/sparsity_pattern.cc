@@ -0,0 +1,120 @@
+/***************************************************************************
+ * LehrFEM++ - A simple C++ finite element libray for teaching
+ * Developed from 2018 at the Seminar of Applied Mathematics of ETH Zurich,
+ * lead developers Dr. R. Casagrande and Prof. R. Hiptmair
+ ***************************************************************************/
+
+/**
+ * @file
+ * @brief Construction of sparsity patterns and scatter maps
+ * @copyright MIT License
+ */
+
+#include "sparsity_pattern.h"
+
+namespace lf::assemble {
+
+SparsityPattern::SparsityPattern(const DofHandler &dof_handler_trial,
+                                 const DofHandler &dof_handler_test,
+                                 const std::vector<dim_t> &codims)
+    : mesh_(dof_handler_trial.Mesh()),
+      rows_(dof_handler_test.NumDofs()),
+      cols_(dof_handler_trial.NumDofs()) {
+  LF_ASSERT_MSG(mesh_ == dof_handler_test.Mesh(),
+                "Trial and test space must be defined on the same mesh");
+
+  // Step I: collect the row indices of the non-zero entries of every column
+  std::vector<std::vector<StorageIndex>> col_rows(cols_);
+  for (const dim_t codim : codims) {
+    LF_ASSERT_MSG(codim <= mesh_->DimMesh(), "Illegal codim " << codim);
+    for (const lf::mesh::Entity *entity : mesh_->Entities(codim)) {
+      nonstd::span<const gdof_idx_t> row_idx(
+          dof_handler_test.GlobalDofIndices(*entity));
+      nonstd::span<const gdof_idx_t> col_idx(
+          dof_handler_trial.GlobalDofIndices(*entity));
+      for (const gdof_idx_t j : col_idx) {
+        col_rows[j].insert(col_rows[j].end(), row_idx.begin(), row_idx.end());
+      }
+    }
+  }
+
+  // Step II: compressed column storage of the pattern
+  outer_index_.resize(cols_ + 1);
+  outer_index_[0] = 0;
+  for (size_type j = 0; j < cols_; ++j) {
+    std::vector<StorageIndex> &rows{col_rows[j]};
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    outer_index_[j + 1] =
+        outer_index_[j] + static_cast<StorageIndex>(rows.size());
+  }
+  inner_index_.reserve(outer_index_[cols_]);
+  for (std::vector<StorageIndex> &rows : col_rows) {
+    inner_index_.insert(inner_index_.end(), rows.begin(), rows.end());
+    std::vector<StorageIndex>().swap(rows);
+  }
+
+  // Step III: scatter map for every entity of the requested co-dimensions
+  for (const dim_t codim : codims) {
+    if (HasCodim(codim)) {
+      continue;
+    }
+    const size_type num_entities = mesh_->NumEntities(codim);
+    std::vector<size_type> &offsets{entity_offsets_[codim]};
+    std::vector<size_type> &local_cols{local_cols_[codim]};
+    std::vector<StorageIndex> &slots{slots_[codim]};
+    offsets.assign(num_entities + 1, 0);
+    local_cols.assign(num_entities, 0);
+    // Compute offsets first, the entities may not be traversed in the order
+    // of their indices
+    for (const lf::mesh::Entity *entity : mesh_->Entities(codim)) {
+      const glb_idx_t idx = mesh_->Index(*entity);
+      local_cols[idx] = dof_handler_trial.NumLocalDofs(*entity);
+      offsets[idx + 1] = dof_handler_test.NumLocalDofs(*entity) *
+                         dof_handler_trial.NumLocalDofs(*entity);
+    }
+    for (size_type k = 0; k < num_entities; ++k) {
+      offsets[k + 1] += offsets[k];
+    }
+    slots.resize(offsets[num_entities]);
+    for (const lf::mesh::Entity *entity : mesh_->Entities(codim)) {
+      nonstd::span<const gdof_idx_t> row_idx(
+          dof_handler_test.GlobalDofIndices(*entity));
+      nonstd::span<const gdof_idx_t> col_idx(
+          dof_handler_trial.GlobalDofIndices(*entity));
+      auto slot_it = slots.begin() + offsets[mesh_->Index(*entity)];
+      for (const gdof_idx_t i : row_idx) {
+        for (const gdof_idx_t j : col_idx) {
+          // Binary search for row index i in column j
+          const auto col_begin = inner_index_.cbegin() + outer_index_[j];
+          const auto col_end = inner_index_.cbegin() + outer_index_[j + 1];
+          const auto pos = std::lower_bound(col_begin, col_end,
+                                            static_cast<StorageIndex>(i));
+          LF_ASSERT_MSG(pos != col_end && *pos == static_cast<StorageIndex>(i),
+                        "Entry (" << i << ',' << j << ") not in pattern");
+          *slot_it++ = static_cast<StorageIndex>(pos - inner_index_.cbegin());
+        }
+      }
+    }
+  }
+}
+
+nonstd::span<const SparsityPattern::StorageIndex> SparsityPattern::Slots(
+    const lf::mesh::Entity &entity) const {
+  const dim_t codim = mesh_->DimMesh() - entity.RefEl().Dimension();
+  LF_ASSERT_MSG(HasCodim(codim),
+                "No scatter map for entities of codim " << codim);
+  const glb_idx_t idx = mesh_->Index(entity);
+  const std::vector<size_type> &offsets{entity_offsets_[codim]};
+  return {slots_[codim].data() + offsets[idx],
+          slots_[codim].data() + offsets[idx + 1]};
+}
+
+size_type SparsityPattern::NumLocalCols(const lf::mesh::Entity &entity) const {
+  const dim_t codim = mesh_->DimMesh() - entity.RefEl().Dimension();
+  LF_ASSERT_MSG(HasCodim(codim),
+                "No scatter map for entities of codim " << codim);
+  return local_cols_[codim][mesh_->Index(entity)];
+}
+
+}  // namespace lf::assemble
@@ -0,0 +1,193 @@
+#ifndef _LF_SPARSITY_PATTERN_H
+#define _LF_SPARSITY_PATTERN_H
+/***************************************************************************
+ * LehrFEM++ - A simple C++ finite element libray for teaching
+ * Developed from 2018 at the Seminar of Applied Mathematics of ETH Zurich,
+ * lead developers Dr. R. Casagrande and Prof. R. Hiptmair
+ ***************************************************************************/
+
+/**
+ * @file
+ * @brief Precomputed sparsity pattern of Galerkin matrices for repeated
+ *        assembly
+ * @copyright MIT License
+ */
+
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "dofhandler.h"
+
+namespace lf::assemble {
+
+/**
+ * @brief Sparsity pattern of a Galerkin matrix together with a scatter map
+ *        from entries of element matrices to the non-zero entries of the
+ *        global matrix.
+ *
+ * In time-dependent or nonlinear problems the same Galerkin matrix is often
+ * assembled many times with varying coefficients. Going through a COOMatrix
+ * then means that the triplet list is built, sorted and compressed (in
+ * `COOMatrix::makeSparse()`) over and over again, although the connectivity
+ * of the degrees of freedom never changes.
+ *
+ * An object of this class is built once from a pair of @ref DofHandler objects.
+ * It stores
+ * - the (column-major, compressed) sparsity pattern of the matrix, that is,
+ *   the pattern of an `Eigen::SparseMatrix<SCALAR>`, and
+ * - for every entity of the requested co-dimensions the positions in the array
+ *   of non-zero values (`Eigen::SparseMatrix::valuePtr()`) to which the entries
+ *   of its element matrix have to be added.
+ *
+ * With this information the overload @ref AssembleMatrixLocally(dim_t, const
+ * SparsityPattern &, ENTITY_MATRIX_PROVIDER &, Eigen::SparseMatrix<SCALAR> &)
+ * adds element matrices directly to the values of a compressed sparse matrix,
+ * without any dynamic memory allocation and without sorting.
+ *
+ * #### Example usage
+ * ~~~
+ * lf::assemble::SparsityPattern pattern(dofh, dofh, {0});
+ * Eigen::SparseMatrix<double> A = pattern.MakeSparseMatrix<double>();
+ * for (...) { // time steps
+ *   A.coeffs().setZero();
+ *   lf::assemble::AssembleMatrixLocally(0, pattern, elmat_builder, A);
+ *   ...
+ * }
+ * ~~~
+ */
+class SparsityPattern {
+ public:
+  /** @brief Integer type for positions in the array of non-zero values */
+  using StorageIndex = Eigen::SparseMatrix<double>::StorageIndex;
+
+  /**
+   * @brief Build the sparsity pattern of a Galerkin matrix
+   * @param dof_handler_trial @ref DofHandler for the _column space_
+   * @param dof_handler_test @ref DofHandler for the _row space_
+   * @param codims co-dimensions of the entities whose element matrices are
+   *        going to be assembled.
+   *
+   * The pattern comprises all pairs of global shape functions associated with
+   * a common entity of one of the co-dimensions in `codims`.
+   */
+  SparsityPattern(const DofHandler &dof_handler_trial,
+                  const DofHandler &dof_handler_test,
+                  const std::vector<dim_t> &codims = {0});
+
+  /**
+   * @brief Build the sparsity pattern of a square Galerkin matrix, for
+   * which test and trial space agree
+   */
+  explicit SparsityPattern(const DofHandler &dof_handler,
+                           const std::vector<dim_t> &codims = {0})
+      : SparsityPattern(dof_handler, dof_handler, codims) {}
+
+  SparsityPattern(const SparsityPattern &) = default;
+  SparsityPattern(SparsityPattern &&) noexcept = default;
+  SparsityPattern &operator=(const SparsityPattern &) = default;
+  SparsityPattern &operator=(SparsityPattern &&) noexcept = default;
+  ~SparsityPattern() = default;
+
+  /** @brief number of rows of the matrix */
+  [[nodiscard]] size_type rows() const { return rows_; }
+  /** @brief number of columns of the matrix */
+  [[nodiscard]] size_type cols() const { return cols_; }
+  /** @brief number of structurally non-zero entries */
+  [[nodiscard]] size_type nonZeros() const { return inner_index_.size(); }
+
+  /** @brief The mesh on which the underlying finite element spaces live */
+  [[nodiscard]] std::shared_ptr<const lf::mesh::Mesh> Mesh() const {
+    return mesh_;
+  }
+
+  /**
+   * @brief Tells whether the scatter map for entities of a given co-dimension
+   * has been computed.
+   */
+  [[nodiscard]] bool HasCodim(dim_t codim) const {
+    return codim < entity_offsets_.size() && !entity_offsets_[codim].empty();
+  }
+
+  /**
+   * @brief Positions of the entries of the element matrix of an entity in the
+   * array of non-zero values of the matrix
+   *
+   * @param entity a mesh entity whose co-dimension has been passed to the
+   *        constructor
+   * @return range of length `n*m`, where `n` and `m` are the numbers of local
+   *         shape functions of test and trial space. The element matrix entry
+   *         `(i,j)` has to be added to value number `i*m+j`.
+   */
+  [[nodiscard]] nonstd::span<const StorageIndex> Slots(
+      const lf::mesh::Entity &entity) const;
+
+  /**
+   * @brief Number of local shape functions of the trial space (=number of
+   * columns of the element matrix) for an entity
+   */
+  [[nodiscard]] size_type NumLocalCols(const lf::mesh::Entity &entity) const;
+
+  /**
+   * @brief Creates a compressed sparse matrix with this sparsity pattern and
+   * all values (explicitly) set to zero.
+   */
+  template <typename SCALAR>
+  [[nodiscard]] Eigen::SparseMatrix<SCALAR> MakeSparseMatrix() const;
+
+  /**
+   * @brief Checks that a sparse matrix has been created by
+   * MakeSparseMatrix() of a pattern with identical structure.
+   *
+   * Compares the dimensions and the complete compressed column storage of
+   * the pattern, that is, the outer and the inner index arrays.
+   */
+  template <typename SCALAR>
+  [[nodiscard]] bool IsCompatible(
+      const Eigen::SparseMatrix<SCALAR> &matrix) const;
+
+ private:
+  std::shared_ptr<const lf::mesh::Mesh> mesh_;
+  size_type rows_, cols_;
+  // Compressed column storage of the pattern, cf. the documentation of Eigen
+  std::vector<StorageIndex> outer_index_;
+  std::vector<StorageIndex> inner_index_;
+  // For every co-dimension: offsets of the range of slots belonging to an
+  // entity (indexed by the entity index), empty if codim was not requested
+  std::array<std::vector<size_type>, 3> entity_offsets_;
+  // For every co-dimension: number of columns of the element matrices
+  std::array<std::vector<size_type>, 3> local_cols_;
+  // For every co-dimension: the slots of all entities of that co-dimension
+  std::array<std::vector<StorageIndex>, 3> slots_;
+};
+
+template <typename SCALAR>
+Eigen::SparseMatrix<SCALAR> SparsityPattern::MakeSparseMatrix() const {
+  Eigen::SparseMatrix<SCALAR> result(rows_, cols_);
+  result.resizeNonZeros(static_cast<Eigen::Index>(inner_index_.size()));
+  std::copy(outer_index_.begin(), outer_index_.end(), result.outerIndexPtr());
+  std::copy(inner_index_.begin(), inner_index_.end(), result.innerIndexPtr());
+  std::fill(result.valuePtr(), result.valuePtr() + inner_index_.size(),
+            SCALAR(0));
+  return result;
+}
+
+template <typename SCALAR>
+bool SparsityPattern::IsCompatible(
+    const Eigen::SparseMatrix<SCALAR> &matrix) const {
+  if (!matrix.isCompressed() || (matrix.rows() != rows_) ||
+      (matrix.cols() != cols_) ||
+      (matrix.nonZeros() != static_cast<Eigen::Index>(inner_index_.size()))) {
+    return false;
+  }
+  return std::equal(outer_index_.begin(), outer_index_.end(),
+                    matrix.outerIndexPtr()) &&
+         std::equal(inner_index_.begin(), inner_index_.end(),
+                    matrix.innerIndexPtr());
+}
+
+}  // namespace lf::assemble
+
+#endif
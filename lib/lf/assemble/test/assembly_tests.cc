@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 
+#include <lf/mesh/hybrid2d/hybrid2d.h>
 #include <lf/mesh/utils/utils.h>
 #include "lf/mesh/test_utils/test_meshes.h"
 
@@ -688,4 +689,193 @@ TEST(lf_assembly, mat_vec_mult_test) {
   std::cout << " s= " << test_vec_lr_mult(*mesh_p, dof_handler) << std::endl;
 }
 
+/** Thread-safe element matrix provider with "irrational" entries, so that
+ * the result of assembly depends on the order of summation. */
+class ThreadSafeTestAssembler {
+ public:
+  explicit ThreadSafeTestAssembler(const lf::mesh::Mesh &mesh) : mesh_(mesh) {}
+  bool isActive(const lf::mesh::Entity &cell) const {
+    return (mesh_.Index(cell) % 5) != 3;
+  }
+  Eigen::Matrix3d Eval(const lf::mesh::Entity &cell) const {
+    const double cell_idx = mesh_.Index(cell);
+    Eigen::Matrix3d mat;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        mat(i, j) = std::sin(cell_idx + 1.0) / (1.0 + i + 3.0 * j);
+      }
+    }
+    return mat;
+  }
+
+ private:
+  const lf::mesh::Mesh &mesh_;
+};
+
+TEST(lf_assembly, parallel_mat_assembly_test) {
+  // Structured triangular mesh with 2*20*20 cells
+  auto mesh_factory_ptr = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  lf::mesh::hybrid2d::TPTriagMeshBuilder builder(std::move(mesh_factory_ptr));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0, 0})
+      .setTopRightCorner(Eigen::Vector2d{1, 1})
+      .setNumXCells(20)
+      .setNumYCells(20);
+  auto mesh_p = builder.Build();
+  lf::assemble::UniformFEDofHandler dof_handler(
+      mesh_p, {{lf::base::RefEl::kPoint(), 1}});
+  ThreadSafeTestAssembler assembler{*mesh_p};
+
+  const Eigen::SparseMatrix<double> seq_mat =
+      lf::assemble::AssembleMatrixLocally<lf::assemble::COOMatrix<double>>(
+          0, dof_handler, assembler)
+          .makeSparse();
+
+  for (unsigned int num_threads : {1U, 2U, 3U, 7U, 1000U}) {
+    auto par_coo = lf::assemble::AssembleMatrixLocallyParallel<
+        lf::assemble::COOMatrix<double>>(0, dof_handler, assembler,
+                                         num_threads);
+    const Eigen::SparseMatrix<double> par_mat = par_coo.makeSparse();
+    ASSERT_EQ(par_mat.nonZeros(), seq_mat.nonZeros());
+    for (int k = 0; k < seq_mat.outerSize() + 1; ++k) {
+      ASSERT_EQ(par_mat.outerIndexPtr()[k], seq_mat.outerIndexPtr()[k]);
+    }
+    for (int k = 0; k < seq_mat.nonZeros(); ++k) {
+      EXPECT_EQ(par_mat.innerIndexPtr()[k], seq_mat.innerIndexPtr()[k]);
+      // Bitwise agreement is expected!
+      EXPECT_EQ(par_mat.valuePtr()[k], seq_mat.valuePtr()[k])
+          << "mismatch for " << num_threads << " threads";
+    }
+  }
+}
+
+/** Element matrix provider whose matrix size depends on the entity type:
+ * one local shape function per vertex and edge, and one interior one. */
+class VarSizeTestAssembler {
+ public:
+  explicit VarSizeTestAssembler(const lf::mesh::Mesh &mesh) : mesh_(mesh) {}
+  bool isActive(const lf::mesh::Entity & /*entity*/) const { return true; }
+  Eigen::MatrixXd Eval(const lf::mesh::Entity &e) const {
+    const lf::base::RefEl ref_el = e.RefEl();
+    const int n = ref_el.NumNodes() +
+                  (ref_el.Dimension() == 2 ? ref_el.NumSubEntities(1) : 0) + 1;
+    Eigen::MatrixXd mat(n, n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        mat(i, j) = std::cos(1.0 + mesh_.Index(e) + i - 2.0 * j);
+      }
+    }
+    return mat;
+  }
+
+ private:
+  const lf::mesh::Mesh &mesh_;
+};
+
+TEST(lf_assembly, sparsity_pattern_assembly_test) {
+  // Hybrid mesh, dofs on all entities, and element matrices for cells and
+  // edges: checks the union of patterns of different co-dimensions
+  auto mesh_p = lf::mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  lf::assemble::UniformFEDofHandler dof_handler(
+      mesh_p, {{lf::base::RefEl::kPoint(), 1},
+               {lf::base::RefEl::kSegment(), 1},
+               {lf::base::RefEl::kTria(), 1},
+               {lf::base::RefEl::kQuad(), 1}});
+  lf::assemble::SparsityPattern pattern(dof_handler, {0, 1});
+  EXPECT_TRUE(pattern.HasCodim(0));
+  EXPECT_TRUE(pattern.HasCodim(1));
+  EXPECT_FALSE(pattern.HasCodim(2));
+
+  VarSizeTestAssembler elmat_builder{*mesh_p};
+
+  lf::assemble::COOMatrix<double> coo(dof_handler.NumDofs(),
+                                      dof_handler.NumDofs());
+  lf::assemble::AssembleMatrixLocally(0, dof_handler, dof_handler,
+                                      elmat_builder, coo);
+  lf::assemble::AssembleMatrixLocally(1, dof_handler, dof_handler,
+                                      elmat_builder, coo);
+  const Eigen::MatrixXd ref_mat = coo.makeDense();
+
+  Eigen::SparseMatrix<double> A = pattern.MakeSparseMatrix<double>();
+  EXPECT_EQ(A.nonZeros(), pattern.nonZeros());
+  EXPECT_TRUE(pattern.IsCompatible(A));
+  // A matrix of the same size and number of non-zeros, but with the non-zero
+  // entries packed into the leading columns, has a different structure
+  std::vector<Eigen::Triplet<double>> packed;
+  for (Eigen::Index k = 0; k < A.nonZeros(); ++k) {
+    packed.emplace_back(k % A.rows(), k / A.rows(), 1.0);
+  }
+  Eigen::SparseMatrix<double> B(A.rows(), A.cols());
+  B.setFromTriplets(packed.begin(), packed.end());
+  ASSERT_EQ(B.nonZeros(), A.nonZeros());
+  EXPECT_FALSE(pattern.IsCompatible(B));
+  // Assemble twice to check re-use of the pattern
+  for (int k = 0; k < 2; ++k) {
+    A.coeffs().setZero();
+    lf::assemble::AssembleMatrixLocally(0, pattern, elmat_builder, A);
+    lf::assemble::AssembleMatrixLocally(1, pattern, elmat_builder, A);
+    const Eigen::MatrixXd A_dense = A;
+    EXPECT_NEAR((A_dense - ref_mat).norm(), 0.0, 1.0E-12 * ref_mat.norm());
+  }
+}
+
+TEST(lf_assembly, rcm_renumbering_test) {
+  // Hybrid mesh, dofs on all entities (quadratic-like layout)
+  auto mesh_p = lf::mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  const lf::assemble::UniformFEDofHandler::dof_map_t dof_map{
+      {lf::base::RefEl::kPoint(), 1},
+      {lf::base::RefEl::kSegment(), 1},
+      {lf::base::RefEl::kTria(), 1},
+      {lf::base::RefEl::kQuad(), 1}};
+  lf::assemble::UniformFEDofHandler ref_dofh(mesh_p, dof_map);
+  lf::assemble::UniformFEDofHandler dofh(mesh_p, dof_map);
+
+  // The cell-to-dof map agrees with the dof handler
+  const lf::assemble::CellDofMap ref_cell_dofs(ref_dofh);
+  ASSERT_EQ(ref_cell_dofs.NumCells(), mesh_p->NumEntities(0));
+  for (const lf::mesh::Entity *cell : mesh_p->Entities(0)) {
+    const auto dofs = ref_dofh.GlobalDofIndices(*cell);
+    const auto csr_dofs = ref_cell_dofs.GlobalDofIndices(*cell);
+    ASSERT_EQ(dofs.size(), csr_dofs.size());
+    EXPECT_TRUE(std::equal(dofs.begin(), dofs.end(), csr_dofs.begin()));
+  }
+
+  const std::vector<lf::assemble::gdof_idx_t> new_index =
+      lf::assemble::ReverseCuthillMcKeeDofOrdering(ref_cell_dofs);
+  ASSERT_EQ(new_index.size(), ref_dofh.NumDofs());
+  std::vector<lf::assemble::gdof_idx_t> sorted_index(new_index);
+  std::sort(sorted_index.begin(), sorted_index.end());
+  for (lf::assemble::gdof_idx_t k = 0; k < ref_dofh.NumDofs(); ++k) {
+    EXPECT_EQ(sorted_index[k], k) << "not a permutation";
+  }
+  dofh.Renumber(new_index);
+
+  // Renumbered dofs on all entities, entities of the dofs
+  for (lf::base::dim_t codim = 0; codim <= 2; ++codim) {
+    for (const lf::mesh::Entity *e : mesh_p->Entities(codim)) {
+      const auto ref_dofs = ref_dofh.GlobalDofIndices(*e);
+      const auto dofs = dofh.GlobalDofIndices(*e);
+      ASSERT_EQ(ref_dofs.size(), dofs.size());
+      for (std::size_t k = 0; k < dofs.size(); ++k) {
+        EXPECT_EQ(dofs[k], new_index[ref_dofs[k]]);
+      }
+    }
+  }
+  for (lf::assemble::gdof_idx_t dof = 0; dof < ref_dofh.NumDofs(); ++dof) {
+    EXPECT_EQ(&ref_dofh.Entity(dof), &dofh.Entity(new_index[dof]));
+  }
+
+  // The bandwidth of the Galerkin matrix does not grow
+  auto bandwidth = [](const lf::assemble::CellDofMap &cell_dofs) {
+    lf::assemble::gdof_idx_t bw = 0;
+    for (lf::base::glb_idx_t k = 0; k < cell_dofs.NumCells(); ++k) {
+      const auto dofs = cell_dofs.GlobalDofIndices(k);
+      const auto [min, max] = std::minmax_element(dofs.begin(), dofs.end());
+      bw = std::max(bw, *max - *min);
+    }
+    return bw;
+  };
+  EXPECT_LE(bandwidth(lf::assemble::CellDofMap(dofh)),
+            bandwidth(ref_cell_dofs));
+}
+
 }  // namespace lf::assemble::test
@@ -13,6 +13,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 #include <lf/assemble/fix_dof.h>
@@ -236,4 +238,75 @@ TEST(lf_assembly, fix_dof_flags) {
   EXPECT_NEAR((x - exact).norm(), 0.0, 1.0E-12) << "Wrong result!";
 }
 
+TEST(lf_assembly, fix_dof_single_pass) {
+  // Non-symmetric matrix with repeated triplets and a missing diagonal entry
+  const int N = 12;
+  COOMatrix<double> A(N, N);
+  for (int k = 0; k < N; k++) {
+    A.AddToEntry(k, (k + 1) % N, -1.0 - 0.1 * k);
+    A.AddToEntry(k, (k + 5) % N, 0.5);
+    if (k != 7) {
+      A.AddToEntry(k, k, 2.0);
+      A.AddToEntry(k, k, 1.0 + k);
+    }
+  }
+  Eigen::VectorXd b = Eigen::VectorXd::LinSpaced(N, 1.0, 2.0);
+
+  // Dense reference
+  const std::vector<gdof_idx_t> fixed{0, 3, 7, 11};
+  Eigen::VectorXd x_fixed = Eigen::VectorXd::Zero(N);
+  for (gdof_idx_t k : fixed) {
+    x_fixed[k] = 1.0 - 0.25 * k;
+  }
+  Eigen::MatrixXd A_ref = A.makeDense();
+  Eigen::VectorXd b_ref = b - A_ref * x_fixed;
+  for (gdof_idx_t k : fixed) {
+    A_ref.row(k).setZero();
+    A_ref.col(k).setZero();
+    A_ref(k, k) = 1.0;
+    b_ref[k] = x_fixed[k];
+  }
+
+  int num_calls = 0;
+  auto selector = [&](gdof_idx_t i) -> std::pair<bool, double> {
+    ++num_calls;
+    const bool is_fixed =
+        std::find(fixed.begin(), fixed.end(), i) != fixed.end();
+    return {is_fixed, x_fixed[i]};
+  };
+
+  // COO matrix
+  COOMatrix<double> A_coo(A);
+  Eigen::VectorXd b_coo(b);
+  FixFlaggedSolutionComponents<double>(selector, A_coo, b_coo);
+  EXPECT_EQ(num_calls, N);
+  EXPECT_TRUE(A_coo.makeDense().isApprox(A_ref));
+  EXPECT_TRUE(b_coo.isApprox(b_ref));
+
+  // Compressed sparse matrix, the pattern is preserved
+  Eigen::SparseMatrix<double> A_crs(A.makeSparse());
+  const Eigen::Index nnz = A_crs.nonZeros();
+  Eigen::VectorXd b_crs(b);
+  const auto [flags, values] = EvaluateSelector<double>(selector, N);
+  FixFlaggedSolutionComponents(flags, values, A_crs, b_crs);
+  EXPECT_EQ(A_crs.nonZeros(), nnz + 1);
+  EXPECT_TRUE(Eigen::MatrixXd(A_crs).isApprox(A_ref));
+  EXPECT_TRUE(b_crs.isApprox(b_ref));
+
+  // Imposing the constraints again does not change the system
+  FixFlaggedSolutionComponents<double>(selector, A_crs, b_crs);
+  EXPECT_TRUE(Eigen::MatrixXd(A_crs).isApprox(A_ref));
+  EXPECT_TRUE(b_crs.isApprox(b_ref));
+
+  // Row major storage with 64 bit indices
+  Eigen::SparseMatrix<double, Eigen::RowMajor, std::int64_t> A_row(
+      A.makeSparse());
+  Eigen::VectorXd b_row(b);
+  FixFlaggedSolutionComponents<double>(selector, A_row, b_row);
+  EXPECT_TRUE(A_row.isCompressed());
+  EXPECT_EQ(A_row.nonZeros(), nnz + 1);
+  EXPECT_TRUE(Eigen::MatrixXd(A_row).isApprox(A_ref));
+  EXPECT_TRUE(b_row.isApprox(b_ref));
+}
+
 }  // namespace lf::assemble::test
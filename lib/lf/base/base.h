@@ -42,8 +42,10 @@ constexpr double kPi = 3.14159265358979323846;
 #include "invalid_type_exception.h"
 #include "lf_assert.h"
 #include "lf_exception.h"
+#include "parallel.h"
 #include "predicate_true.h"
 #include "ref_el.h"
+#include "reverse_cuthill_mckee.h"
 #include "span.h"
 
 #endif  // __986f32316282425d9be137cb399482f3
@@ -380,11 +380,21 @@ namespace cv = comm::variables;
  *
  * @note The executable code must not involve a comma operator.
  * Commas inside strings are ok.
+ *
+ * @note If the preprocessor symbol `LF_PRODUCTION_MODE` is defined, e.g. by
+ * configuring LehrFEM++ with the CMake option `LF_PRODUCTION_MODE=ON`, the
+ * macro expands to an empty block: neither the test of the control variable
+ * nor the statement are compiled.
  */
+#ifndef LF_PRODUCTION_MODE
 #define CONTROLLEDSTATEMENT(ctrlvar, level, statement) \
   if ((ctrlvar) >= (level)) {                          \
     statement;                                         \
   }
+#else
+#define CONTROLLEDSTATEMENT(ctrlvar, level, statement) \
+  {}
+#endif
 
 /**
  * @brief Macro for bit-flag-conditional output
@@ -397,10 +407,18 @@ namespace cv = comm::variables;
  *
  * @note The executable code must not involve a comma operator.
  * Commas inside strings are ok.
+ *
+ * @note Expands to an empty block if `LF_PRODUCTION_MODE` is defined, see
+ * #CONTROLLEDSTATEMENT.
  */
+#ifndef LF_PRODUCTION_MODE
 #define SWITCHEDSTATEMENT(ctrlvar, flagpat, statement) \
   if (((ctrlvar) & (flagpat)) > 0) {                   \
     statement;                                         \
   }
+#else
+#define SWITCHEDSTATEMENT(ctrlvar, flagpat, statement) \
+  {}
+#endif
 
 #endif  // __comm_h
@@ -0,0 +1,88 @@
+/**
+ * @file
+ * @brief Minimal helpers for distributing index ranges onto threads
+ * @copyright MIT License
+ */
+
+#ifndef __5e8aa9cb18654ef980749c369525497d
+#define __5e8aa9cb18654ef980749c369525497d
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace lf::base {
+
+/**
+ * @brief Number of threads used by the parallel algorithms of LehrFEM++ if
+ *        the caller does not specify it explicitly.
+ *
+ * @return `std::thread::hardware_concurrency()`, or 1 if that number cannot be
+ *         determined.
+ */
+inline unsigned int DefaultNumThreads() {
+  const unsigned int n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+/**
+ * @brief Split the index range `[0,n)` into `num_chunks` contiguous chunks of
+ *        (almost) equal size and process every chunk on its own thread.
+ *
+ * @tparam CHUNK_FN type of a functor with signature
+ *         `void(unsigned chunk, std::size_t begin, std::size_t end)`
+ * @param n length of the index range
+ * @param num_chunks number of chunks (=threads) to use. If it is larger than
+ *        `n`, only `n` chunks are created. If only one chunk remains, it is
+ *        processed directly on the calling thread.
+ * @param chunk_fn functor which is invoked exactly once for every chunk.
+ *
+ * Chunk `k` covers the indices `[k*n/num_chunks, (k+1)*n/num_chunks)`, i.e.
+ * the chunks are ordered: concatenating the results of all chunks in the order
+ * of their chunk number reproduces the results of a sequential loop over
+ * `[0,n)`.
+ *
+ * If `chunk_fn` throws for some chunk, all threads are joined and the
+ * exception of the chunk with the lowest number is rethrown.
+ *
+ * @note `chunk_fn` is called concurrently from different threads, it must be
+ *       safe to do so.
+ */
+template <class CHUNK_FN>
+void ParallelForChunks(std::size_t n, unsigned int num_chunks,
+                       CHUNK_FN &&chunk_fn) {
+  num_chunks = static_cast<unsigned int>(
+      std::max<std::size_t>(1, std::min<std::size_t>(num_chunks, n)));
+  if (num_chunks == 1) {
+    chunk_fn(0U, std::size_t{0}, n);
+    return;
+  }
+  std::vector<std::exception_ptr> errors(num_chunks);
+  std::vector<std::thread> threads;
+  threads.reserve(num_chunks - 1);
+  auto run_chunk = [&](unsigned int k) {
+    try {
+      chunk_fn(k, n * k / num_chunks, n * (k + 1) / num_chunks);
+    } catch (...) {
+      errors[k] = std::current_exception();
+    }
+  };
+  for (unsigned int k = 1; k < num_chunks; ++k) {
+    threads.emplace_back(run_chunk, k);
+  }
+  // The calling thread takes care of the first chunk itself
+  run_chunk(0);
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (auto &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+}  // namespace lf::base
+
+#endif  // __5e8aa9cb18654ef980749c369525497d
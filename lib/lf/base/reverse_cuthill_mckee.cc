@@ -0,0 +1,146 @@
+/**
+ * @file
+ * @brief Implementation of the reverse Cuthill-McKee ordering
+ * @copyright MIT License
+ */
+
+#include "reverse_cuthill_mckee.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "lf_assert.h"
+
+namespace lf::base {
+
+namespace /* anonymous */ {
+
+// Auxiliary class for the breadth first traversals of the graph
+class Graph {
+ public:
+  Graph(nonstd::span<const size_type> offsets,
+        nonstd::span<const size_type> neighbors)
+      : offsets_(offsets),
+        neighbors_(neighbors),
+        num_vertices_(static_cast<size_type>(offsets.size()) - 1),
+        stamp_(num_vertices_, 0) {}
+
+  [[nodiscard]] size_type NumVertices() const { return num_vertices_; }
+  [[nodiscard]] size_type Degree(size_type v) const {
+    return offsets_[v + 1] - offsets_[v];
+  }
+  [[nodiscard]] nonstd::span<const size_type> Neighbors(size_type v) const {
+    return neighbors_.subspan(offsets_[v], Degree(v));
+  }
+
+  // Breadth first search from `root` through the vertices not contained in
+  // `numbered`. Returns the number of levels and a vertex of minimal degree
+  // on the last level.
+  std::pair<size_type, size_type> LastLevel(size_type root,
+                                            const std::vector<bool> &numbered) {
+    ++current_stamp_;
+    queue_.clear();
+    queue_.push_back(root);
+    stamp_[root] = current_stamp_;
+    size_type num_levels = 0;
+    std::size_t level_begin = 0;
+    std::size_t level_end = 0;
+    while (level_end < queue_.size()) {
+      level_begin = level_end;
+      level_end = queue_.size();
+      ++num_levels;
+      for (std::size_t i = level_begin; i < level_end; ++i) {
+        for (const size_type w : Neighbors(queue_[i])) {
+          if (!numbered[w] && stamp_[w] != current_stamp_) {
+            stamp_[w] = current_stamp_;
+            queue_.push_back(w);
+          }
+        }
+      }
+    }
+    size_type candidate = queue_[level_begin];
+    for (std::size_t i = level_begin; i < level_end; ++i) {
+      if (Degree(queue_[i]) < Degree(candidate)) {
+        candidate = queue_[i];
+      }
+    }
+    return {num_levels, candidate};
+  }
+
+ private:
+  nonstd::span<const size_type> offsets_;
+  nonstd::span<const size_type> neighbors_;
+  size_type num_vertices_;
+  // marks vertices visited during the current traversal
+  std::vector<size_type> stamp_;
+  size_type current_stamp_ = 0;
+  std::vector<size_type> queue_;
+};
+
+}  // namespace
+
+std::vector<size_type> ReverseCuthillMcKee(
+    nonstd::span<const size_type> offsets,
+    nonstd::span<const size_type> neighbors) {
+  LF_ASSERT_MSG(!offsets.empty(), "offsets must have length n+1");
+  Graph graph(offsets, neighbors);
+  const size_type n = graph.NumVertices();
+
+  // Cuthill-McKee ordering, `order` also serves as the queue of the breadth
+  // first traversal
+  std::vector<size_type> order;
+  order.reserve(n);
+  std::vector<bool> numbered(n, false);
+  std::vector<size_type> next_level;
+
+  for (size_type first = 0; first < n; ++first) {
+    if (numbered[first]) {
+      continue;
+    }
+    // A new connected component: find a pseudo-peripheral starting vertex with
+    // the heuristic of George and Liu
+    size_type root = first;
+    auto [num_levels, candidate] = graph.LastLevel(root, numbered);
+    while (candidate != root) {
+      auto [candidate_levels, next_candidate] =
+          graph.LastLevel(candidate, numbered);
+      if (candidate_levels <= num_levels) {
+        break;
+      }
+      root = candidate;
+      num_levels = candidate_levels;
+      candidate = next_candidate;
+    }
+
+    // Breadth first numbering of the component
+    std::size_t head = order.size();
+    order.push_back(root);
+    numbered[root] = true;
+    while (head < order.size()) {
+      const size_type v = order[head++];
+      next_level.clear();
+      for (const size_type w : graph.Neighbors(v)) {
+        if (!numbered[w]) {
+          numbered[w] = true;
+          next_level.push_back(w);
+        }
+      }
+      std::sort(next_level.begin(), next_level.end(),
+                [&graph](size_type a, size_type b) {
+                  return std::make_pair(graph.Degree(a), a) <
+                         std::make_pair(graph.Degree(b), b);
+                });
+      order.insert(order.end(), next_level.begin(), next_level.end());
+    }
+  }
+  LF_ASSERT_MSG(order.size() == n, "Not all vertices have been numbered");
+
+  // Reverse the ordering
+  std::vector<size_type> new_index(n);
+  for (size_type k = 0; k < n; ++k) {
+    new_index[order[k]] = n - 1 - k;
+  }
+  return new_index;
+}
+
+}  // namespace lf::base
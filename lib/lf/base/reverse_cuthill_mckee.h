@@ -0,0 +1,43 @@
+/**
+ * @file
+ * @brief Bandwidth reducing reordering of the vertices of a graph
+ * @copyright MIT License
+ */
+
+#ifndef __2f0d5c8b9a3e4f61b7c4e0a18d6e5b72
+#define __2f0d5c8b9a3e4f61b7c4e0a18d6e5b72
+
+#include <vector>
+#include "base.h"
+#include "span.h"
+
+namespace lf::base {
+
+/**
+ * @brief Reverse Cuthill-McKee ordering of the vertices of an undirected graph
+ *
+ * @param offsets array of length `n+1`: the neighbors of vertex `i` are stored
+ *        in `neighbors[offsets[i]] ... neighbors[offsets[i+1]-1]`
+ * @param neighbors concatenated lists of neighbors of all vertices
+ *        (compressed sparse row format). The adjacency relation has to be
+ *        symmetric, loops (`i` is a neighbor of itself) are ignored.
+ * @return vector `new_index` of length `n` with `new_index[i]` = position of
+ *         vertex `i` in the new ordering. It is a permutation of `0...n-1`.
+ *
+ * The Cuthill-McKee algorithm numbers the vertices of every connected component
+ * in breadth first order, starting from a pseudo-peripheral vertex and visiting
+ * the neighbors of a vertex in the order of ascending degree. Reversing this
+ * ordering yields a numbering with small bandwidth and profile of the
+ * adjacency matrix: if the graph is the sparsity graph of a Galerkin matrix,
+ * coupled degrees of freedom receive close-by indices.
+ *
+ * The algorithm is deterministic, its cost is linear in the size of the graph
+ * (up to the sorting of neighbor lists).
+ */
+std::vector<size_type> ReverseCuthillMcKee(
+    nonstd::span<const size_type> offsets,
+    nonstd::span<const size_type> neighbors);
+
+}  // namespace lf::base
+
+#endif  // __2f0d5c8b9a3e4f61b7c4e0a18d6e5b72
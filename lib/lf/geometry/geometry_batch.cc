@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief Implementation of batched evaluation of geometric quantities
+ * @copyright MIT License
+ */
+
+#include "geometry_batch.h"
+#include <cmath>
+#include <typeinfo>
+#include "quad_o1.h"
+#include "tria_o1.h"
+
+namespace lf::geometry {
+
+namespace {
+// Coefficients of the bilinear map p0 + a*x + b*y + c*x*y for a batch of
+// geometries in structure-of-arrays layout
+struct BilinearCoeffs {
+  std::vector<double> p0x, p0y, ax, ay, bx, by, cx, cy;
+
+  explicit BilinearCoeffs(std::size_t n)
+      : p0x(n), p0y(n), ax(n), ay(n), bx(n), by(n), cx(n), cy(n) {}
+};
+}  // namespace
+
+GeometryBatch::GeometryBatch(const std::vector<const Geometry*>& geometries,
+                             Eigen::MatrixXd local)
+    : num_geo_(geometries.size()), local_(std::move(local)) {
+  LF_VERIFY_MSG(local_.rows() == 2, "Reference coordinates must be 2-vectors");
+  // Sizes of the arrays are computed in std::size_t, n * n_pts may exceed the
+  // range of size_type for large batches
+  const std::size_t n = num_geo_;
+  const std::size_t n_pts = local_.cols();
+  integration_element_.resize(n * n_pts);
+  for (auto& v : global_) {
+    v.resize(n * n_pts);
+  }
+  for (auto& v : jacobian_) {
+    v.resize(n * n_pts);
+  }
+  for (auto& v : jac_inv_gram_) {
+    v.resize(n * n_pts);
+  }
+
+  // Step I: extract coefficients of bilinear maps, remember all geometries
+  // which cannot be represented that way
+  BilinearCoeffs cf(n);
+  std::vector<size_type> generic_geos;
+  for (size_type i = 0; i < n; ++i) {
+    const Geometry* geo = geometries[i];
+    LF_ASSERT_MSG(geo != nullptr, "Missing geometry for entry " << i);
+    LF_VERIFY_MSG(geo->DimLocal() == 2 && geo->DimGlobal() == 2,
+                  "GeometryBatch supports planar 2D geometries only");
+    const auto& tid = typeid(*geo);
+    if (tid == typeid(TriaO1) || tid == typeid(Parallelogram) ||
+        tid == typeid(QuadO1)) {
+      const Eigen::MatrixXd corners{Corners(*geo)};
+      // For triangles the third vertex plays the role of the fourth vertex
+      // of a quadrilateral
+      const Eigen::Vector2d p0 = corners.col(0);
+      const Eigen::Vector2d p1 = corners.col(1);
+      const Eigen::Vector2d p3 = corners.col(corners.cols() - 1);
+      const Eigen::Vector2d c =
+          (tid == typeid(QuadO1))
+              ? Eigen::Vector2d(p0 - p1 + corners.col(2) - p3)
+              : Eigen::Vector2d::Zero();
+      cf.p0x[i] = p0[0];
+      cf.p0y[i] = p0[1];
+      cf.ax[i] = p1[0] - p0[0];
+      cf.ay[i] = p1[1] - p0[1];
+      cf.bx[i] = p3[0] - p0[0];
+      cf.by[i] = p3[1] - p0[1];
+      cf.cx[i] = c[0];
+      cf.cy[i] = c[1];
+    } else {
+      // Evaluated below through the Geometry interface. The dummy
+      // coefficients of the unit square keep the vectorized loop free of
+      // divisions by zero.
+      generic_geos.push_back(i);
+      cf.p0x[i] = cf.p0y[i] = 0.0;
+      cf.ax[i] = cf.by[i] = 1.0;
+      cf.ay[i] = cf.bx[i] = cf.cx[i] = cf.cy[i] = 0.0;
+    }
+  }
+
+  // Step II: vectorizable loops over all geometries
+  for (std::size_t q = 0; q < n_pts; ++q) {
+    const double x = local_(0, q);
+    const double y = local_(1, q);
+    const std::size_t off = q * n;
+    double* __restrict g_x = global_[0].data() + off;
+    double* __restrict g_y = global_[1].data() + off;
+    double* __restrict j00 = jacobian_[0].data() + off;
+    double* __restrict j10 = jacobian_[1].data() + off;
+    double* __restrict j01 = jacobian_[2].data() + off;
+    double* __restrict j11 = jacobian_[3].data() + off;
+    double* __restrict jit00 = jac_inv_gram_[0].data() + off;
+    double* __restrict jit10 = jac_inv_gram_[1].data() + off;
+    double* __restrict jit01 = jac_inv_gram_[2].data() + off;
+    double* __restrict jit11 = jac_inv_gram_[3].data() + off;
+    double* __restrict ie = integration_element_.data() + off;
+    for (std::size_t i = 0; i < n; ++i) {
+      g_x[i] = cf.p0x[i] + cf.ax[i] * x + cf.bx[i] * y + cf.cx[i] * x * y;
+      g_y[i] = cf.p0y[i] + cf.ay[i] * x + cf.by[i] * y + cf.cy[i] * x * y;
+      const double a00 = cf.ax[i] + cf.cx[i] * y;
+      const double a10 = cf.ay[i] + cf.cy[i] * y;
+      const double a01 = cf.bx[i] + cf.cx[i] * x;
+      const double a11 = cf.by[i] + cf.cy[i] * x;
+      const double det = a00 * a11 - a01 * a10;
+      j00[i] = a00;
+      j10[i] = a10;
+      j01[i] = a01;
+      j11[i] = a11;
+      // Transposed inverse of the Jacobian
+      jit00[i] = a11 / det;
+      jit10[i] = -a01 / det;
+      jit01[i] = -a10 / det;
+      jit11[i] = a00 / det;
+      ie[i] = std::abs(det);
+    }
+  }
+
+  // Step III: fallback for geometries of other types
+  for (const size_type i : generic_geos) {
+    const Geometry& geo{*geometries[i]};
+    const Eigen::MatrixXd glob{geo.Global(local_)};
+    const Eigen::MatrixXd jac{geo.Jacobian(local_)};
+    const Eigen::MatrixXd jit{geo.JacobianInverseGramian(local_)};
+    const Eigen::VectorXd ie{geo.IntegrationElement(local_)};
+    for (std::size_t q = 0; q < n_pts; ++q) {
+      const std::size_t k = q * n + i;
+      global_[0][k] = glob(0, q);
+      global_[1][k] = glob(1, q);
+      for (int c = 0; c < 4; ++c) {
+        jacobian_[c][k] = jac(c % 2, 2 * q + c / 2);
+        jac_inv_gram_[c][k] = jit(c % 2, 2 * q + c / 2);
+      }
+      integration_element_[k] = ie[q];
+    }
+  }
+}
+
+}  // namespace lf::geometry
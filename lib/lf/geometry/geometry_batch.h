@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @brief Evaluation of geometric quantities for many cells at once
+ * @copyright MIT License
+ */
+
+#ifndef __bb659931c7eb47b3b4e43734300f2438
+#define __bb659931c7eb47b3b4e43734300f2438
+
+#include <array>
+#include <vector>
+#include "geometry_interface.h"
+
+namespace lf::geometry {
+
+/**
+ * @brief Jacobians, integration elements and inverse Gramians of a whole
+ *        collection of planar geometries evaluated at a common set of
+ *        reference points.
+ *
+ * The methods of the Geometry interface are virtual and return freshly
+ * allocated Eigen matrices. When the same quantities are required for all cells
+ * of a mesh, e.g., for the computation of element matrices, this means many
+ * indirect calls and heap allocations per cell. A GeometryBatch computes all
+ * quantities in one sweep and stores them in contiguous arrays
+ * (structure-of-arrays layout): the value for geometry `i` and reference point
+ * `q` is stored at position `q * NumGeometries() + i`.
+ *
+ * The component-wise bilinear map
+ * @f[
+ *  \Phi(\hat{x}) = \mathbf{p}_0 + \mathbf{a}\hat{x}_1 + \mathbf{b}\hat{x}_2
+ *   + \mathbf{c}\hat{x}_1\hat{x}_2
+ * @f]
+ * covers the geometry types TriaO1, Parallelogram (both with
+ * @f$\mathbf{c}=0@f$) and QuadO1. For these the coefficients are extracted
+ * once and all quantities are computed by a simple, branch-free loop over the
+ * geometries that the compiler can vectorize. Geometries of any other type
+ * (e.g. TriaO2 or QuadO2) are evaluated through the virtual methods of the
+ * Geometry interface.
+ *
+ * @note Only geometries with `DimLocal() == DimGlobal() == 2` are supported.
+ *
+ * #### Example
+ * ~~~
+ * const lf::quad::QuadRule qr =
+ *     lf::quad::make_QuadRule(lf::base::RefEl::kTria(), 2);
+ * auto batch = lf::geometry::GeometryBatch::FromEntities(mesh.Entities(0),
+ *                                                        qr.Points());
+ * for (lf::base::size_type i = 0; i < batch.NumGeometries(); ++i) {
+ *   for (lf::base::size_type q = 0; q < batch.NumPoints(); ++q) {
+ *     sum += qr.Weights()[q] * batch.IntegrationElement(i, q);
+ *   }
+ * }
+ * ~~~
+ */
+class GeometryBatch {
+ public:
+  using size_type = lf::base::size_type;
+
+  /**
+   * @brief Evaluate geometric quantities for a collection of geometries
+   * @param geometries pointers to the geometry objects, must be valid during
+   *        the construction only.
+   * @param local 2 x P matrix whose columns contain the reference
+   *        coordinates of the evaluation points
+   */
+  GeometryBatch(const std::vector<const Geometry*>& geometries,
+                Eigen::MatrixXd local);
+
+  /**
+   * @brief Evaluate geometric quantities for all the geometries of a range of
+   *        mesh entities
+   * @tparam ENTITY_PTR_RANGE range of pointers to objects providing a method
+   *         `Geometry()`, e.g. the range returned by
+   *         `lf::mesh::Mesh::Entities()`
+   * @param entities the range of entity pointers, the order is retained
+   * @param local 2 x P matrix of reference coordinates
+   */
+  template <class ENTITY_PTR_RANGE>
+  static GeometryBatch FromEntities(const ENTITY_PTR_RANGE& entities,
+                                    Eigen::MatrixXd local) {
+    std::vector<const Geometry*> geometries;
+    for (const auto* entity : entities) {
+      geometries.push_back(entity->Geometry());
+    }
+    return GeometryBatch(geometries, std::move(local));
+  }
+
+  GeometryBatch(const GeometryBatch&) = default;
+  GeometryBatch(GeometryBatch&&) noexcept = default;
+  GeometryBatch& operator=(const GeometryBatch&) = default;
+  GeometryBatch& operator=(GeometryBatch&&) noexcept = default;
+  ~GeometryBatch() = default;
+
+  /** @brief Number of geometries in the batch */
+  [[nodiscard]] size_type NumGeometries() const { return num_geo_; }
+  /** @brief Number of reference points */
+  [[nodiscard]] size_type NumPoints() const { return local_.cols(); }
+  /** @brief The reference points passed to the constructor */
+  [[nodiscard]] const Eigen::MatrixXd& LocalPoints() const { return local_; }
+
+  /** @brief integration element of geometry `i` at reference point `q` */
+  [[nodiscard]] double IntegrationElement(size_type i, size_type q) const {
+    return integration_element_[Pos(i, q)];
+  }
+  /** @brief global coordinates of reference point `q` mapped by geometry `i`*/
+  [[nodiscard]] Eigen::Vector2d Global(size_type i, size_type q) const {
+    const std::size_t k = Pos(i, q);
+    return {global_[0][k], global_[1][k]};
+  }
+  /** @brief Jacobian of geometry `i` at reference point `q` */
+  [[nodiscard]] Eigen::Matrix2d Jacobian(size_type i, size_type q) const {
+    const std::size_t k = Pos(i, q);
+    return (Eigen::Matrix2d() << jacobian_[0][k], jacobian_[2][k],
+            jacobian_[1][k], jacobian_[3][k])
+        .finished();
+  }
+  /**
+   * @brief The transposed inverse of the Jacobian of geometry `i` at reference
+   * point `q`, cf. Geometry::JacobianInverseGramian()
+   */
+  [[nodiscard]] Eigen::Matrix2d JacobianInverseGramian(size_type i,
+                                                       size_type q) const {
+    const std::size_t k = Pos(i, q);
+    return (Eigen::Matrix2d() << jac_inv_gram_[0][k], jac_inv_gram_[2][k],
+            jac_inv_gram_[1][k], jac_inv_gram_[3][k])
+        .finished();
+  }
+
+  /**
+   * @name Raw access to the structure-of-arrays storage
+   * Entries for geometry `i` and point `q` are located at position
+   * `q * NumGeometries() + i`. Matrices are stored column-wise, that is,
+   * `JacobianData()[1]` holds the (1,0) entries of the Jacobians.
+   * @{
+   */
+  [[nodiscard]] const std::vector<double>& IntegrationElementData() const {
+    return integration_element_;
+  }
+  [[nodiscard]] const std::array<std::vector<double>, 2>& GlobalData() const {
+    return global_;
+  }
+  [[nodiscard]] const std::array<std::vector<double>, 4>& JacobianData() const {
+    return jacobian_;
+  }
+  [[nodiscard]] const std::array<std::vector<double>, 4>&
+  JacobianInverseGramianData() const {
+    return jac_inv_gram_;
+  }
+  /** @} */
+
+ private:
+  [[nodiscard]] std::size_t Pos(size_type i, size_type q) const {
+    LF_ASSERT_MSG(i < num_geo_ && q < local_.cols(),
+                  "Index (" << i << ',' << q << ") out of range");
+    return static_cast<std::size_t>(q) * num_geo_ + i;
+  }
+
+  size_type num_geo_;
+  Eigen::MatrixXd local_;
+  std::vector<double> integration_element_;
+  std::array<std::vector<double>, 2> global_;
+  std::array<std::vector<double>, 4> jacobian_;
+  std::array<std::vector<double>, 4> jac_inv_gram_;
+};
+
+}  // namespace lf::geometry
+
+#endif  // __bb659931c7eb47b3b4e43734300f2438
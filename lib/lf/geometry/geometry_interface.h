@@ -156,6 +156,37 @@ class Geometry {
   [[nodiscard]] virtual Eigen::VectorXd IntegrationElement(
       const Eigen::MatrixXd& local) const = 0;
 
+  /**
+   * @brief Global() with the result written into a matrix provided by the
+   *        caller
+   * @param local as for Global()
+   * @param result overwritten with `Global(local)`, resized if necessary
+   *
+   * The default implementation assigns the matrix returned by Global(). The
+   * first-order geometries of triangles and quadrilaterals override it and do
+   * not allocate memory if `result` already has the right size, which allows
+   * repeated evaluations into the same matrix without heap allocations.
+   */
+  virtual void GlobalInto(const Eigen::MatrixXd& local,
+                          Eigen::MatrixXd& result) const {
+    result = Global(local);
+  }
+
+  /**
+   * @brief JacobianInverseGramian() with the result written into a matrix
+   *        provided by the caller
+   * @param local as for JacobianInverseGramian()
+   * @param result overwritten with `JacobianInverseGramian(local)`, resized if
+   *        necessary
+   *
+   * As for GlobalInto(), first-order geometries of planar triangles and
+   * quadrilaterals do not allocate memory if `result` has the right size.
+   */
+  virtual void JacobianInverseGramianInto(const Eigen::MatrixXd& local,
+                                          Eigen::MatrixXd& result) const {
+    result = JacobianInverseGramian(local);
+  }
+
   /**
    * @brief **Construct** a new Geometry() object that describes the geometry of
    *        the `i`-th sub-entity with codimension=`codim`
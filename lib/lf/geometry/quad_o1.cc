@@ -153,6 +153,36 @@ Eigen::VectorXd QuadO1::IntegrationElement(const Eigen::MatrixXd& local) const {
 }
 /* SAM_LISTING_END_4 */
 
+void QuadO1::GlobalInto(const Eigen::MatrixXd& local,
+                        Eigen::MatrixXd& result) const {
+  LF_ASSERT_MSG(local.rows() == 2, "reference coords must be 2-vectors");
+  result.resize(DimGlobal(), local.cols());
+  for (Eigen::Index i = 0; i < local.cols(); ++i) {
+    const double x = local(0, i);
+    const double y = local(1, i);
+    result.col(i) = coords_.col(0) * ((1 - x) * (1 - y)) +
+                    coords_.col(1) * (x * (1 - y)) +
+                    coords_.col(2) * (x * y) + coords_.col(3) * ((1 - x) * y);
+  }
+}
+
+void QuadO1::JacobianInverseGramianInto(const Eigen::MatrixXd& local,
+                                        Eigen::MatrixXd& result) const {
+  if (DimGlobal() != 2) {
+    Geometry::JacobianInverseGramianInto(local, result);
+    return;
+  }
+  result.resize(2, local.cols() * 2);
+  Eigen::Matrix2d jacobian;
+  for (Eigen::Index i = 0; i < local.cols(); ++i) {
+    jacobian.col(0) = (coords_.col(1) - coords_.col(0)) * (1 - local(1, i)) +
+                      (coords_.col(2) - coords_.col(3)) * local(1, i);
+    jacobian.col(1) = (coords_.col(3) - coords_.col(0)) * (1 - local(0, i)) +
+                      (coords_.col(2) - coords_.col(1)) * local(0, i);
+    result.block<2, 2>(0, 2 * i) = jacobian.transpose().inverse();
+  }
+}
+
 std::unique_ptr<Geometry> QuadO1::SubGeometry(dim_t codim, dim_t i) const {
   using std::make_unique;
   switch (codim) {
@@ -319,6 +349,20 @@ Eigen::VectorXd Parallelogram::IntegrationElement(
   return Eigen::VectorXd::Constant(local.cols(), integrationElement_);
 }
 
+void Parallelogram::GlobalInto(const Eigen::MatrixXd& local,
+                               Eigen::MatrixXd& result) const {
+  result.resize(DimGlobal(), local.cols());
+  for (Eigen::Index i = 0; i < local.cols(); ++i) {
+    result.col(i) = coords_.col(0) + local(0, i) * jacobian_.col(0) +
+                    local(1, i) * jacobian_.col(1);
+  }
+}
+
+void Parallelogram::JacobianInverseGramianInto(const Eigen::MatrixXd& local,
+                                               Eigen::MatrixXd& result) const {
+  result = jacobian_inverse_gramian_.replicate(1, local.cols());
+}
+
 // essentially a copy of the same method for QuadO1
 std::unique_ptr<Geometry> Parallelogram::SubGeometry(dim_t codim,
                                                      dim_t i) const {
@@ -67,6 +67,12 @@ class QuadO1 : public Geometry {
    */
   [[nodiscard]] Eigen::VectorXd IntegrationElement(
       const Eigen::MatrixXd& local) const override;
+  /** @copydoc Geometry::GlobalInto() */
+  void GlobalInto(const Eigen::MatrixXd& local,
+                  Eigen::MatrixXd& result) const override;
+  /** @copydoc Geometry::JacobianInverseGramianInto() */
+  void JacobianInverseGramianInto(const Eigen::MatrixXd& local,
+                                  Eigen::MatrixXd& result) const override;
 
   /** @copydoc Geometry::SubGeometry() */
   [[nodiscard]] std::unique_ptr<Geometry> SubGeometry(dim_t codim,
@@ -133,6 +139,10 @@ class Parallelogram : public Geometry {
       const Eigen::MatrixXd& local) const override;
   [[nodiscard]] Eigen::VectorXd IntegrationElement(
       const Eigen::MatrixXd& local) const override;
+  void GlobalInto(const Eigen::MatrixXd& local,
+                  Eigen::MatrixXd& result) const override;
+  void JacobianInverseGramianInto(const Eigen::MatrixXd& local,
+                                  Eigen::MatrixXd& result) const override;
 
   /** @copydoc Geometry::SubGeometry() */
   [[nodiscard]] std::unique_ptr<Geometry> SubGeometry(dim_t codim,
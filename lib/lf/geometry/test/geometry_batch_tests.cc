@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <lf/geometry/geometry.h>
+
+namespace lf::geometry::test {
+
+TEST(GeometryBatchTest, agreesWithGeometryInterface) {
+  std::vector<std::unique_ptr<Geometry>> geos;
+  geos.push_back(std::make_unique<TriaO1>(
+      (Eigen::Matrix<double, Eigen::Dynamic, 3>(2, 3) << 0, 2, 0.5, 0, 0.3, 1)
+          .finished()));
+  geos.push_back(std::make_unique<QuadO1>(
+      (Eigen::Matrix<double, Eigen::Dynamic, 4>(2, 4) << 2, 3, 3.5, 2, 2, 1,
+       2.2, 3)
+          .finished()));
+  geos.push_back(std::make_unique<Parallelogram>(
+      (Eigen::Matrix<double, Eigen::Dynamic, 4>(2, 4) << 2, 3, 3, 2, 2, 1, 2,
+       3)
+          .finished()));
+  // Curved triangle, handled by the fallback
+  geos.push_back(std::make_unique<TriaO2>(
+      (Eigen::Matrix<double, Eigen::Dynamic, 6>(2, 6) << 0, 1, 0, 0.5, 0.6,
+       0.0, 0, 0, 1, 0.1, 0.5, 0.5)
+          .finished()));
+  // Orientation reversed
+  geos.push_back(std::make_unique<TriaO1>(
+      (Eigen::Matrix<double, Eigen::Dynamic, 3>(2, 3) << 0, 0.3, 1, 0, 1, 0.1)
+          .finished()));
+
+  Eigen::MatrixXd refcoords(2, 3);
+  refcoords << 0.2, 0.7, 0.1, 0.3, 0.1, 0.6;
+
+  std::vector<const Geometry *> geo_ptrs;
+  for (const auto &g : geos) {
+    geo_ptrs.push_back(g.get());
+  }
+  const GeometryBatch batch(geo_ptrs, refcoords);
+  ASSERT_EQ(batch.NumGeometries(), geos.size());
+  ASSERT_EQ(batch.NumPoints(), refcoords.cols());
+
+  for (unsigned i = 0; i < geos.size(); ++i) {
+    const Eigen::MatrixXd glob = geos[i]->Global(refcoords);
+    const Eigen::MatrixXd jac = geos[i]->Jacobian(refcoords);
+    const Eigen::MatrixXd jit = geos[i]->JacobianInverseGramian(refcoords);
+    const Eigen::VectorXd ie = geos[i]->IntegrationElement(refcoords);
+    for (unsigned q = 0; q < refcoords.cols(); ++q) {
+      EXPECT_NEAR((batch.Global(i, q) - glob.col(q)).norm(), 0.0, 1e-12)
+          << "geometry " << i << ", point " << q;
+      EXPECT_NEAR((batch.Jacobian(i, q) - jac.block(0, 2 * q, 2, 2)).norm(),
+                  0.0, 1e-12)
+          << "geometry " << i << ", point " << q;
+      EXPECT_NEAR((batch.JacobianInverseGramian(i, q) -
+                   jit.block(0, 2 * q, 2, 2))
+                      .norm(),
+                  0.0, 1e-12)
+          << "geometry " << i << ", point " << q;
+      EXPECT_NEAR(batch.IntegrationElement(i, q), ie[q], 1e-12)
+          << "geometry " << i << ", point " << q;
+    }
+  }
+}
+
+}  // namespace lf::geometry::test
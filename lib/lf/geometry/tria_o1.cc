@@ -71,6 +71,15 @@ Eigen::MatrixXd TriaO1::Global(const Eigen::MatrixXd& local) const {
          coords_.col(1) * local.row(0) + coords_.col(2) * local.row(1);
 }
 
+void TriaO1::GlobalInto(const Eigen::MatrixXd& local,
+                        Eigen::MatrixXd& result) const {
+  result.resize(DimGlobal(), local.cols());
+  for (Eigen::Index i = 0; i < local.cols(); ++i) {
+    result.col(i) = coords_.col(0) + local(0, i) * jacobian_.col(0) +
+                    local(1, i) * jacobian_.col(1);
+  }
+}
+
 std::unique_ptr<Geometry> TriaO1::SubGeometry(dim_t codim, dim_t i) const {
   using std::make_unique;
   switch (codim) {
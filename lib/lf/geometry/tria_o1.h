@@ -44,6 +44,12 @@ class TriaO1 : public Geometry {
       const Eigen::MatrixXd& local) const override {
     return Eigen::VectorXd::Constant(local.cols(), integrationElement_);
   }
+  void GlobalInto(const Eigen::MatrixXd& local,
+                  Eigen::MatrixXd& result) const override;
+  void JacobianInverseGramianInto(const Eigen::MatrixXd& local,
+                                  Eigen::MatrixXd& result) const override {
+    result = jacobian_inverse_gramian_.replicate(1, local.cols());
+  }
   [[nodiscard]] std::unique_ptr<Geometry> SubGeometry(dim_t codim,
                                                       dim_t i) const override;
 
@@ -607,8 +607,7 @@ const std::vector<GMshFileV2::ElementType> GMshFileV2::AllElementTypes{
     ElementType::EDGE6,     ElementType::TET20,     ElementType::TET35,
     ElementType::TET56,     ElementType::HEX64,     ElementType::HEX125};
 
-GMshFileV2 readGmshFileV2(std::string::const_iterator begin,
-                          std::string::const_iterator end,
+GMshFileV2 readGmshFileV2(const char* begin, const char* end,
                           const std::string& version, bool is_binary,
                           int size_t_size, int one,
                           const std::string& filename) {
@@ -631,7 +630,7 @@ GMshFileV2 readGmshFileV2(std::string::const_iterator begin,
   // can only use parsers without skippers!
   // http://boost-spirit.com/home/2010/02/24/parsing-skippers-and-skipping-parsers/
   // (see comment section)
-  using iterator_t = std::string::const_iterator;
+  using iterator_t = const char*;
   qi::rule<iterator_t, Eigen::Vector3d> vec3;
   qi::rule<iterator_t, std::pair<size_type, Eigen::Vector3d>()> node;
   qi::rule<iterator_t, GMshFileV2::Element(), qi::locals<int>> elementText;
@@ -259,8 +259,7 @@ base::RefEl RefElOf(GMshFileV2::ElementType et);
  * \note We support the MshFile format 2.2 in binary or text form.
  * \note This routine is mainly used by the GmshReader class.
  */
-GMshFileV2 readGmshFileV2(std::string::const_iterator begin,
-                          std::string::const_iterator end,
+GMshFileV2 readGmshFileV2(const char* begin, const char* end,
                           const std::string& version, bool is_binary,
                           int size_t_size, int one,
                           const std::string& filename);
@@ -294,20 +294,23 @@ int DimOf(GMshFileV4::ElementType et) {
 namespace detail {
 
 // defined in gmsh_file_v4_text.cc
-bool ParseGmshFileV4Text(std::string::const_iterator begin,
-                         std::string::const_iterator end, GMshFileV4* result);
+bool ParseGmshFileV4Text(const char* begin, const char* end,
+                         GMshFileV4* result);
 
-bool ParseGmshFileV4Binary(std::string::const_iterator begin,
-                           std::string::const_iterator end, int one,
+bool ParseGmshFileV4Binary(const char* begin, const char* end, int one,
                            GMshFileV4* result);
 
+bool ParseGmshFileV4BinaryParallel(const char* begin, const char* end, int one,
+                                   unsigned int num_threads,
+                                   GMshFileV4* result);
+
 }  // namespace detail
 
-GMshFileV4 ReadGmshFileV4(std::string::const_iterator begin,
-                          std::string::const_iterator end,
+GMshFileV4 ReadGmshFileV4(const char* begin, const char* end,
                           const std::string& version, bool is_binary,
                           int size_t_size, int one,
-                          const std::string& filename) {
+                          const std::string& filename,
+                          unsigned int num_threads) {
   LF_VERIFY_MSG(version == "4.1", "Only version 4.1 is supported so far");
   LF_VERIFY_MSG(size_t_size == sizeof(std::size_t),
                 "size of size_t must be " << sizeof(std::size_t));
@@ -320,6 +323,9 @@ GMshFileV4 ReadGmshFileV4(std::string::const_iterator begin,
   bool succesful = false;
   if (!is_binary) {
     succesful = detail::ParseGmshFileV4Text(begin, end, &result);
+  } else if (num_threads > 1) {
+    succesful = detail::ParseGmshFileV4BinaryParallel(begin, end, one,
+                                                      num_threads, &result);
   } else {
     succesful = detail::ParseGmshFileV4Binary(begin, end, one, &result);
   }
@@ -524,12 +524,25 @@ std::ostream& operator<<(std::ostream& stream, GMshFileV4::ElementType et);
  * header)
  * @param filename The name of the file that is being parsed (for better
  * diagnostics)
+ * @param num_threads Number of threads used to decode the `$Nodes` and
+ * `$Elements` sections of binary files, see below.
+ *
+ * ### Parallel parsing of binary files
+ * In binary files the node and element blocks are stored with explicit sizes,
+ * hence their positions can be determined by reading the block headers only.
+ * If `is_binary==true` and `num_threads > 1`, this function first locates all
+ * node/element blocks and allocates memory for them. Afterwards the nodes and
+ * elements are decoded concurrently by `num_threads` threads, whereby the work
+ * is split evenly irrespective of the sizes of the individual blocks. The
+ * result is identical to the one of the sequential parser.
+ *
+ * Text files are always parsed sequentially.
  */
-GMshFileV4 ReadGmshFileV4(std::string::const_iterator begin,
-                          std::string::const_iterator end,
+GMshFileV4 ReadGmshFileV4(const char* begin, const char* end,
                           const std::string& version, bool is_binary,
                           int size_t_size, int one,
-                          const std::string& filename);
+                          const std::string& filename,
+                          unsigned int num_threads = 1);
 
 }  // namespace lf::io
 
@@ -8,6 +8,15 @@
  * @copyright MIT License
  */
 
+#include <lf/base/base.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
 #include "gmsh_file_v4_detail.h"
 
 namespace lf::io {
@@ -292,21 +301,286 @@ struct MshV4GrammarBinary
   phoenix::function<ErrorHandler> error_handler_;
 };
 
+// Helpers for the parallel parser
+////////////////////////////////////////////////////////////////////////////////
+
+// true if the machine stores integers with the least significant byte first
+bool HostIsLittleEndian() {
+  const std::uint32_t probe = 1;
+  char first_byte;
+  std::memcpy(&first_byte, &probe, 1);
+  return first_byte == 1;
+}
+
+// Decode a binary value of type T starting at iter and advance iter
+template <class T>
+T ReadBinary(const char*& iter, bool swap_bytes) {
+  std::array<char, sizeof(T)> bytes;
+  std::memcpy(bytes.data(), iter, sizeof(T));
+  if (swap_bytes) {
+    std::reverse(bytes.begin(), bytes.end());
+  }
+  T value;
+  std::memcpy(&value, bytes.data(), sizeof(T));
+  iter += sizeof(T);
+  return value;
+}
+
+// Are there at least `count` items of `item_size` bytes left?
+bool Available(const char* iter, const char* end, std::size_t count,
+               std::size_t item_size) {
+  return count <= static_cast<std::size_t>(end - iter) / item_size;
+}
+
+// Skip white space (as ascii::space) and try to consume the given literal
+bool ConsumeLiteral(const char*& iter, const char* end, std::string_view lit,
+                    bool skip_space) {
+  while (skip_space && iter != end &&
+         std::isspace(static_cast<unsigned char>(*iter))) {
+    ++iter;
+  }
+  if (static_cast<std::size_t>(end - iter) < lit.size() ||
+      std::string_view(iter, lit.size()) != lit) {
+    return false;
+  }
+  iter += lit.size();
+  return true;
+}
+
+// Find the block, into which item number k falls
+std::size_t BlockOf(const std::vector<std::size_t>& first_item,
+                    std::size_t k) {
+  return std::upper_bound(first_item.begin(), first_item.end(), k) -
+         first_item.begin() - 1;
+}
+
+// Locate the node blocks of the $Nodes section, allocate the memory for them
+// and decode the node tags/coordinates of all blocks in parallel.
+bool ParseNodesParallel(const char*& iter, const char* end, bool swap_bytes,
+                        unsigned int num_threads, GMshFileV4::Nodes* nodes) {
+  if (!ConsumeLiteral(iter, end, "$Nodes\n", true) ||
+      !Available(iter, end, 4, sizeof(std::uint64_t))) {
+    return false;
+  }
+  const auto num_blocks = ReadBinary<std::uint64_t>(iter, swap_bytes);
+  nodes->num_nodes = ReadBinary<std::uint64_t>(iter, swap_bytes);
+  nodes->min_node_tag = ReadBinary<std::uint64_t>(iter, swap_bytes);
+  nodes->max_node_tag = ReadBinary<std::uint64_t>(iter, swap_bytes);
+
+  // First pass: find the offsets of the blocks, only the block headers are
+  // decoded. Block b contains the nodes [first_node[b], first_node[b+1])
+  constexpr std::size_t header_size = 3 * 4 + 8;
+  constexpr std::size_t node_size = 8 + 3 * 8;
+  if (!Available(iter, end, num_blocks, header_size)) {
+    return false;
+  }
+  nodes->node_blocks.resize(num_blocks);
+  std::vector<const char*> block_data(num_blocks);
+  std::vector<std::size_t> first_node(num_blocks + 1, 0);
+  for (std::size_t b = 0; b < num_blocks; ++b) {
+    if (!Available(iter, end, 1, header_size)) {
+      return false;
+    }
+    auto& block = nodes->node_blocks[b];
+    block.entity_dim =
+        static_cast<int>(ReadBinary<std::uint32_t>(iter, swap_bytes));
+    block.entity_tag =
+        static_cast<int>(ReadBinary<std::uint32_t>(iter, swap_bytes));
+    block.parametric = ReadBinary<std::uint32_t>(iter, swap_bytes) != 0;
+    const auto num_nodes = ReadBinary<std::uint64_t>(iter, swap_bytes);
+    if (!Available(iter, end, num_nodes, node_size)) {
+      return false;
+    }
+    block.nodes.resize(num_nodes);
+    block_data[b] = iter;
+    first_node[b + 1] = first_node[b] + num_nodes;
+    iter += num_nodes * node_size;
+  }
+  if (!ConsumeLiteral(iter, end, "\n$EndNodes", false)) {
+    return false;
+  }
+
+  // Second pass: decode the nodes, the work is split evenly among the threads
+  // irrespective of the block sizes.
+  lf::base::ParallelForChunks(
+      first_node.back(), num_threads,
+      [&](unsigned int /*chunk*/, std::size_t chunk_begin,
+          std::size_t chunk_end) {
+        std::size_t b = BlockOf(first_node, chunk_begin);
+        for (std::size_t k = chunk_begin; k < chunk_end; ++k) {
+          while (k >= first_node[b + 1]) {
+            ++b;
+          }
+          const std::size_t local = k - first_node[b];
+          const std::size_t block_size = first_node[b + 1] - first_node[b];
+          const char* tag_ptr = block_data[b] + 8 * local;
+          const char* coord_ptr =
+              block_data[b] + 8 * block_size + 3 * 8 * local;
+          auto& node = nodes->node_blocks[b].nodes[local];
+          node.first = ReadBinary<std::uint64_t>(tag_ptr, swap_bytes);
+          node.second.x() = ReadBinary<double>(coord_ptr, swap_bytes);
+          node.second.y() = ReadBinary<double>(coord_ptr, swap_bytes);
+          node.second.z() = ReadBinary<double>(coord_ptr, swap_bytes);
+        }
+      });
+  return true;
+}
+
+// Same as ParseNodesParallel() but for the $Elements section
+bool ParseElementsParallel(const char*& iter, const char* end,
+                           bool swap_bytes, unsigned int num_threads,
+                           GMshFileV4::Elements* elements) {
+  if (!ConsumeLiteral(iter, end, "$Elements\n", true) ||
+      !Available(iter, end, 4, sizeof(std::uint64_t))) {
+    return false;
+  }
+  const auto num_blocks = ReadBinary<std::uint64_t>(iter, swap_bytes);
+  elements->num_elements = ReadBinary<std::uint64_t>(iter, swap_bytes);
+  elements->min_element_tag = ReadBinary<std::uint64_t>(iter, swap_bytes);
+  elements->max_element_tag = ReadBinary<std::uint64_t>(iter, swap_bytes);
+
+  constexpr std::size_t header_size = 3 * 4 + 8;
+  if (!Available(iter, end, num_blocks, header_size)) {
+    return false;
+  }
+  elements->element_blocks.resize(num_blocks);
+  std::vector<const char*> block_data(num_blocks);
+  std::vector<std::size_t> first_element(num_blocks + 1, 0);
+  for (std::size_t b = 0; b < num_blocks; ++b) {
+    if (!Available(iter, end, 1, header_size)) {
+      return false;
+    }
+    auto& block = elements->element_blocks[b];
+    block.dimension =
+        static_cast<int>(ReadBinary<std::uint32_t>(iter, swap_bytes));
+    block.entity_tag =
+        static_cast<int>(ReadBinary<std::uint32_t>(iter, swap_bytes));
+    block.element_type = static_cast<GMshFileV4::ElementType>(
+        ReadBinary<std::uint32_t>(iter, swap_bytes));
+    const auto num_elements = ReadBinary<std::uint64_t>(iter, swap_bytes);
+    // every element consists of its tag followed by the tags of its nodes
+    const std::size_t element_size = 8 * (1 + NumNodes(block.element_type));
+    if (!Available(iter, end, num_elements, element_size)) {
+      return false;
+    }
+    block.elements.resize(num_elements);
+    block_data[b] = iter;
+    first_element[b + 1] = first_element[b] + num_elements;
+    iter += num_elements * element_size;
+  }
+  if (!ConsumeLiteral(iter, end, "\n$EndElements", false)) {
+    return false;
+  }
+
+  lf::base::ParallelForChunks(
+      first_element.back(), num_threads,
+      [&](unsigned int /*chunk*/, std::size_t chunk_begin,
+          std::size_t chunk_end) {
+        std::size_t b = BlockOf(first_element, chunk_begin);
+        for (std::size_t k = chunk_begin; k < chunk_end; ++k) {
+          while (k >= first_element[b + 1]) {
+            ++b;
+          }
+          auto& block = elements->element_blocks[b];
+          const std::size_t local = k - first_element[b];
+          const std::size_t num_nodes = NumNodes(block.element_type);
+          const char* ptr = block_data[b] + 8 * (1 + num_nodes) * local;
+          auto& element = block.elements[local];
+          element.first = ReadBinary<std::uint64_t>(ptr, swap_bytes);
+          element.second.resize(num_nodes);
+          for (auto& node_tag : element.second) {
+            node_tag = ReadBinary<std::uint64_t>(ptr, swap_bytes);
+          }
+        }
+      });
+  return true;
+}
+
+// Parse the sections before and after $Nodes/$Elements with the rules of the
+// (sequential) grammar and the $Nodes/$Elements sections in parallel.
+template <class GRAMMAR>
+bool ParseBinaryParallel(const GRAMMAR& grammar, const char* begin,
+                         const char* end, bool swap_bytes,
+                         unsigned int num_threads, GMshFileV4* result) {
+  auto iter = begin;
+  auto skip_comments = [&]() {
+    qi::phrase_parse(iter, end, *grammar.comment_, ascii::space);
+  };
+  try {
+    skip_comments();
+    if (qi::phrase_parse(iter, end, grammar.physical_name_vector_,
+                         ascii::space, result->physical_names)) {
+      skip_comments();
+    }
+    if (!qi::phrase_parse(iter, end, grammar.entities_, ascii::space,
+                          result->entities)) {
+      return false;
+    }
+    skip_comments();
+    if (qi::phrase_parse(iter, end, grammar.partitioned_entities_,
+                         ascii::space, result->partitioned_entities)) {
+      skip_comments();
+    }
+    if (!ParseNodesParallel(iter, end, swap_bytes, num_threads,
+                            &result->nodes)) {
+      std::cout << "Error in MshFileV4! Could not read $Nodes section."
+                << std::endl;
+      return false;
+    }
+    skip_comments();
+    if (!ParseElementsParallel(iter, end, swap_bytes, num_threads,
+                               &result->elements)) {
+      std::cout << "Error in MshFileV4! Could not read $Elements section."
+                << std::endl;
+      return false;
+    }
+    skip_comments();
+    if (qi::phrase_parse(iter, end, grammar.periodic_links_, ascii::space,
+                         result->periodic_links)) {
+      skip_comments();
+    }
+    if (qi::phrase_parse(iter, end, grammar.ghost_elements_, ascii::space,
+                         result->ghost_elements)) {
+      skip_comments();
+    }
+  } catch (const qi::expectation_failure<const char*>& e) {
+    std::cout << "Error in MshFileV4! Expecting " << e.what_ << std::endl;
+    return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 namespace detail {
-bool ParseGmshFileV4Binary(std::string::const_iterator begin,
-                           std::string::const_iterator end, int one,
+bool ParseGmshFileV4Binary(const char* begin, const char* end, int one,
                            GMshFileV4* result) {
   if (one == 1) {
-    MshV4GrammarBinary<std::string::const_iterator> grammar(
+    MshV4GrammarBinary<const char*> grammar(
         qi::little_dword, qi::little_qword, qi::little_bin_double);
     return qi::phrase_parse(begin, end, grammar, ascii::space, *result);
   }
-  MshV4GrammarBinary<std::string::const_iterator> grammar(
+  MshV4GrammarBinary<const char*> grammar(
       qi::big_dword, qi::big_qword, qi::big_bin_double);
   return qi::phrase_parse(begin, end, grammar, ascii::space, *result);
 }
+
+bool ParseGmshFileV4BinaryParallel(const char* begin, const char* end, int one,
+                                   unsigned int num_threads,
+                                   GMshFileV4* result) {
+  // one == 1 <=> the file has been written in little endian byte order
+  const bool swap_bytes = (one == 1) != HostIsLittleEndian();
+  if (one == 1) {
+    MshV4GrammarBinary<const char*> grammar(
+        qi::little_dword, qi::little_qword, qi::little_bin_double);
+    return ParseBinaryParallel(grammar, begin, end, swap_bytes, num_threads,
+                               result);
+  }
+  MshV4GrammarBinary<const char*> grammar(qi::big_dword, qi::big_qword,
+                                          qi::big_bin_double);
+  return ParseBinaryParallel(grammar, begin, end, swap_bytes, num_threads,
+                             result);
+}
 }  // namespace detail
 
 }  // namespace lf::io
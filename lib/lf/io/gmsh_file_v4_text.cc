@@ -298,10 +298,10 @@ struct MshV4GrammarText
 }  // namespace
 
 namespace detail {
-bool ParseGmshFileV4Text(std::string::const_iterator begin,
-                         std::string::const_iterator end, GMshFileV4* result) {
+bool ParseGmshFileV4Text(const char* begin, const char* end,
+                         GMshFileV4* result) {
   // Text file
-  MshV4GrammarText<std::string::const_iterator> grammar;
+  MshV4GrammarText<const char*> grammar;
   return qi::phrase_parse(begin, end, grammar, ascii::space, *result);
 }
 
@@ -6,6 +6,8 @@
 #include <boost/spirit/include/qi_string.hpp>
 #include "eigen_fusion_adapter.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <fstream>
 
 using size_type = lf::mesh::Mesh::size_type;
@@ -15,11 +17,36 @@ namespace lf::io {
 
 bool GmshReader::IsPhysicalEntity(const mesh::Entity& e,
                                   size_type physical_entity_nr) const {
-  auto physical_entities = PhysicalEntityNr(e);
+  auto physical_entities = PhysicalNrsOf(e);
   return std::find(physical_entities.begin(), physical_entities.end(),
                    physical_entity_nr) != physical_entities.end();
 }
 
+mesh::utils::CodimMeshDataSet<bool> GmshReader::PhysicalEntityFlags(
+    size_type physical_entity_nr, dim_t codim) const {
+  LF_ASSERT_MSG(codim < physical_nrs_.size(), "codim out of range");
+  mesh::utils::CodimMeshDataSet<bool> flags(mesh_, codim, false);
+  const PhysicalNrs& pn = physical_nrs_[codim];
+  size_type mi = 0;
+  for (size_type k = 0; k < pn.nrs.size(); ++k) {
+    if (pn.nrs[k] == physical_entity_nr) {
+      // find the entity the k-th number belongs to
+      while (pn.offsets[mi + 1] <= k) {
+        ++mi;
+      }
+      flags(*mesh_->EntityByIndex(codim, mi)) = true;
+    }
+  }
+  return flags;
+}
+
+nonstd::span<const size_type> GmshReader::PhysicalNrsOf(
+    const mesh::Entity& e) const {
+  const PhysicalNrs& pn = physical_nrs_[e.Codim()];
+  const size_type mi = mesh_->Index(e);
+  return {pn.nrs.data() + pn.offsets[mi], pn.nrs.data() + pn.offsets[mi + 1]};
+}
+
 GmshReader::GmshReader(std::unique_ptr<mesh::MeshFactory> factory,
                        const GmshFileVariant& msh_file)
     : mesh_factory_(std::move(factory)) {
@@ -27,8 +54,8 @@ GmshReader::GmshReader(std::unique_ptr<mesh::MeshFactory> factory,
 }
 
 GmshReader::GmshReader(std::unique_ptr<mesh::MeshFactory> factory,
-                       const std::string& filename)
-    : GmshReader(std::move(factory), ReadGmshFile(filename)) {}
+                       const std::string& filename, unsigned int num_threads)
+    : GmshReader(std::move(factory), ReadGmshFile(filename, num_threads)) {}
 
 size_type GmshReader::PhysicalEntityName2Nr(const std::string& name,
                                             dim_t codim) const {
@@ -112,7 +139,8 @@ std::vector<std::pair<size_type, std::string>> GmshReader::PhysicalEntities(
 
 std::vector<size_type> GmshReader::PhysicalEntityNr(
     const mesh::Entity& e) const {
-  return physical_nrs_->operator()(e);
+  auto physical_entities = PhysicalNrsOf(e);
+  return {physical_entities.begin(), physical_entities.end()};
 }
 
 void GmshReader::InitGmshFile(const GMshFileV2& msh_file) {
@@ -302,26 +330,23 @@ void GmshReader::InitGmshFile(const GMshFileV2& msh_file) {
 
   // 5) Build MeshDataSet that assigns the physical entitiies:
   //////////////////////////////////////////////////////////////////////////////
-  physical_nrs_ =
-      mesh::utils::make_AllCodimMeshDataSet<std::vector<size_type>>(mesh_);
-
+  physical_nrs_.resize(dim_mesh + 1);
   for (dim_t c = 0; c <= dim_mesh; ++c) {
-    for (auto e : mesh_->Entities(c)) {
-      auto mi = mesh_->Index(*e);
-      if (c == dim_mesh && mi >= mi2gi[dim_mesh].size()) {
-        // this point did not appear as a gmsh element in the file -> don't
-        // assign any physical entity nr.
-        continue;
-      }
-      if (mi2gi[c].size() > mi) {
-        std::vector<size_type> temp;
+    const size_type num_entities = mesh_->NumEntities(c);
+    PhysicalNrs& pn = physical_nrs_[c];
+    pn.offsets.resize(num_entities + 1);
+    pn.nrs.reserve(mi2gi[c].size());
+    for (size_type mi = 0; mi < num_entities; ++mi) {
+      pn.offsets[mi] = pn.nrs.size();
+      // entities (e.g. points) that did not appear as gmsh elements in the
+      // file don't get any physical entity nr.
+      if (mi < mi2gi[c].size()) {
         for (auto& gmsh_index : mi2gi[c][mi]) {
-          temp.push_back(msh_file.Elements[gmsh_index].PhysicalEntityNr);
+          pn.nrs.push_back(msh_file.Elements[gmsh_index].PhysicalEntityNr);
         }
-
-        physical_nrs_->operator()(*e) = std::move(temp);
       }
     }
+    pn.offsets[num_entities] = pn.nrs.size();
   }
 
   // 6) Create mapping physicalEntityNr <-> physicalEntityName:
@@ -594,29 +619,26 @@ void GmshReader::InitGmshFile(const GMshFileV4& msh_file) {
 
   // 6) Build MeshDataSet that assigns the physical entitiies:
   /////////////////////////////////////////////////////////////////////////////
-  physical_nrs_ =
-      mesh::utils::make_AllCodimMeshDataSet<std::vector<size_type>>(mesh_);
-
+  physical_nrs_.resize(dim_mesh + 1);
   for (dim_t c = 0; c <= dim_mesh; ++c) {
-    for (auto e : mesh_->Entities(c)) {
-      auto mi = mesh_->Index(*e);
-      if (c == dim_mesh && mi >= mi2gi[dim_mesh].size()) {
-        // this point did not appear as a gmsh element in the file -> don't
-        // assign any physical entity nr.
-        continue;
-      }
-      if (mi2gi[c].size() > mi) {
-        std::vector<size_type> temp;
+    const size_type num_entities = mesh_->NumEntities(c);
+    PhysicalNrs& pn = physical_nrs_[c];
+    pn.offsets.resize(num_entities + 1);
+    pn.nrs.reserve(mi2gi[c].size());
+    for (size_type mi = 0; mi < num_entities; ++mi) {
+      pn.offsets[mi] = pn.nrs.size();
+      // entities (e.g. points) that did not appear as gmsh elements in the
+      // file don't get any physical entity nr.
+      if (mi < mi2gi[c].size()) {
         for (auto& gmsh_index : mi2gi[c][mi]) {
           auto& element_block = msh_file.elements.element_blocks[gmsh_index];
           auto& physical_tags = gmei2gmphi[c][element_block.entity_tag];
-          temp.insert(std::end(temp), std::begin(physical_tags),
-                      std::end(physical_tags));
+          pn.nrs.insert(std::end(pn.nrs), std::begin(physical_tags),
+                        std::end(physical_tags));
         }
-
-        physical_nrs_->operator()(*e) = std::move(temp);
       }
     }
+    pn.offsets[num_entities] = pn.nrs.size();
   }
 
   // 7) Create mapping physicalEntityNr <-> physicalEntityName:
@@ -637,8 +659,10 @@ void GmshReader::InitGmshFile(const GMshFileV4& msh_file) {
   }
 }
 
-std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const std::string& filename) {
-  // Open file and copy it into memory:
+std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const std::string& filename,
+                                                  unsigned int num_threads) {
+  // Map the file into memory (read-only), the parsers work directly on the
+  // mapped pages:
   /////////////////////////////////////////////////////////////////////////////
   std::ifstream in(filename, std::ios_base::in | std::ios_base::binary);
   if (!in) {
@@ -646,17 +670,37 @@ std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const std::string& filename) {
     error += filename;
     throw lf::base::LfException(error);
   }
+  // Empty files cannot be mapped
+  in.seekg(0, std::ios_base::end);
+  LF_VERIFY_MSG(in.tellg() > 0, "Could not read header of file " << filename);
+  in.close();
+
+  namespace bip = boost::interprocess;
+  bip::file_mapping mapping;
+  bip::mapped_region region;
+  try {
+    mapping = bip::file_mapping(filename.c_str(), bip::read_only);
+    region = bip::mapped_region(mapping, bip::read_only);
+  } catch (const bip::interprocess_exception& e) {
+    throw lf::base::LfException("Could not map file " + filename + ": " +
+                                e.what());
+  }
+  // The file is parsed front to back exactly once
+  region.advise(bip::mapped_region::advice_sequential);
 
-  std::string storage;
-  in.unsetf(std::ios::skipws);  // no white space skipping
-  std::copy(std::istream_iterator<char>(in), std::istream_iterator<char>(),
-            std::back_inserter(storage));
+  const char* begin = static_cast<const char*>(region.get_address());
+  return ReadGmshFile(begin, begin + region.get_size(), filename,
+                      num_threads);
+}
 
+std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const char* begin,
+                                                  const char* end,
+                                                  const std::string& filename,
+                                                  unsigned int num_threads) {
   // Parse header to determine if we are dealing with ASCII format or binary
   // format + little or big endian:
   /////////////////////////////////////////////////////////////////////////////
-  auto iter = storage.cbegin();
-  auto end = storage.cend();
+  auto iter = begin;
 
   namespace qi = boost::spirit::qi;
   namespace ascii = boost::spirit::ascii;
@@ -681,7 +725,8 @@ std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const std::string& filename) {
 
   if (std::get<0>(header) == "4.1") {
     return ReadGmshFileV4(iter, end, std::get<0>(header), std::get<1>(header),
-                          std::get<2>(header), std::get<3>(header), filename);
+                          std::get<2>(header), std::get<3>(header), filename,
+                          num_threads);
   }
   if (std::get<0>(header) == "2.2") {
     return readGmshFileV2(iter, end, std::get<0>(header), std::get<1>(header),
@@ -14,6 +14,7 @@
 
 #ifndef __7fedf7cf1a0246a98b2bf431cfa34da2
 #define __7fedf7cf1a0246a98b2bf431cfa34da2
+#include <lf/base/parallel.h>
 #include <lf/mesh/mesh.h>
 #include <lf/mesh/utils/utils.h>
 #include <map>
@@ -147,6 +148,24 @@ class GmshReader {
   [[nodiscard]] bool IsPhysicalEntity(const mesh::Entity& e,
                                       size_type physical_entity_nr) const;
 
+  /**
+   * @brief Flag all entities of a codimension that belong to a Gmsh physical
+   * entity
+   * @param physical_entity_nr The number of the gmsh physical entity.
+   * @param codim The codimension of the entities to be flagged.
+   * @return A data set which is `true` exactly for the entities `e` of
+   * codimension `codim` for which `IsPhysicalEntity(e, physical_entity_nr)`
+   * holds.
+   *
+   * Use this instead of repeated calls of IsPhysicalEntity() if the same
+   * physical entity is queried for many entities, e.g. when selecting the
+   * degrees of freedom on a part of the boundary: The flags are built in one
+   * sweep over the stored physical entity numbers, afterwards every test
+   * takes constant time.
+   */
+  [[nodiscard]] mesh::utils::CodimMeshDataSet<bool> PhysicalEntityFlags(
+      size_type physical_entity_nr, dim_t codim) const;
+
   /**
    * @brief Create a new GmshReader from the given MshFile (advanced usage)
    * @param factory The mesh::MeshFactory that is used to construct the mesh.
@@ -161,6 +180,8 @@ class GmshReader {
    * @brief Create a new GmshReader by reading from the specified file.
    * @param factory The mesh::MeshFactory that is used to construct the mesh.
    * @param filename The filename of the `.msh` file that is read.
+   * @param num_threads number of threads used to decode binary files of
+   * version 4.1, cf. ReadGmshFile(const std::string&, unsigned int).
    *
    * @note If the `factory.DimWorld() == 3`, there must be at least one
    *       3D mesh element in the *.msh file. Similarly, if
@@ -169,7 +190,8 @@ class GmshReader {
    * @note GmshReader supports ASCII and Binary `.msh` files.
    */
   GmshReader(std::unique_ptr<mesh::MeshFactory> factory,
-             const std::string& filename);
+             const std::string& filename,
+             unsigned int num_threads = base::DefaultNumThreads());
 
  private:
   /// The underlying grid created by the grid factory.
@@ -177,9 +199,16 @@ class GmshReader {
 
   std::unique_ptr<mesh::MeshFactory> mesh_factory_;
 
-  /// The PhysicalEntityNr of every entity (0 if not set):
-  std::shared_ptr<mesh::utils::AllCodimMeshDataSet<std::vector<size_type>>>
-      physical_nrs_;
+  /// The PhysicalEntityNrs of all entities of one codimension in compressed
+  /// row storage: The numbers of the entity with index `i` are
+  /// `nrs[offsets[i]], ..., nrs[offsets[i+1]-1]`.
+  struct PhysicalNrs {
+    std::vector<size_type> offsets;
+    std::vector<size_type> nrs;
+  };
+
+  /// The PhysicalEntityNrs of every entity, indexed by codimension
+  std::vector<PhysicalNrs> physical_nrs_;
 
   /// Map from physicalEntity name -> nr, codim
   std::multimap<std::string, std::pair<size_type, dim_t>> name_2_nr_;
@@ -189,9 +218,43 @@ class GmshReader {
 
   void InitGmshFile(const GMshFileV2& msh_file);
   void InitGmshFile(const GMshFileV4& msh_file);
+
+  /// The PhysicalEntityNrs of the entity `e`, in the order read from the file
+  [[nodiscard]] nonstd::span<const size_type> PhysicalNrsOf(
+      const mesh::Entity& e) const;
 };
 
-std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const std::string& filename);
+/**
+ * @brief Read a `*.msh` file from disk (format version 2.2 or 4.1, text or
+ * binary) into an in-memory representation
+ *
+ * @param filename name of the file
+ * @param num_threads number of threads used to decode binary files of version
+ * 4.1, cf. ReadGmshFileV4(). Has no effect for other files.
+ * @return Either a GMshFileV2 or a GMshFileV4 object, depending on the version
+ * of the file
+ *
+ * The file is mapped into memory and parsed directly from the mapped pages,
+ * i.e. it is never copied as a whole. Thus the memory footprint is essentially
+ * that of the returned data structure.
+ */
+std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const std::string& filename,
+                                                  unsigned int num_threads = 1);
+
+/**
+ * @brief Parse the contents of a `*.msh` file which is already in memory
+ *
+ * @param begin pointer to the first character of the file contents
+ * @param end pointer past the last character of the file contents
+ * @param filename name of the file (for diagnostics only)
+ * @param num_threads number of threads used to decode binary files of version
+ * 4.1, cf. ReadGmshFileV4(). Has no effect for other files.
+ * @sa ReadGmshFile(const std::string&, unsigned int)
+ */
+std::variant<GMshFileV2, GMshFileV4> ReadGmshFile(const char* begin,
+                                                  const char* end,
+                                                  const std::string& filename,
+                                                  unsigned int num_threads = 1);
 
 }  // namespace lf::io
 
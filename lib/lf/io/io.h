@@ -17,8 +17,11 @@
 
 #include "gmsh_reader.h"
 #include "vtk_writer.h"
+#include "vtu_time_series_writer.h"
+#include "vtu_writer.h"
 #include "write_matlab.h"
 #include "write_matplotlib.h"
+#include "xdmf_time_series_writer.h"
 #include "write_tikz.h"
 
 /**
@@ -524,6 +524,17 @@ TEST(lf_io_gmsh_file_v4, readPieceOfCakeBinary) {
   checkPieceOfCake(filev4);
 }
 
+TEST(lf_io_gmsh_file_v4, readPieceOfCakeBinaryParallel) {
+  auto filename = test_utils::getMeshPath("piece_of_cake_binary.msh");
+  for (unsigned int num_threads : {2, 3, 16}) {
+    auto mshfile = ReadGmshFile(filename, num_threads);
+    EXPECT_TRUE(std::holds_alternative<GMshFileV4>(mshfile));
+    auto filev4 = std::get<GMshFileV4>(mshfile);
+    EXPECT_TRUE(filev4.is_binary);
+    checkPieceOfCake(filev4);
+  }
+}
+
 TEST(lf_io_gmsh_file_v4, readTwoElementHybrid2d) {
   auto filename = test_utils::getMeshPath("two_element_hybrid_2d_v4.msh");
   auto mshfile = ReadGmshFile(filename);
@@ -543,4 +554,16 @@ TEST(lf_io_gmsh_file_v4, readTwoElementHybrid2dBinary) {
   checkTwoElementHybrid(filev4);
 }
 
+TEST(lf_io_gmsh_file_v4, readTwoElementHybrid2dBinaryParallel) {
+  auto filename =
+      test_utils::getMeshPath("two_element_hybrid_2d_v4_binary.msh");
+  for (unsigned int num_threads : {2, 4}) {
+    auto mshfile = ReadGmshFile(filename, num_threads);
+    EXPECT_TRUE(std::holds_alternative<GMshFileV4>(mshfile));
+    auto filev4 = std::get<GMshFileV4>(mshfile);
+    EXPECT_TRUE(filev4.is_binary);
+    checkTwoElementHybrid(filev4);
+  }
+}
+
 }  // namespace lf::io::test
@@ -128,6 +128,17 @@ void checkTwoElementMesh(const GmshReader& reader) {
             pe0.end());
   EXPECT_NE(std::find(pe0.begin(), pe0.end(), pe_t{5, "square"}), pe0.end());
 
+  // The flags of a physical entity agree with IsPhysicalEntity()
+  for (base::dim_t codim = 0; codim <= 2; ++codim) {
+    for (const auto& [nr, name] : reader.PhysicalEntities(codim)) {
+      auto flags = reader.PhysicalEntityFlags(nr, codim);
+      for (auto e : mesh->Entities(codim)) {
+        EXPECT_EQ(flags(*e), reader.IsPhysicalEntity(*e, nr)) << name;
+      }
+    }
+  }
+  EXPECT_FALSE(reader.PhysicalEntityFlags(1, 1)(**diagonal_edge));
+
   for (auto e : entities0) {
     mesh::test_utils::checkGeometryOrientation(*e);
     mesh::test_utils::checkLocalTopology(*e);
@@ -157,6 +168,12 @@ TEST(lf_io, readTwoElementMesh) {
   checkTwoElementMesh(GmshReader(
       std::make_unique<mesh::hybrid2d::MeshFactory>(2),
       test_utils::getMeshPath("two_element_hybrid_2d_v4_binary.msh")));
+  for (const unsigned int num_threads : {1U, 4U}) {
+    checkTwoElementMesh(GmshReader(
+        std::make_unique<mesh::hybrid2d::MeshFactory>(2),
+        test_utils::getMeshPath("two_element_hybrid_2d_v4_binary.msh"),
+        num_threads));
+  }
 
   // Make sure, that we can read a second order mesh:
   auto reader =
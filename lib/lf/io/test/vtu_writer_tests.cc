@@ -0,0 +1,273 @@
+/**
+ * @file
+ * @brief Test the streaming vtu writer
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+#include <lf/io/io.h>
+#include <lf/mesh/hybrid2d/hybrid2d.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/mesh/utils/utils.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#ifdef LF_ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace lf::io::test {
+
+std::string ReadFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+// Value of the XML attribute `attribute` of the DataArray called `name`
+std::string DataArrayAttribute(const std::string& vtu, const std::string& name,
+                               const std::string& attribute) {
+  const auto name_pos = vtu.find("Name=\"" + name + "\"");
+  EXPECT_NE(name_pos, std::string::npos) << "no array " << name;
+  const auto begin = vtu.rfind("<DataArray", name_pos);
+  const auto end = vtu.find("/>", name_pos);
+  const auto value_pos = vtu.find(attribute + "=\"", begin);
+  EXPECT_LT(value_pos, end);
+  const auto value_begin = value_pos + attribute.size() + 2;
+  return vtu.substr(value_begin, vtu.find('"', value_begin) - value_begin);
+}
+
+// Decode the appended data of the DataArray called `name`
+template <class T>
+std::vector<T> ReadDataArray(const std::string& vtu, const std::string& name) {
+  const auto appended = vtu.find('_', vtu.find("<AppendedData")) + 1;
+  const char* block = vtu.data() + appended +
+                      std::stoull(DataArrayAttribute(vtu, name, "offset"));
+  auto read_uint64 = [&](std::size_t i) {
+    std::uint64_t value;
+    std::memcpy(&value, block + i * sizeof(std::uint64_t), sizeof(value));
+    return value;
+  };
+
+  std::vector<T> result;
+  if (vtu.find("compressor=\"vtkZLibDataCompressor\"") == std::string::npos) {
+    result.resize(read_uint64(0) / sizeof(T));
+    std::memcpy(result.data(), block + sizeof(std::uint64_t),
+                result.size() * sizeof(T));
+  } else {
+#ifdef LF_ENABLE_ZLIB
+    const std::uint64_t num_blocks = read_uint64(0);
+    const std::uint64_t block_size = read_uint64(1);
+    const std::uint64_t last_size = read_uint64(2);
+    const std::uint64_t num_bytes =
+        num_blocks == 0 ? 0
+                        : (num_blocks - 1) * block_size +
+                              (last_size == 0 ? block_size : last_size);
+    result.resize(num_bytes / sizeof(T));
+    auto* out = reinterpret_cast<Bytef*>(result.data());
+    const auto* in = reinterpret_cast<const Bytef*>(
+        block + (3 + num_blocks) * sizeof(std::uint64_t));
+    for (std::uint64_t b = 0; b < num_blocks; ++b) {
+      uLongf length = std::min(block_size, num_bytes - b * block_size);
+      EXPECT_EQ(uncompress(out, &length, in, read_uint64(3 + b)), Z_OK);
+      out += length;
+      in += read_uint64(3 + b);
+    }
+#else
+    ADD_FAILURE() << "cannot decompress without zlib";
+#endif
+  }
+  return result;
+}
+
+void WriteTestFile(const std::shared_ptr<const mesh::Mesh>& mesh,
+                   const std::string& filename, VtuWriterOptions options) {
+  VtuWriter writer(mesh, filename, 0, options);
+
+  mesh::utils::CodimMeshDataSet<double> node_values(mesh, 2);
+  for (const mesh::Entity* p : mesh->Entities(2)) {
+    node_values(*p) = 0.5 * mesh->Index(*p);
+  }
+  writer.WritePointData("node_values", node_values);
+
+  // only defined on triangles
+  writer.WriteCellData(
+      "tria_index",
+      *mesh::utils::make_LambdaMeshDataSet(
+          [&](const mesh::Entity& e) { return int(mesh->Index(e)); },
+          [](const mesh::Entity& e) {
+            return e.RefEl() == base::RefEl::kTria();
+          }),
+      -1);
+
+  writer.WriteCellData("barycenter",
+                       mesh::utils::MeshFunctionGlobal(
+                           [](const Eigen::Vector2d& x) { return x; }));
+  writer.WritePointData(
+      "x", mesh::utils::MeshFunctionGlobal(
+               [](const Eigen::Vector2d& x) -> double { return x[0]; }));
+}
+
+void CheckTestFile(const std::shared_ptr<const mesh::Mesh>& mesh,
+                   const std::string& filename, bool double_precision) {
+  const std::string vtu = ReadFile(filename);
+  // the temporary data file has been removed
+  EXPECT_FALSE(std::ifstream(filename + ".appended").is_open());
+  EXPECT_NE(vtu.find("NumberOfPoints=\"" +
+                     std::to_string(mesh->NumEntities(2)) + "\""),
+            std::string::npos);
+  EXPECT_NE(vtu.find("NumberOfCells=\"" +
+                     std::to_string(mesh->NumEntities(0)) + "\""),
+            std::string::npos);
+  const std::string real_type = double_precision ? "Float64" : "Float32";
+  EXPECT_EQ(DataArrayAttribute(vtu, "Points", "type"), real_type);
+  EXPECT_EQ(DataArrayAttribute(vtu, "node_values", "type"), real_type);
+  EXPECT_EQ(DataArrayAttribute(vtu, "tria_index", "type"), "Int32");
+  EXPECT_EQ(DataArrayAttribute(vtu, "barycenter", "NumberOfComponents"), "3");
+
+  auto check_reals = [&](const auto& dummy) {
+    using real_t = std::decay_t<decltype(dummy)>;
+    const real_t tol = double_precision ? 1e-14 : 1e-6;
+    const auto points = ReadDataArray<real_t>(vtu, "Points");
+    const auto node_values = ReadDataArray<real_t>(vtu, "node_values");
+    const auto x = ReadDataArray<real_t>(vtu, "x");
+    ASSERT_EQ(points.size(), 3 * mesh->NumEntities(2));
+    for (const mesh::Entity* p : mesh->Entities(2)) {
+      const auto i = mesh->Index(*p);
+      const Eigen::Vector2d coords =
+          p->Geometry()->Global(Eigen::Matrix<double, 0, 1>());
+      EXPECT_NEAR(points[3 * i], coords[0], tol);
+      EXPECT_NEAR(points[3 * i + 1], coords[1], tol);
+      EXPECT_EQ(points[3 * i + 2], 0);
+      EXPECT_EQ(node_values[i], real_t(0.5 * i));
+      EXPECT_NEAR(x[i], coords[0], tol);
+    }
+    const auto barycenter = ReadDataArray<real_t>(vtu, "barycenter");
+    for (const mesh::Entity* e : mesh->Entities(0)) {
+      const auto i = mesh->Index(*e);
+      const Eigen::Vector2d center = e->Geometry()->Global(
+          e->RefEl().NodeCoords().rowwise().mean());
+      EXPECT_NEAR(barycenter[3 * i], center[0], tol);
+      EXPECT_NEAR(barycenter[3 * i + 1], center[1], tol);
+    }
+  };
+  if (double_precision) {
+    check_reals(double());
+  } else {
+    check_reals(float());
+  }
+
+  const auto tria_index = ReadDataArray<int>(vtu, "tria_index");
+  const auto connectivity = ReadDataArray<std::int64_t>(vtu, "connectivity");
+  const auto offsets = ReadDataArray<std::int64_t>(vtu, "offsets");
+  const auto types = ReadDataArray<std::uint8_t>(vtu, "types");
+  ASSERT_EQ(offsets.size(), mesh->NumEntities(0));
+  for (const mesh::Entity* e : mesh->Entities(0)) {
+    const auto i = mesh->Index(*e);
+    const bool is_tria = e->RefEl() == base::RefEl::kTria();
+    EXPECT_EQ(tria_index[i], is_tria ? int(i) : -1);
+    EXPECT_EQ(types[i], is_tria ? 5 : 9);
+    std::int64_t offset = offsets[i] - e->RefEl().NumNodes();
+    for (const mesh::Entity* p : e->SubEntities(2)) {
+      EXPECT_EQ(connectivity[offset++], mesh->Index(*p));
+    }
+  }
+}
+
+TEST(lf_io_VtuWriter, uncompressed) {
+  auto mesh = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  WriteTestFile(mesh, "vtu_writer_float.vtu", {});
+  CheckTestFile(mesh, "vtu_writer_float.vtu", false);
+
+  VtuWriterOptions options;
+  options.double_precision = true;
+  WriteTestFile(mesh, "vtu_writer_double.vtu", options);
+  CheckTestFile(mesh, "vtu_writer_double.vtu", true);
+}
+
+TEST(lf_io_VtuWriter, compressed) {
+  auto mesh = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  VtuWriterOptions options;
+  options.compress = true;
+  options.double_precision = true;
+#ifdef LF_ENABLE_ZLIB
+  WriteTestFile(mesh, "vtu_writer_compressed.vtu", options);
+  CheckTestFile(mesh, "vtu_writer_compressed.vtu", true);
+
+  // arrays that span several compression blocks
+  auto factory = std::make_unique<mesh::hybrid2d::MeshFactory>(2);
+  mesh::hybrid2d::TPTriagMeshBuilder builder(std::move(factory));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(50)
+      .setNumYCells(50);
+  std::shared_ptr<const mesh::Mesh> fine_mesh = builder.Build();
+  {
+    VtuWriter writer(fine_mesh, "vtu_writer_blocks.vtu", 0, options);
+    writer.WriteCellData(
+        "index", *mesh::utils::make_LambdaMeshDataSet(
+                     [&](const mesh::Entity& e) -> Eigen::Vector3d {
+                       return Eigen::Vector3d::Constant(fine_mesh->Index(e));
+                     }));
+  }
+  const auto index =
+      ReadDataArray<double>(ReadFile("vtu_writer_blocks.vtu"), "index");
+  ASSERT_EQ(index.size(), 3 * fine_mesh->NumEntities(0));
+  for (std::size_t i = 0; i < index.size(); ++i) {
+    EXPECT_EQ(index[i], i / 3);
+  }
+#else
+  EXPECT_THROW(VtuWriter(mesh, "vtu_writer_compressed.vtu", 0, options),
+               base::LfException);
+#endif
+}
+
+TEST(lf_io_VtuWriter, attributeNames) {
+  auto mesh = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  VtuWriter writer(mesh, "vtu_writer_names.vtu");
+  mesh::utils::CodimMeshDataSet<double> values(mesh, 2, 1.0);
+  writer.WritePointData("values", values);
+  EXPECT_THROW(writer.WritePointData("values", values), base::LfException);
+  EXPECT_THROW(writer.WritePointData("my values", values), base::LfException);
+  EXPECT_THROW(writer.WritePointData("<values>", values), base::LfException);
+  // point and cell data have separate name spaces
+  writer.WriteCellData(
+      "values", mesh::utils::CodimMeshDataSet<float>(mesh, 0, 2.0F));
+  writer.Close();
+  EXPECT_EQ(ReadDataArray<float>(ReadFile("vtu_writer_names.vtu"), "values")
+                .size(),
+            mesh->NumEntities(2));
+}
+
+TEST(lf_io_VtuWriter, timeSeries) {
+  auto mesh = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  const unsigned num_steps = 3;
+  {
+    VtuTimeSeriesWriter writer(mesh, "vtu_time_series");
+    for (unsigned step = 0; step < num_steps; ++step) {
+      writer.AddTimeStep(0.5 * step)
+          .WritePointData("u", mesh::utils::CodimMeshDataSet<int>(
+                                   mesh, 2, static_cast<int>(step)));
+    }
+  }
+  const std::string pvd = ReadFile("vtu_time_series.pvd");
+  EXPECT_NE(pvd.find("type=\"Collection\""), std::string::npos);
+  EXPECT_NE(pvd.find("timestep=\"0.5\""), std::string::npos);
+
+  const std::string reference = ReadFile("vtu_time_series_0.vtu");
+  for (unsigned step = 0; step < num_steps; ++step) {
+    const std::string file = "vtu_time_series_" + std::to_string(step) + ".vtu";
+    EXPECT_NE(pvd.find("file=\"" + file + "\""), std::string::npos);
+    const std::string vtu = ReadFile(file);
+    // every step contains the same geometry
+    EXPECT_EQ(ReadDataArray<float>(vtu, "Points"),
+              ReadDataArray<float>(reference, "Points"));
+    EXPECT_EQ(ReadDataArray<std::int64_t>(vtu, "connectivity"),
+              ReadDataArray<std::int64_t>(reference, "connectivity"));
+    EXPECT_EQ(ReadDataArray<int>(vtu, "u"),
+              std::vector<int>(mesh->NumEntities(2), step));
+  }
+}
+
+}  // namespace lf::io::test
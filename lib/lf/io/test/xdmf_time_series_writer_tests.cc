@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @brief Test the XDMF time series writer
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+#include <lf/io/io.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/mesh/utils/utils.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace lf::io::test {
+
+namespace {
+
+std::string ReadXdmfFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+// Value of the XML attribute `attribute` of the first DataItem behind `tag`
+std::string DataItemAttribute(const std::string& xmf, const std::string& tag,
+                              const std::string& attribute) {
+  const auto tag_pos = xmf.find(tag);
+  EXPECT_NE(tag_pos, std::string::npos) << "no tag " << tag;
+  const auto item = xmf.find("<DataItem", tag_pos);
+  const auto value_begin = xmf.find(attribute + "=\"", item) +
+                           attribute.size() + 2;
+  return xmf.substr(value_begin, xmf.find('"', value_begin) - value_begin);
+}
+
+// Read `count` values of type T at the Seek position of the DataItem
+template <class T>
+std::vector<T> ReadHeavyData(const std::string& xmf, const std::string& tag,
+                             const std::string& heavy, std::size_t count) {
+  const std::size_t seek =
+      std::stoull(DataItemAttribute(xmf, tag, "Seek"));
+  EXPECT_LE(seek + count * sizeof(T), heavy.size());
+  std::vector<T> result(count);
+  std::memcpy(result.data(), heavy.data() + seek, count * sizeof(T));
+  return result;
+}
+
+}  // namespace
+
+TEST(lf_io_XdmfTimeSeriesWriter, geometryWrittenOnce) {
+  auto mesh = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  const unsigned num_steps = 3;
+  {
+    XdmfTimeSeriesWriter writer(mesh, "xdmf_time_series");
+    for (unsigned step = 0; step < num_steps; ++step) {
+      writer.AddTimeStep(0.5 * step);
+      writer.WritePointData("u", mesh::utils::CodimMeshDataSet<int>(
+                                     mesh, 2, static_cast<int>(step)));
+      writer.WriteCellData("barycenter",
+                           mesh::utils::MeshFunctionGlobal(
+                               [](const Eigen::Vector2d& x) { return x; }));
+    }
+    EXPECT_THROW(writer.WritePointData("u", mesh::utils::CodimMeshDataSet<int>(
+                                                mesh, 2, 0)),
+                 base::LfException);
+  }
+  const std::string xmf = ReadXdmfFile("xdmf_time_series.xmf");
+  EXPECT_NE(xmf.find("CollectionType=\"Temporal\""), std::string::npos);
+  EXPECT_NE(xmf.find("<Time Value=\"0.5\"/>"), std::string::npos);
+  EXPECT_EQ(DataItemAttribute(xmf, "<Geometry", "Precision"), "4");
+  EXPECT_EQ(DataItemAttribute(xmf, "Name=\"u\"", "NumberType"), "Int");
+  EXPECT_EQ(DataItemAttribute(xmf, "Name=\"barycenter\"", "Dimensions"),
+            std::to_string(mesh->NumEntities(0)) + " 3");
+
+  // points and cells
+  const std::string heavy_mesh = ReadXdmfFile("xdmf_time_series_mesh.bin");
+  const auto num_points = mesh->NumEntities(2);
+  const auto points =
+      ReadHeavyData<float>(xmf, "<Geometry", heavy_mesh, 3 * num_points);
+  for (const mesh::Entity* p : mesh->Entities(2)) {
+    const auto i = mesh->Index(*p);
+    const Eigen::Vector2d coords =
+        p->Geometry()->Global(Eigen::Matrix<double, 0, 1>());
+    EXPECT_NEAR(points[3 * i], coords[0], 1e-6);
+    EXPECT_NEAR(points[3 * i + 1], coords[1], 1e-6);
+    EXPECT_EQ(points[3 * i + 2], 0.0F);
+  }
+  const std::size_t topology_size =
+      std::stoull(DataItemAttribute(xmf, "<Topology", "Dimensions"));
+  const auto topology = ReadHeavyData<std::int64_t>(xmf, "<Topology",
+                                                    heavy_mesh, topology_size);
+  std::size_t pos = 0;
+  for (base::glb_idx_t i = 0; i < mesh->NumEntities(0); ++i) {
+    const mesh::Entity* e = mesh->EntityByIndex(0, i);
+    const bool is_tria = e->RefEl() == base::RefEl::kTria();
+    ASSERT_LT(pos, topology.size());
+    EXPECT_EQ(topology[pos++], is_tria ? 4 : 5);
+    for (const mesh::Entity* p : e->SubEntities(2)) {
+      EXPECT_EQ(topology[pos++], mesh->Index(*p));
+    }
+  }
+  EXPECT_EQ(pos, topology.size());
+  EXPECT_EQ(heavy_mesh.size(),
+            3 * num_points * sizeof(float) + topology_size * sizeof(int64_t));
+
+  // the step files contain the fields only and all steps refer to the geometry
+  // in the same file
+  std::size_t num_mesh_refs = 0;
+  for (auto p = xmf.find(">xdmf_time_series_mesh.bin<"); p != std::string::npos;
+       p = xmf.find(">xdmf_time_series_mesh.bin<", p + 1)) {
+    ++num_mesh_refs;
+  }
+  EXPECT_EQ(num_mesh_refs, 2 * num_steps);
+  for (unsigned step = 0; step < num_steps; ++step) {
+    const std::string file =
+        "xdmf_time_series_" + std::to_string(step) + ".bin";
+    const auto grid = xmf.find("<Grid Name=\"step_" + std::to_string(step));
+    ASSERT_NE(grid, std::string::npos);
+    const std::string step_xmf = xmf.substr(grid);
+    EXPECT_NE(step_xmf.find(">" + file + "<"), std::string::npos);
+    const std::string heavy = ReadXdmfFile(file);
+    EXPECT_EQ(heavy.size(), num_points * sizeof(int) +
+                                3 * mesh->NumEntities(0) * sizeof(float));
+    EXPECT_EQ(ReadHeavyData<int>(step_xmf, "Name=\"u\"", heavy, num_points),
+              std::vector<int>(num_points, step));
+    const auto barycenter = ReadHeavyData<float>(
+        step_xmf, "Name=\"barycenter\"", heavy, 3 * mesh->NumEntities(0));
+    for (const mesh::Entity* e : mesh->Entities(0)) {
+      const auto i = mesh->Index(*e);
+      const Eigen::Vector2d center = e->Geometry()->Global(
+          e->RefEl().NodeCoords().rowwise().mean());
+      EXPECT_NEAR(barycenter[3 * i], center[0], 1e-6);
+      EXPECT_NEAR(barycenter[3 * i + 1], center[1], 1e-6);
+    }
+  }
+}
+
+TEST(lf_io_XdmfTimeSeriesWriterDeathTest, dataBeforeTimeStep) {
+  auto mesh = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  XdmfTimeSeriesWriter writer(mesh, "xdmf_no_step", 1, true);
+  EXPECT_DEATH(
+      writer.WriteCellData("c", mesh::utils::CodimMeshDataSet<double>(mesh, 1,
+                                                                       1.0)),
+      "AddTimeStep");
+}
+
+}  // namespace lf::io::test
@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief Implementation of the VtuTimeSeriesWriter
+ * @copyright MIT License
+ */
+
+#include "vtu_time_series_writer.h"
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace lf::io {
+
+VtuTimeSeriesWriter::VtuTimeSeriesWriter(std::shared_ptr<const mesh::Mesh> mesh,
+                                         std::string basename, dim_t codim,
+                                         VtuWriterOptions options)
+    : geometry_(
+          std::make_shared<const VtuGeometry>(std::move(mesh), codim, options)),
+      basename_(std::move(basename)) {}
+
+VtuWriter& VtuTimeSeriesWriter::AddTimeStep(double time) {
+  LF_VERIFY_MSG(!closed_,
+                "VtuTimeSeriesWriter::Close() has already been called.");
+  step_writer_.reset();
+  const std::string filename =
+      basename_ + "_" + std::to_string(steps_.size()) + ".vtu";
+  step_writer_ = std::make_unique<VtuWriter>(geometry_, filename);
+  // the .pvd file lies in the same directory as the step files
+  steps_.emplace_back(time, filename.substr(filename.find_last_of("/\\") + 1));
+  return *step_writer_;
+}
+
+void VtuTimeSeriesWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  step_writer_.reset();
+
+  const std::string filename = basename_ + ".pvd";
+  std::ofstream file(filename, std::ios_base::out | std::ios_base::trunc);
+  if (!file.is_open()) {
+    throw base::LfException("Could not open file " + filename +
+                            " for writing.");
+  }
+  file << std::setprecision(std::numeric_limits<double>::max_digits10)
+       << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"Collection\" version=\"0.1\">\n"
+       << "  <Collection>\n";
+  for (const auto& [time, step_file] : steps_) {
+    file << "    <DataSet timestep=\"" << time
+         << "\" group=\"\" part=\"0\" file=\"" << step_file << "\"/>\n";
+  }
+  file << "  </Collection>\n"
+       << "</VTKFile>\n";
+  if (!file) {
+    throw base::LfException("Error while writing file " + filename);
+  }
+}
+
+}  // namespace lf::io
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief Declares the VtuTimeSeriesWriter which writes a sequence of vtu files
+ *        on a fixed mesh together with a ParaView collection (`*.pvd`)
+ * @copyright MIT License
+ */
+
+#ifndef __7d2f0b94e61c4a38a5c9e3b18f640d27
+#define __7d2f0b94e61c4a38a5c9e3b18f640d27
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "vtu_writer.h"
+
+namespace lf::io {
+
+/**
+ * @brief Write the fields of a time dependent simulation on a fixed mesh into
+ *        one vtu file per time step, collected in a ParaView data file
+ *        `<basename>.pvd`.
+ *
+ * The points and cells of the mesh are converted (and compressed) only once
+ * when the VtuTimeSeriesWriter is constructed, see VtuGeometry. For every time
+ * step only the field arrays passed to the VtuWriter returned by
+ * AddTimeStep() have to be converted. The vtu format has no means to refer to
+ * the geometry in another file, hence the encoded geometry is still copied
+ * into every step file. Use the XdmfTimeSeriesWriter to write the geometry
+ * only once.
+ *
+ * #### Sample usage
+ * @code
+ * lf::io::VtuTimeSeriesWriter writer(mesh_p, "solution");
+ * for (int step = 0; step < num_steps; ++step) {
+ *   // ... compute the solution at time t ...
+ *   writer.AddTimeStep(t).WritePointData("u", mf_u);
+ * }
+ * // the destructor writes solution.pvd, which can be opened with ParaView
+ * @endcode
+ */
+class VtuTimeSeriesWriter {
+ public:
+  using dim_t = base::dim_t;
+
+  VtuTimeSeriesWriter(const VtuTimeSeriesWriter&) = delete;
+  VtuTimeSeriesWriter(VtuTimeSeriesWriter&&) = delete;
+  VtuTimeSeriesWriter& operator=(const VtuTimeSeriesWriter&) = delete;
+  VtuTimeSeriesWriter& operator=(VtuTimeSeriesWriter&&) = delete;
+
+  /**
+   * @brief Encode the geometry of the mesh for all time steps.
+   * @param mesh The mesh on which all fields are defined.
+   * @param basename The collection is written to `<basename>.pvd`, the time
+   *                 steps to `<basename>_<step>.vtu`.
+   * @param codim (Optional) the codimension of the cells, see VtuWriter.
+   * @param options (Optional) precision and compression of the binary data.
+   */
+  VtuTimeSeriesWriter(std::shared_ptr<const mesh::Mesh> mesh,
+                      std::string basename, dim_t codim = 0,
+                      VtuWriterOptions options = {});
+
+  /**
+   * @brief Close the file of the previous time step and start a new one.
+   * @param time The time associated with the new step in the collection.
+   * @return The writer for the fields of the new time step, it remains valid
+   *         until the next call of AddTimeStep() or Close().
+   */
+  VtuWriter& AddTimeStep(double time);
+
+  /**
+   * @brief Close the file of the last time step and write the `.pvd` file.
+   *
+   * Calling Close() again has no effect.
+   */
+  void Close();
+
+  ~VtuTimeSeriesWriter() { Close(); }
+
+ private:
+  std::shared_ptr<const VtuGeometry> geometry_;
+  std::string basename_;
+  std::unique_ptr<VtuWriter> step_writer_;
+  /// time and file name (relative to the .pvd file) of every step
+  std::vector<std::pair<double, std::string>> steps_;
+  bool closed_ = false;
+};
+
+}  // namespace lf::io
+
+#endif  // __7d2f0b94e61c4a38a5c9e3b18f640d27
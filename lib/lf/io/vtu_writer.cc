@@ -0,0 +1,326 @@
+/**
+ * @file
+ * @brief Implementation of the VtuWriter
+ * @copyright MIT License
+ */
+
+#include "vtu_writer.h"
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#ifdef LF_ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace lf::io {
+
+namespace {
+
+// Cell types of the VTK file format
+constexpr std::uint8_t kVtkVertex = 1;
+constexpr std::uint8_t kVtkLine = 3;
+constexpr std::uint8_t kVtkTriangle = 5;
+constexpr std::uint8_t kVtkQuad = 9;
+
+// Size of the blocks that are compressed independently (same as the default
+// of vtkZLibDataCompressor)
+constexpr std::uint64_t kCompressionBlockSize = 1 << 15;
+
+std::uint8_t VtkCellType(base::RefEl ref_el) {
+  switch (ref_el) {
+    case base::RefEl::kPoint():
+      return kVtkVertex;
+    case base::RefEl::kSegment():
+      return kVtkLine;
+    case base::RefEl::kTria():
+      return kVtkTriangle;
+    case base::RefEl::kQuad():
+      return kVtkQuad;
+    default:
+      throw base::LfException("VtuWriter does not support cells of type " +
+                              ref_el.ToString());
+  }
+}
+
+void WriteUInt64(std::ostream& out, const std::uint64_t* values,
+                 std::size_t count) {
+  out.write(reinterpret_cast<const char*>(values),
+            static_cast<std::streamsize>(count * sizeof(std::uint64_t)));
+}
+
+// Writes the block [size][data] and returns the number of bytes written
+std::uint64_t WriteRawBlock(std::ostream& out, const void* data,
+                            std::uint64_t num_bytes) {
+  WriteUInt64(out, &num_bytes, 1);
+  out.write(static_cast<const char*>(data),
+            static_cast<std::streamsize>(num_bytes));
+  return sizeof(std::uint64_t) + num_bytes;
+}
+
+// Writes the data in the layout of vtkZLibDataCompressor:
+// [#blocks][block size][size of last block][compressed sizes][blocks]
+std::uint64_t WriteCompressedBlock(std::ostream& out, const void* data,
+                                   std::uint64_t num_bytes) {
+#ifdef LF_ENABLE_ZLIB
+  const std::uint64_t num_blocks =
+      (num_bytes + kCompressionBlockSize - 1) / kCompressionBlockSize;
+  std::vector<std::uint64_t> header(3 + num_blocks);
+  header[0] = num_blocks;
+  header[1] = kCompressionBlockSize;
+  header[2] = num_bytes % kCompressionBlockSize;
+
+  std::vector<Bytef> compressed;
+  const auto* source = static_cast<const Bytef*>(data);
+  for (std::uint64_t b = 0; b < num_blocks; ++b) {
+    const std::uint64_t begin = b * kCompressionBlockSize;
+    const auto length = static_cast<uLong>(
+        std::min(kCompressionBlockSize, num_bytes - begin));
+    const std::size_t position = compressed.size();
+    uLongf compressed_length = compressBound(length);
+    compressed.resize(position + compressed_length);
+    if (compress2(compressed.data() + position, &compressed_length,
+                  source + begin, length, Z_DEFAULT_COMPRESSION) != Z_OK) {
+      throw base::LfException("zlib compression of vtu data failed.");
+    }
+    compressed.resize(position + compressed_length);
+    header[3 + b] = compressed_length;
+  }
+  WriteUInt64(out, header.data(), header.size());
+  out.write(reinterpret_cast<const char*>(compressed.data()),
+            static_cast<std::streamsize>(compressed.size()));
+  return header.size() * sizeof(std::uint64_t) + compressed.size();
+#else
+  (void)out;
+  (void)data;
+  (void)num_bytes;
+  throw base::LfException(
+      "LehrFEM++ was built without zlib (LF_ENABLE_ZLIB=OFF), the VtuWriter "
+      "cannot compress data.");
+#endif
+}
+
+}  // namespace
+
+namespace internal {
+
+std::uint64_t WriteVtuBlock(std::ostream& out, bool compress, const void* data,
+                            std::uint64_t num_bytes) {
+  return compress ? WriteCompressedBlock(out, data, num_bytes)
+                  : WriteRawBlock(out, data, num_bytes);
+}
+
+bool IsLittleEndian() {
+  const std::uint16_t one = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+std::vector<Eigen::MatrixXd> ReferenceBarycenters() {
+  std::vector<Eigen::MatrixXd> barycenters(5);
+  for (auto ref_el : {base::RefEl::kPoint(), base::RefEl::kSegment(),
+                      base::RefEl::kTria(), base::RefEl::kQuad()}) {
+    barycenters[ref_el.Id()] = ref_el.NodeCoords().rowwise().mean();
+  }
+  return barycenters;
+}
+
+}  // namespace internal
+
+VtuGeometry::VtuGeometry(std::shared_ptr<const mesh::Mesh> mesh, dim_t codim,
+                         VtuWriterOptions options)
+    : mesh_(std::move(mesh)), codim_(codim), options_(options) {
+  LF_ASSERT_MSG(codim_ <= mesh_->DimMesh(),
+                "codim = " << codim_ << " exceeds the dimension of the mesh");
+#ifndef LF_ENABLE_ZLIB
+  if (options_.compress) {
+    throw base::LfException(
+        "LehrFEM++ was built without zlib (LF_ENABLE_ZLIB=OFF), the VtuWriter "
+        "cannot compress data.");
+  }
+#endif
+  std::ostringstream data;
+  auto append = [&](const char* name, const char* type, int num_components,
+                    const auto& values) {
+    using value_t = typename std::decay_t<decltype(values)>::value_type;
+    arrays_.push_back({name, type, num_components,
+                       static_cast<std::uint64_t>(data.tellp())});
+    internal::WriteVtuBlock(data, options_.compress, values.data(),
+                            values.size() * sizeof(value_t));
+  };
+
+  // point coordinates, always with three components
+  const dim_t dim_mesh = mesh_->DimMesh();
+  const dim_t dim_world = mesh_->DimWorld();
+  const Eigen::Matrix<double, 0, 1> origin{};
+  auto coordinates = [&](const mesh::Entity& p) -> Eigen::Vector3d {
+    Eigen::Vector3d x = Eigen::Vector3d::Zero();
+    x.head(dim_world) = p.Geometry()->Global(origin);
+    return x;
+  };
+  if (options_.double_precision) {
+    append("Points", internal::VtkTypeName<double>(), 3,
+           internal::SampleEntities<double, 3>(*mesh_, dim_mesh, coordinates));
+  } else {
+    append("Points", internal::VtkTypeName<float>(), 3,
+           internal::SampleEntities<float, 3>(*mesh_, dim_mesh, coordinates));
+  }
+
+  // cells: node indices, end of every cell in the connectivity and cell types
+  const base::size_type num_cells = mesh_->NumEntities(codim_);
+  std::vector<std::int64_t> offsets(num_cells);
+  std::vector<std::uint8_t> types(num_cells);
+  for (const mesh::Entity* e : mesh_->Entities(codim_)) {
+    const base::glb_idx_t index = mesh_->Index(*e);
+    offsets[index] = e->RefEl().NumNodes();
+    types[index] = VtkCellType(e->RefEl());
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<std::int64_t> connectivity(num_cells == 0 ? 0
+                                                        : offsets.back());
+  for (const mesh::Entity* e : mesh_->Entities(codim_)) {
+    const base::glb_idx_t index = mesh_->Index(*e);
+    std::int64_t* nodes = connectivity.data() + offsets[index] -
+                          e->RefEl().NumNodes();
+    if (codim_ == dim_mesh) {
+      *nodes = index;
+    } else {
+      for (const mesh::Entity* p : e->SubEntities(dim_mesh - codim_)) {
+        *nodes++ = mesh_->Index(*p);
+      }
+    }
+  }
+  append("connectivity", internal::VtkTypeName<std::int64_t>(), 1,
+         connectivity);
+  append("offsets", internal::VtkTypeName<std::int64_t>(), 1, offsets);
+  append("types", internal::VtkTypeName<std::uint8_t>(), 1, types);
+  data_ = data.str();
+}
+
+VtuWriter::VtuWriter(std::shared_ptr<const mesh::Mesh> mesh,
+                     std::string filename, dim_t codim,
+                     VtuWriterOptions options)
+    : VtuWriter(std::make_shared<const VtuGeometry>(std::move(mesh), codim,
+                                                    options),
+                std::move(filename)) {}
+
+VtuWriter::VtuWriter(std::shared_ptr<const VtuGeometry> geometry,
+                     std::string filename)
+    : geometry_(std::move(geometry)),
+      mesh_(geometry_->mesh_),
+      filename_(std::move(filename)),
+      codim_(geometry_->codim_),
+      options_(geometry_->options_) {
+  data_file_.open(DataFileName(), std::ios_base::out | std::ios_base::binary |
+                                      std::ios_base::trunc);
+  if (!data_file_.is_open()) {
+    throw base::LfException("Could not open file " + DataFileName() +
+                            " for writing.");
+  }
+  // the encoded geometry comes first in the appended data
+  data_file_.write(geometry_->data_.data(),
+                   static_cast<std::streamsize>(geometry_->data_.size()));
+  num_data_bytes_ = geometry_->data_.size();
+}
+
+VtuWriter::ArrayInfo VtuWriter::AppendArray(std::string name,
+                                            const char* type,
+                                            int num_components,
+                                            const void* data,
+                                            std::uint64_t num_bytes) {
+  LF_VERIFY_MSG(!closed_, "VtuWriter::Close() has already been called.");
+  ArrayInfo info{std::move(name), type, num_components, num_data_bytes_};
+  num_data_bytes_ += internal::WriteVtuBlock(data_file_, options_.compress,
+                                             data, num_bytes);
+  if (!data_file_) {
+    throw base::LfException("Could not write to file " + DataFileName());
+  }
+  return info;
+}
+
+void VtuWriter::CheckAttributeSetName(const std::vector<ArrayInfo>& arrays,
+                                      const std::string& name) const {
+  LF_VERIFY_MSG(!closed_, "VtuWriter::Close() has already been called.");
+  if (std::find_if(arrays.begin(), arrays.end(), [&](const ArrayInfo& a) {
+        return a.name == name;
+      }) != arrays.end()) {
+    throw base::LfException(
+        "There is already another Point/Cell Attribute Set with the name " +
+        name);
+  }
+  if (name.find_first_of(" \"<>&") != std::string::npos) {
+    throw base::LfException(
+        "The name of the attribute set cannot contain spaces or any of the "
+        "characters \"<>&");
+  }
+}
+
+void VtuWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  data_file_.close();
+
+  std::ofstream file(filename_, std::ios_base::out | std::ios_base::binary |
+                                    std::ios_base::trunc);
+  if (!file.is_open()) {
+    throw base::LfException("Could not open file " + filename_ +
+                            " for writing.");
+  }
+  auto write_arrays = [&](const std::vector<ArrayInfo>& arrays,
+                          const char* indent) {
+    for (const ArrayInfo& a : arrays) {
+      file << indent << "<DataArray type=\"" << a.type << "\" Name=\""
+           << a.name << "\" NumberOfComponents=\"" << a.num_components
+           << "\" format=\"appended\" offset=\"" << a.offset << "\"/>\n";
+    }
+  };
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << (internal::IsLittleEndian() ? "LittleEndian" : "BigEndian")
+       << "\" header_type=\"UInt64\"";
+  if (options_.compress) {
+    file << " compressor=\"vtkZLibDataCompressor\"";
+  }
+  file << ">\n"
+       << "  <UnstructuredGrid>\n"
+       << "    <Piece NumberOfPoints=\""
+       << mesh_->NumEntities(mesh_->DimMesh()) << "\" NumberOfCells=\""
+       << mesh_->NumEntities(codim_) << "\">\n"
+       << "      <PointData>\n";
+  write_arrays(point_arrays_, "        ");
+  file << "      </PointData>\n"
+       << "      <CellData>\n";
+  write_arrays(cell_arrays_, "        ");
+  file << "      </CellData>\n"
+       << "      <Points>\n";
+  const std::vector<ArrayInfo>& geometry_arrays = geometry_->arrays_;
+  write_arrays({geometry_arrays[0]}, "        ");
+  file << "      </Points>\n"
+       << "      <Cells>\n";
+  write_arrays({geometry_arrays.begin() + 1, geometry_arrays.end()},
+               "        ");
+  file << "      </Cells>\n"
+       << "    </Piece>\n"
+       << "  </UnstructuredGrid>\n"
+       << "  <AppendedData encoding=\"raw\">\n"
+       << "   _";
+  {
+    // the geometry has been written, so the data file is never empty
+    std::ifstream data_file(DataFileName(),
+                            std::ios_base::in | std::ios_base::binary);
+    file << data_file.rdbuf();
+  }
+  file << "\n  </AppendedData>\n"
+       << "</VTKFile>\n";
+  std::remove(DataFileName().c_str());
+  if (!file) {
+    throw base::LfException("Error while writing file " + filename_);
+  }
+}
+
+}  // namespace lf::io
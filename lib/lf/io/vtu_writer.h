@@ -0,0 +1,451 @@
+/**
+ * @file
+ * @brief Declares the VtuWriter which streams VTK XML unstructured grid files
+ *        (`*.vtu`) with binary appended data to disk.
+ * @copyright MIT License
+ */
+
+#ifndef __c5e0a7d2b8f14e6a9d3b27f1e04c8a95
+#define __c5e0a7d2b8f14e6a9d3b27f1e04c8a95
+
+#include <lf/base/base.h>
+#include <lf/mesh/mesh.h>
+#include <lf/mesh/utils/utils.h>
+#include <Eigen/Eigen>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace lf::io {
+
+namespace internal {
+
+/// Prevents template argument deduction from a function parameter
+template <class T>
+struct NonDeduced {
+  using type = T;
+};
+
+/// Name of the VTK data type that corresponds to the C++ type `T`
+template <class T>
+constexpr const char* VtkTypeName() {
+  if constexpr (std::is_same_v<T, char>) {
+    return std::is_signed_v<char> ? "Int8" : "UInt8";
+  } else if constexpr (std::is_same_v<T, unsigned char>) {
+    return "UInt8";
+  } else if constexpr (std::is_same_v<T, int>) {
+    return "Int32";
+  } else if constexpr (std::is_same_v<T, unsigned int>) {
+    return "UInt32";
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return "Int64";
+  } else if constexpr (std::is_same_v<T, float>) {
+    return "Float32";
+  } else {
+    static_assert(std::is_same_v<T, double>, "unsupported VTK data type");
+    return "Float64";
+  }
+}
+
+/// Description of an array in the appended data of a vtu file
+struct VtuArrayInfo {
+  std::string name;
+  const char* type;
+  int num_components;
+  /// position of the array relative to the start of the appended data
+  std::uint64_t offset;
+};
+
+/**
+ * @brief Write the binary block of an array to the appended data of a vtu
+ *        file, either as [size][data] or in the block layout of
+ *        vtkZLibDataCompressor.
+ * @return the number of bytes written to `out`
+ */
+std::uint64_t WriteVtuBlock(std::ostream& out, bool compress, const void* data,
+                            std::uint64_t num_bytes);
+
+/// Byte order of the binary data written by the VtuWriter
+bool IsLittleEndian();
+
+/**
+ * @brief Evaluate `value` on all entities of codimension `codim` and store the
+ *        results, converted to `OUT`, by the index of the entities.
+ *
+ * Only the first `NUM_COMPONENTS` components of vector valued results are
+ * used, missing components are set to zero.
+ */
+template <class OUT, int NUM_COMPONENTS, class VALUE_FUNCTION>
+std::vector<OUT> SampleEntities(const mesh::Mesh& mesh, base::dim_t codim,
+                                const VALUE_FUNCTION& value) {
+  std::vector<OUT> data(NUM_COMPONENTS * mesh.NumEntities(codim), OUT(0));
+  for (const mesh::Entity* e : mesh.Entities(codim)) {
+    OUT* out = data.data() + NUM_COMPONENTS * mesh.Index(*e);
+    const auto v = value(*e);
+    if constexpr (NUM_COMPONENTS == 1) {
+      *out = static_cast<OUT>(v);
+    } else {
+      const auto n = std::min<Eigen::Index>(v.size(), NUM_COMPONENTS);
+      for (Eigen::Index i = 0; i < n; ++i) {
+        out[i] = static_cast<OUT>(v[i]);
+      }
+    }
+  }
+  return data;
+}
+
+/// Value written for entities on which a MeshDataSet is not defined
+template <class T>
+T ZeroAttribute() {
+  if constexpr (base::is_eigen_matrix<T>) {
+    return T::Zero(T::RowsAtCompileTime == Eigen::Dynamic
+                       ? 3
+                       : T::RowsAtCompileTime);
+  } else {
+    return T(0);
+  }
+}
+
+/**
+ * @brief Evaluate `value` of type `T` on all entities of codimension `codim`
+ *        and pass the result, converted to a type of the VTK formats, as
+ *        `sink(const std::vector<OUT>& data, int num_components)`.
+ *
+ * `double` values are converted to `float` unless `double_precision` is set,
+ * vectors are passed with three components.
+ */
+template <class T, class VALUE_FUNCTION, class SINK>
+void SampleAttribute(const mesh::Mesh& mesh, base::dim_t codim,
+                     bool double_precision, const VALUE_FUNCTION& value,
+                     SINK&& sink) {
+  if constexpr (std::is_same_v<T, unsigned char> || std::is_same_v<T, char> ||
+                std::is_same_v<T, unsigned> || std::is_same_v<T, int> ||
+                std::is_same_v<T, float>) {
+    sink(SampleEntities<T, 1>(mesh, codim, value), 1);
+  } else if constexpr (std::is_same_v<T, double>) {
+    if (double_precision) {
+      sink(SampleEntities<double, 1>(mesh, codim, value), 1);
+    } else {
+      sink(SampleEntities<float, 1>(mesh, codim, value), 1);
+    }
+  } else if constexpr (base::is_eigen_matrix<T>) {
+    static_assert(T::ColsAtCompileTime == 1,
+                  "Vector valued data must be given as column vectors");
+    using Scalar = typename T::Scalar;
+    static_assert(
+        std::is_same_v<double, Scalar> || std::is_same_v<float, Scalar>,
+        "Vector valued data must be either double or float valued.");
+    if (std::is_same_v<Scalar, float> || !double_precision) {
+      sink(SampleEntities<float, 3>(mesh, codim, value), 3);
+    } else {
+      sink(SampleEntities<double, 3>(mesh, codim, value), 3);
+    }
+  } else {
+    static_assert(base::is_eigen_matrix<T>,
+                  "Data must be one of: unsigned char, char, unsigned, int, "
+                  "float, double, Eigen::Vector<double, ...> or "
+                  "Eigen::Vector<float, ...>");
+  }
+}
+
+/// Barycenters of the reference elements, indexed by base::RefEl::Id()
+std::vector<Eigen::MatrixXd> ReferenceBarycenters();
+
+}  // namespace internal
+
+/**
+ * @brief Output options of a VtuWriter
+ */
+struct VtuWriterOptions {
+  /// Compress every data array with zlib, requires that LehrFEM++ has been
+  /// built with the CMake option `LF_ENABLE_ZLIB`.
+  bool compress = false;
+  /// Write `double` valued data and the point coordinates as `Float64`. By
+  /// default they are converted to `Float32`, just as the VtkWriter does.
+  bool double_precision = false;
+};
+
+/**
+ * @brief The points and cells of a mesh, encoded for the appended data of a
+ *        vtu file.
+ *
+ * The conversion (and compression) of the geometry is done once by the
+ * constructor. The result can be shared by all VtuWriter objects that write
+ * data on the same mesh, see also VtuTimeSeriesWriter. Note that this only
+ * saves the encoding, every vtu file still contains a copy of the geometry.
+ */
+class VtuGeometry {
+ public:
+  using dim_t = base::dim_t;
+
+  /**
+   * @brief Encode the nodes of `mesh` as points and the entities of
+   *        codimension `codim` as cells.
+   * @throws base::LfException if compression is requested but LehrFEM++ was
+   *         built without zlib.
+   */
+  explicit VtuGeometry(std::shared_ptr<const mesh::Mesh> mesh, dim_t codim = 0,
+                       VtuWriterOptions options = {});
+
+  [[nodiscard]] const std::shared_ptr<const mesh::Mesh>& Mesh() const {
+    return mesh_;
+  }
+  [[nodiscard]] dim_t Codim() const { return codim_; }
+  [[nodiscard]] const VtuWriterOptions& Options() const { return options_; }
+
+ private:
+  std::shared_ptr<const mesh::Mesh> mesh_;
+  dim_t codim_;
+  VtuWriterOptions options_;
+  /// encoded blocks of the points, connectivity, offsets and cell types
+  std::string data_;
+  std::vector<internal::VtuArrayInfo> arrays_;
+
+  friend class VtuWriter;
+};
+
+// clang-format off
+/**
+ * @brief Write a mesh and data attached to it into a VTK XML unstructured grid
+ *        file (`*.vtu`) that can be opened with ParaView.
+ *
+ * In contrast to the VtkWriter, which keeps all data in memory and writes the
+ * legacy VTK format when it is destroyed, the VtuWriter converts every data
+ * array to its binary representation and writes it to disk as soon as
+ * WritePointData() or WriteCellData() is called. Only the name, type and
+ * position of the arrays are kept in memory, so that the memory footprint
+ * does not grow with the number of fields written.
+ *
+ * The arrays are stored in the `<AppendedData>` section of the file in
+ * `raw` encoding, either uncompressed or compressed with zlib (see
+ * VtuWriterOptions). Because this section follows the XML description of the
+ * arrays, the binary data is first collected in the temporary file
+ * `<filename>.appended` and copied behind the XML header by Close(), which
+ * is also called by the destructor.
+ *
+ * Only first order cells are supported, i.e. the nodes of the mesh are the
+ * points of the vtu file and curved cells are visualized by straight lines.
+ * Several writers on the same mesh can share the encoded geometry through a
+ * VtuGeometry object.
+ *
+ * #### Sample usage:
+ * @snippet vtu_writer.cc usage
+ */
+// clang-format on
+class VtuWriter {
+ public:
+  using dim_t = base::dim_t;
+
+  VtuWriter(const VtuWriter&) = delete;
+  VtuWriter(VtuWriter&&) = delete;
+  VtuWriter& operator=(const VtuWriter&) = delete;
+  VtuWriter& operator=(VtuWriter&&) = delete;
+
+  /**
+   * @brief Construct a new VtuWriter and write the geometry of the mesh.
+   * @param mesh The underlying mesh that should be written into the file.
+   * @param filename The name of the vtu file.
+   * @param codim (Optional) the codimension of the cells, default is 0. If
+   *              `codim=1`, the skeleton of the mesh is written.
+   * @param options (Optional) precision and compression of the binary data.
+   *
+   * @throws base::LfException if the temporary data file cannot be opened or
+   *         if compression is requested but LehrFEM++ was built without zlib.
+   */
+  VtuWriter(std::shared_ptr<const mesh::Mesh> mesh, std::string filename,
+            dim_t codim = 0, VtuWriterOptions options = {});
+
+  /**
+   * @brief Construct a new VtuWriter that writes an already encoded geometry.
+   * @param geometry The points and cells, its options also apply to the data
+   *                 arrays written by this VtuWriter.
+   * @param filename The name of the vtu file.
+   */
+  VtuWriter(std::shared_ptr<const VtuGeometry> geometry, std::string filename);
+
+  /**
+   * @brief Write data attached to the points/nodes of the mesh.
+   * @tparam T one of `unsigned char`, `char`, `unsigned int`, `int`, `float`,
+   *           `double` or an `Eigen` column vector of `float`s or `double`s.
+   *           Only the first three components of a vector are written.
+   * @param name The name of the dataset, cannot contain spaces.
+   * @param mds The mesh dataset that attaches data to the nodes of the mesh.
+   * @param undefined_value The value written for a node on which `mds` is not
+   *                        defined (i.e. if `mds.DefinedOn() == false`).
+   */
+  template <class T>
+  void WritePointData(const std::string& name,
+                      const mesh::utils::MeshDataSet<T>& mds,
+                      const typename internal::NonDeduced<T>::type&
+                          undefined_value);
+
+  /**
+   * @brief Write data attached to the points/nodes of the mesh, nodes on
+   *        which `mds` is not defined get the value zero.
+   */
+  template <class T>
+  void WritePointData(const std::string& name,
+                      const mesh::utils::MeshDataSet<T>& mds) {
+    WritePointData(name, mds, internal::ZeroAttribute<T>());
+  }
+
+  /**
+   * @brief Sample a \ref mesh_function "MeshFunction" at the nodes of the mesh
+   *        and write the values as point data.
+   * @tparam MESH_FUNCTION An object fulfilling the \ref mesh_function concept,
+   *         the \ref mesh::utils::MeshFunctionReturnType must be one of the
+   *         types supported by WritePointData(const std::string&, const <!--
+   *         --> mesh::utils::MeshDataSet<T>&).
+   */
+  template <
+      class MESH_FUNCTION,
+      class = std::enable_if_t<lf::mesh::utils::isMeshFunction<MESH_FUNCTION>>>
+  void WritePointData(const std::string& name,
+                      const MESH_FUNCTION& mesh_function);
+
+  /**
+   * @brief Write data attached to the cells of the mesh (the entities with the
+   *        codimension passed to the constructor).
+   * @param name The name of the dataset, cannot contain spaces.
+   * @param mds The mesh dataset that attaches data to the cells of the mesh.
+   * @param undefined_value The value written for a cell on which `mds` is not
+   *                        defined (i.e. if `mds.DefinedOn() == false`).
+   * @sa WritePointData() for the supported types `T`.
+   */
+  template <class T>
+  void WriteCellData(const std::string& name,
+                     const mesh::utils::MeshDataSet<T>& mds,
+                     const typename internal::NonDeduced<T>::type&
+                         undefined_value);
+
+  /**
+   * @brief Write data attached to the cells of the mesh, cells on which `mds`
+   *        is not defined get the value zero.
+   */
+  template <class T>
+  void WriteCellData(const std::string& name,
+                     const mesh::utils::MeshDataSet<T>& mds) {
+    WriteCellData(name, mds, internal::ZeroAttribute<T>());
+  }
+
+  /**
+   * @brief Sample a \ref mesh_function "MeshFunction" at the barycenters of the
+   *        cells and write the values as cell data.
+   */
+  template <
+      class MESH_FUNCTION,
+      class = std::enable_if_t<lf::mesh::utils::isMeshFunction<MESH_FUNCTION>>>
+  void WriteCellData(const std::string& name,
+                     const MESH_FUNCTION& mesh_function);
+
+  /**
+   * @brief Write the XML description of all arrays followed by their binary
+   *        data into the vtu file and remove the temporary data file.
+   *
+   * No more data can be written afterwards, calling Close() again has no
+   * effect.
+   */
+  void Close();
+
+  ~VtuWriter() { Close(); }
+
+ private:
+  using ArrayInfo = internal::VtuArrayInfo;
+
+  std::shared_ptr<const VtuGeometry> geometry_;
+  std::shared_ptr<const mesh::Mesh> mesh_;
+  std::string filename_;
+  dim_t codim_;
+  VtuWriterOptions options_;
+  /// temporary file collecting the binary appended data
+  std::ofstream data_file_;
+  /// number of bytes written to `data_file_`
+  std::uint64_t num_data_bytes_ = 0;
+  bool closed_ = false;
+
+  std::vector<ArrayInfo> point_arrays_;
+  std::vector<ArrayInfo> cell_arrays_;
+
+  [[nodiscard]] std::string DataFileName() const {
+    return filename_ + ".appended";
+  }
+
+  /// Write one array as a (possibly compressed) block to `data_file_`
+  ArrayInfo AppendArray(std::string name, const char* type,
+                        int num_components, const void* data,
+                        std::uint64_t num_bytes);
+
+  /// Evaluate `value` on all entities of codimension `codim` and append the
+  /// result as an array with values of type `T`
+  template <class T, class VALUE_FUNCTION>
+  void WriteAttribute(std::vector<ArrayInfo>& arrays, const std::string& name,
+                      dim_t codim, const VALUE_FUNCTION& value);
+
+  void CheckAttributeSetName(const std::vector<ArrayInfo>& arrays,
+                             const std::string& name) const;
+};
+
+template <class T>
+void VtuWriter::WritePointData(
+    const std::string& name, const mesh::utils::MeshDataSet<T>& mds,
+    const typename internal::NonDeduced<T>::type& undefined_value) {
+  WriteAttribute<T>(point_arrays_, name, mesh_->DimMesh(),
+                    [&](const mesh::Entity& e) -> T {
+                      return mds.DefinedOn(e) ? mds(e) : undefined_value;
+                    });
+}
+
+template <class MESH_FUNCTION, class>
+void VtuWriter::WritePointData(const std::string& name,
+                               const MESH_FUNCTION& mesh_function) {
+  using T = mesh::utils::MeshFunctionReturnType<MESH_FUNCTION>;
+  const Eigen::Matrix<double, 0, 1> origin{};
+  WriteAttribute<T>(
+      point_arrays_, name, mesh_->DimMesh(),
+      [&](const mesh::Entity& e) -> T { return mesh_function(e, origin)[0]; });
+}
+
+template <class T>
+void VtuWriter::WriteCellData(
+    const std::string& name, const mesh::utils::MeshDataSet<T>& mds,
+    const typename internal::NonDeduced<T>::type& undefined_value) {
+  WriteAttribute<T>(cell_arrays_, name, codim_,
+                    [&](const mesh::Entity& e) -> T {
+                      return mds.DefinedOn(e) ? mds(e) : undefined_value;
+                    });
+}
+
+template <class MESH_FUNCTION, class>
+void VtuWriter::WriteCellData(const std::string& name,
+                              const MESH_FUNCTION& mesh_function) {
+  using T = mesh::utils::MeshFunctionReturnType<MESH_FUNCTION>;
+  const std::vector<Eigen::MatrixXd> barycenters{
+      internal::ReferenceBarycenters()};
+  WriteAttribute<T>(cell_arrays_, name, codim_,
+                    [&](const mesh::Entity& e) -> T {
+                      return mesh_function(e, barycenters[e.RefEl().Id()])[0];
+                    });
+}
+
+template <class T, class VALUE_FUNCTION>
+void VtuWriter::WriteAttribute(std::vector<ArrayInfo>& arrays,
+                               const std::string& name, dim_t codim,
+                               const VALUE_FUNCTION& value) {
+  CheckAttributeSetName(arrays, name);
+  internal::SampleAttribute<T>(
+      *mesh_, codim, options_.double_precision, value,
+      [&](const auto& data, int num_components) {
+        using OUT = typename std::decay_t<decltype(data)>::value_type;
+        arrays.push_back(AppendArray(name, internal::VtkTypeName<OUT>(),
+                                     num_components, data.data(),
+                                     data.size() * sizeof(OUT)));
+      });
+}
+
+}  // namespace lf::io
+
+#endif  // __c5e0a7d2b8f14e6a9d3b27f1e04c8a95
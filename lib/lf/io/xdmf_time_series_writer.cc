@@ -0,0 +1,221 @@
+/**
+ * @file
+ * @brief Implementation of the XdmfTimeSeriesWriter
+ * @copyright MIT License
+ */
+
+#include "xdmf_time_series_writer.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+namespace lf::io {
+
+namespace {
+
+// Cell types of the XDMF format, polyvertices and polylines are followed by
+// their number of nodes in a mixed topology
+constexpr std::int64_t kXdmfPolyvertex = 1;
+constexpr std::int64_t kXdmfPolyline = 2;
+constexpr std::int64_t kXdmfTriangle = 4;
+constexpr std::int64_t kXdmfQuadrilateral = 5;
+
+// File name relative to the directory of the .xmf file
+std::string RelativeFileName(const std::string& filename) {
+  return filename.substr(filename.find_last_of("/\\") + 1);
+}
+
+std::ofstream OpenBinaryFile(const std::string& filename) {
+  std::ofstream file(filename, std::ios_base::out | std::ios_base::binary |
+                                   std::ios_base::trunc);
+  if (!file.is_open()) {
+    throw base::LfException("Could not open file " + filename +
+                            " for writing.");
+  }
+  return file;
+}
+
+}  // namespace
+
+XdmfTimeSeriesWriter::XdmfTimeSeriesWriter(
+    std::shared_ptr<const mesh::Mesh> mesh, std::string basename,
+    dim_t codim, bool double_precision)
+    : mesh_(std::move(mesh)),
+      basename_(std::move(basename)),
+      codim_(codim),
+      double_precision_(double_precision) {
+  LF_ASSERT_MSG(codim_ <= mesh_->DimMesh(),
+                "codim = " << codim_ << " exceeds the dimension of the mesh");
+  const std::string mesh_file = basename_ + "_mesh.bin";
+  mesh_file_ = RelativeFileName(mesh_file);
+  std::ofstream file{OpenBinaryFile(mesh_file)};
+
+  // point coordinates, always with three components
+  const dim_t dim_mesh = mesh_->DimMesh();
+  const dim_t dim_world = mesh_->DimWorld();
+  const Eigen::Matrix<double, 0, 1> origin{};
+  auto coordinates = [&](const mesh::Entity& p) -> Eigen::Vector3d {
+    Eigen::Vector3d x = Eigen::Vector3d::Zero();
+    x.head(dim_world) = p.Geometry()->Global(origin);
+    return x;
+  };
+  internal::SampleAttribute<Eigen::Vector3d>(
+      *mesh_, dim_mesh, double_precision_, coordinates,
+      [&](const auto& data, int num_components) {
+        using OUT = typename std::decay_t<decltype(data)>::value_type;
+        points_ = {"Points", internal::XdmfNumberType<OUT>(),
+                   data.size() / num_components, num_components, 0, false};
+        file.write(reinterpret_cast<const char*>(data.data()),
+                   static_cast<std::streamsize>(data.size() * sizeof(OUT)));
+      });
+
+  // mixed topology: the cell type, (the number of nodes) and the node indices
+  // of every cell, ordered by the index of the cells
+  std::vector<const mesh::Entity*> cells(mesh_->NumEntities(codim_));
+  for (const mesh::Entity* e : mesh_->Entities(codim_)) {
+    cells[mesh_->Index(*e)] = e;
+  }
+  std::vector<std::int64_t> topology;
+  topology.reserve(5 * cells.size());
+  for (const mesh::Entity* e : cells) {
+    switch (e->RefEl()) {
+      case base::RefEl::kPoint():
+        topology.insert(topology.end(), {kXdmfPolyvertex, 1});
+        break;
+      case base::RefEl::kSegment():
+        topology.insert(topology.end(), {kXdmfPolyline, 2});
+        break;
+      case base::RefEl::kTria():
+        topology.push_back(kXdmfTriangle);
+        break;
+      case base::RefEl::kQuad():
+        topology.push_back(kXdmfQuadrilateral);
+        break;
+      default:
+        throw base::LfException(
+            "XdmfTimeSeriesWriter does not support cells of type " +
+            e->RefEl().ToString());
+    }
+    if (codim_ == dim_mesh) {
+      topology.push_back(mesh_->Index(*e));
+    } else {
+      for (const mesh::Entity* p : e->SubEntities(dim_mesh - codim_)) {
+        topology.push_back(mesh_->Index(*p));
+      }
+    }
+  }
+  const std::uint64_t points_bytes =
+      points_.size * points_.num_components * points_.number_type.second;
+  topology_ = {"Topology", internal::XdmfNumberType<std::int64_t>(),
+               topology.size(), 1, points_bytes, true};
+  file.write(reinterpret_cast<const char*>(topology.data()),
+             static_cast<std::streamsize>(topology.size() *
+                                          sizeof(std::int64_t)));
+  if (!file) {
+    throw base::LfException("Error while writing file " + mesh_file);
+  }
+}
+
+void XdmfTimeSeriesWriter::AddTimeStep(double time) {
+  LF_VERIFY_MSG(!closed_,
+                "XdmfTimeSeriesWriter::Close() has already been called.");
+  step_file_.close();
+  step_file_name_ = basename_ + "_" + std::to_string(steps_.size()) + ".bin";
+  step_file_ = OpenBinaryFile(step_file_name_);
+  num_step_bytes_ = 0;
+  steps_.push_back({time, RelativeFileName(step_file_name_), {}});
+}
+
+void XdmfTimeSeriesWriter::AppendArray(ArrayInfo info, const void* data,
+                                       std::uint64_t num_bytes) {
+  info.seek = num_step_bytes_;
+  step_file_.write(static_cast<const char*>(data),
+                   static_cast<std::streamsize>(num_bytes));
+  if (!step_file_) {
+    throw base::LfException("Could not write to file " + step_file_name_);
+  }
+  num_step_bytes_ += num_bytes;
+  steps_.back().arrays.push_back(std::move(info));
+}
+
+void XdmfTimeSeriesWriter::CheckAttributeSetName(
+    const std::string& name) const {
+  LF_VERIFY_MSG(!closed_,
+                "XdmfTimeSeriesWriter::Close() has already been called.");
+  LF_VERIFY_MSG(!steps_.empty(),
+                "AddTimeStep() must be called before data can be written.");
+  const std::vector<ArrayInfo>& arrays = steps_.back().arrays;
+  if (std::find_if(arrays.begin(), arrays.end(), [&](const ArrayInfo& a) {
+        return a.name == name;
+      }) != arrays.end()) {
+    throw base::LfException(
+        "There is already another Point/Cell Attribute Set with the name " +
+        name);
+  }
+  if (name.find_first_of(" \"<>&") != std::string::npos) {
+    throw base::LfException(
+        "The name of the attribute set cannot contain spaces or any of the "
+        "characters \"<>&");
+  }
+}
+
+void XdmfTimeSeriesWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  step_file_.close();
+
+  const std::string filename = basename_ + ".xmf";
+  std::ofstream file(filename, std::ios_base::out | std::ios_base::trunc);
+  if (!file.is_open()) {
+    throw base::LfException("Could not open file " + filename +
+                            " for writing.");
+  }
+  const char* endian = internal::IsLittleEndian() ? "Little" : "Big";
+  auto write_data_item = [&](const ArrayInfo& a, const std::string& heavy,
+                             const char* indent) {
+    file << indent << "<DataItem Dimensions=\"" << a.size;
+    if (a.num_components > 1) {
+      file << ' ' << a.num_components;
+    }
+    file << "\" NumberType=\"" << a.number_type.first << "\" Precision=\""
+         << a.number_type.second << "\" Format=\"Binary\" Endian=\"" << endian
+         << "\" Seek=\"" << a.seek << "\">" << heavy << "</DataItem>\n";
+  };
+
+  file << std::setprecision(std::numeric_limits<double>::max_digits10)
+       << "<?xml version=\"1.0\" ?>\n"
+       << "<Xdmf Version=\"3.0\">\n"
+       << "  <Domain>\n"
+       << "    <Grid Name=\"TimeSeries\" GridType=\"Collection\" "
+          "CollectionType=\"Temporal\">\n";
+  for (std::size_t step = 0; step < steps_.size(); ++step) {
+    file << "      <Grid Name=\"step_" << step << "\" GridType=\"Uniform\">\n"
+         << "        <Time Value=\"" << steps_[step].time << "\"/>\n"
+         << "        <Topology TopologyType=\"Mixed\" NumberOfElements=\""
+         << mesh_->NumEntities(codim_) << "\">\n";
+    // all steps refer to the geometry in the same file
+    write_data_item(topology_, mesh_file_, "          ");
+    file << "        </Topology>\n"
+         << "        <Geometry GeometryType=\"XYZ\">\n";
+    write_data_item(points_, mesh_file_, "          ");
+    file << "        </Geometry>\n";
+    for (const ArrayInfo& a : steps_[step].arrays) {
+      file << "        <Attribute Name=\"" << a.name << "\" AttributeType=\""
+           << (a.num_components == 1 ? "Scalar" : "Vector") << "\" Center=\""
+           << (a.cell_data ? "Cell" : "Node") << "\">\n";
+      write_data_item(a, steps_[step].file, "          ");
+      file << "        </Attribute>\n";
+    }
+    file << "      </Grid>\n";
+  }
+  file << "    </Grid>\n"
+       << "  </Domain>\n"
+       << "</Xdmf>\n";
+  if (!file) {
+    throw base::LfException("Error while writing file " + filename);
+  }
+}
+
+}  // namespace lf::io
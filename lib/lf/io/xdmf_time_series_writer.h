@@ -0,0 +1,292 @@
+/**
+ * @file
+ * @brief Declares the XdmfTimeSeriesWriter which writes the fields of a time
+ *        series on a fixed mesh into an XDMF file with raw binary heavy data,
+ *        the geometry of the mesh is stored only once.
+ * @copyright MIT License
+ */
+
+#ifndef __4b91e3f7a0c24d56b8e2f61d9c3a7e05
+#define __4b91e3f7a0c24d56b8e2f61d9c3a7e05
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "vtu_writer.h"
+
+namespace lf::io {
+
+namespace internal {
+
+/// `NumberType` and `Precision` of an XDMF data item of C++ type `T`
+template <class T>
+constexpr std::pair<const char*, int> XdmfNumberType() {
+  if constexpr (std::is_same_v<T, char>) {
+    return {std::is_signed_v<char> ? "Char" : "UChar", 1};
+  } else if constexpr (std::is_same_v<T, unsigned char>) {
+    return {"UChar", 1};
+  } else if constexpr (std::is_same_v<T, int>) {
+    return {"Int", 4};
+  } else if constexpr (std::is_same_v<T, unsigned int>) {
+    return {"UInt", 4};
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return {"Int", 8};
+  } else if constexpr (std::is_same_v<T, float>) {
+    return {"Float", 4};
+  } else {
+    static_assert(std::is_same_v<T, double>, "unsupported XDMF data type");
+    return {"Float", 8};
+  }
+}
+
+}  // namespace internal
+
+// clang-format off
+/**
+ * @brief Write the fields of a time dependent simulation on a fixed mesh into
+ *        an XDMF file `<basename>.xmf` that refers to the geometry of the mesh
+ *        from every time step.
+ *
+ * The points and cells of the mesh are written once by the constructor into
+ * the binary file `<basename>_mesh.bin`. The arrays passed to
+ * WritePointData() and WriteCellData() after AddTimeStep() are written
+ * directly into the binary file `<basename>_<step>.bin` of that step, which
+ * contains nothing else. In contrast to the VtuTimeSeriesWriter, the output
+ * per time step therefore consists of the field data only. The XML description
+ * `<basename>.xmf` is written by Close(), which is also called by the
+ * destructor. It can be opened with ParaView (XDMF Reader) or VisIt.
+ *
+ * The binary files contain the arrays without any header in the byte order of
+ * the machine, their positions in the files are given by the `Seek` attributes
+ * of the `DataItem`s with `Format="Binary"`. The cells are stored as a
+ * `Mixed` topology, so hybrid meshes are supported. Just as for the VtuWriter,
+ * only first order cells are written.
+ *
+ * #### Sample usage
+ * @code
+ * lf::io::XdmfTimeSeriesWriter writer(mesh_p, "solution");
+ * for (int step = 0; step < num_steps; ++step) {
+ *   // ... compute the solution at time t ...
+ *   writer.AddTimeStep(t);
+ *   writer.WritePointData("u", mf_u);
+ * }
+ * // the destructor writes solution.xmf
+ * @endcode
+ */
+// clang-format on
+class XdmfTimeSeriesWriter {
+ public:
+  using dim_t = base::dim_t;
+
+  XdmfTimeSeriesWriter(const XdmfTimeSeriesWriter&) = delete;
+  XdmfTimeSeriesWriter(XdmfTimeSeriesWriter&&) = delete;
+  XdmfTimeSeriesWriter& operator=(const XdmfTimeSeriesWriter&) = delete;
+  XdmfTimeSeriesWriter& operator=(XdmfTimeSeriesWriter&&) = delete;
+
+  /**
+   * @brief Write the geometry of the mesh to `<basename>_mesh.bin`.
+   * @param mesh The mesh on which all fields are defined.
+   * @param basename The XML description is written to `<basename>.xmf`, the
+   *                 heavy data to `<basename>_mesh.bin` and
+   *                 `<basename>_<step>.bin`.
+   * @param codim (Optional) the codimension of the cells, see VtuWriter.
+   * @param double_precision (Optional) write `double` valued data and the
+   *                         point coordinates with 8 bytes, by default they
+   *                         are converted to `float`.
+   * @throws base::LfException if the geometry file cannot be written.
+   */
+  XdmfTimeSeriesWriter(std::shared_ptr<const mesh::Mesh> mesh,
+                       std::string basename, dim_t codim = 0,
+                       bool double_precision = false);
+
+  /**
+   * @brief Close the binary file of the previous time step and start a new
+   *        one, the following calls of WritePointData() and WriteCellData()
+   *        write the fields of this step.
+   * @param time The time associated with the new step.
+   * @throws base::LfException if the binary file cannot be opened.
+   */
+  void AddTimeStep(double time);
+
+  /**
+   * @brief Write data attached to the points/nodes of the mesh for the current
+   *        time step.
+   * @sa VtuWriter::WritePointData() for the supported types `T`.
+   */
+  template <class T>
+  void WritePointData(const std::string& name,
+                      const mesh::utils::MeshDataSet<T>& mds,
+                      const typename internal::NonDeduced<T>::type&
+                          undefined_value);
+
+  /**
+   * @brief Write data attached to the points/nodes of the mesh, nodes on
+   *        which `mds` is not defined get the value zero.
+   */
+  template <class T>
+  void WritePointData(const std::string& name,
+                      const mesh::utils::MeshDataSet<T>& mds) {
+    WritePointData(name, mds, internal::ZeroAttribute<T>());
+  }
+
+  /**
+   * @brief Sample a \ref mesh_function "MeshFunction" at the nodes of the mesh
+   *        and write the values as point data of the current time step.
+   */
+  template <
+      class MESH_FUNCTION,
+      class = std::enable_if_t<lf::mesh::utils::isMeshFunction<MESH_FUNCTION>>>
+  void WritePointData(const std::string& name,
+                      const MESH_FUNCTION& mesh_function);
+
+  /**
+   * @brief Write data attached to the cells of the mesh for the current time
+   *        step.
+   * @sa VtuWriter::WriteCellData()
+   */
+  template <class T>
+  void WriteCellData(const std::string& name,
+                     const mesh::utils::MeshDataSet<T>& mds,
+                     const typename internal::NonDeduced<T>::type&
+                         undefined_value);
+
+  /**
+   * @brief Write data attached to the cells of the mesh, cells on which `mds`
+   *        is not defined get the value zero.
+   */
+  template <class T>
+  void WriteCellData(const std::string& name,
+                     const mesh::utils::MeshDataSet<T>& mds) {
+    WriteCellData(name, mds, internal::ZeroAttribute<T>());
+  }
+
+  /**
+   * @brief Sample a \ref mesh_function "MeshFunction" at the barycenters of the
+   *        cells and write the values as cell data of the current time step.
+   */
+  template <
+      class MESH_FUNCTION,
+      class = std::enable_if_t<lf::mesh::utils::isMeshFunction<MESH_FUNCTION>>>
+  void WriteCellData(const std::string& name,
+                     const MESH_FUNCTION& mesh_function);
+
+  /**
+   * @brief Close the binary file of the last time step and write the `.xmf`
+   *        file.
+   *
+   * Calling Close() again has no effect.
+   */
+  void Close();
+
+  ~XdmfTimeSeriesWriter() { Close(); }
+
+ private:
+  /// Description of an array in one of the binary files
+  struct ArrayInfo {
+    std::string name;
+    std::pair<const char*, int> number_type;
+    /// number of entries of the array (without components)
+    std::uint64_t size;
+    int num_components;
+    /// position of the array in its file in bytes
+    std::uint64_t seek;
+    /// point data if false, cell data if true
+    bool cell_data;
+  };
+
+  /// Time, binary file (relative to the .xmf file) and arrays of a step
+  struct Step {
+    double time;
+    std::string file;
+    std::vector<ArrayInfo> arrays;
+  };
+
+  std::shared_ptr<const mesh::Mesh> mesh_;
+  std::string basename_;
+  dim_t codim_;
+  bool double_precision_;
+  /// binary file with the geometry relative to the .xmf file
+  std::string mesh_file_;
+  ArrayInfo points_;
+  ArrayInfo topology_;
+  std::vector<Step> steps_;
+  /// binary file of the current step
+  std::ofstream step_file_;
+  std::string step_file_name_;
+  std::uint64_t num_step_bytes_ = 0;
+  bool closed_ = false;
+
+  /// Write one array to the file of the current step
+  void AppendArray(ArrayInfo info, const void* data, std::uint64_t num_bytes);
+
+  /// Evaluate `value` on all entities of codimension `codim` and append the
+  /// result to the file of the current step
+  template <class T, class VALUE_FUNCTION>
+  void WriteAttribute(bool cell_data, const std::string& name, dim_t codim,
+                      const VALUE_FUNCTION& value);
+
+  void CheckAttributeSetName(const std::string& name) const;
+};
+
+template <class T>
+void XdmfTimeSeriesWriter::WritePointData(
+    const std::string& name, const mesh::utils::MeshDataSet<T>& mds,
+    const typename internal::NonDeduced<T>::type& undefined_value) {
+  WriteAttribute<T>(false, name, mesh_->DimMesh(),
+                    [&](const mesh::Entity& e) -> T {
+                      return mds.DefinedOn(e) ? mds(e) : undefined_value;
+                    });
+}
+
+template <class MESH_FUNCTION, class>
+void XdmfTimeSeriesWriter::WritePointData(const std::string& name,
+                                          const MESH_FUNCTION& mesh_function) {
+  using T = mesh::utils::MeshFunctionReturnType<MESH_FUNCTION>;
+  const Eigen::Matrix<double, 0, 1> origin{};
+  WriteAttribute<T>(
+      false, name, mesh_->DimMesh(),
+      [&](const mesh::Entity& e) -> T { return mesh_function(e, origin)[0]; });
+}
+
+template <class T>
+void XdmfTimeSeriesWriter::WriteCellData(
+    const std::string& name, const mesh::utils::MeshDataSet<T>& mds,
+    const typename internal::NonDeduced<T>::type& undefined_value) {
+  WriteAttribute<T>(true, name, codim_, [&](const mesh::Entity& e) -> T {
+    return mds.DefinedOn(e) ? mds(e) : undefined_value;
+  });
+}
+
+template <class MESH_FUNCTION, class>
+void XdmfTimeSeriesWriter::WriteCellData(const std::string& name,
+                                         const MESH_FUNCTION& mesh_function) {
+  using T = mesh::utils::MeshFunctionReturnType<MESH_FUNCTION>;
+  const std::vector<Eigen::MatrixXd> barycenters{
+      internal::ReferenceBarycenters()};
+  WriteAttribute<T>(true, name, codim_, [&](const mesh::Entity& e) -> T {
+    return mesh_function(e, barycenters[e.RefEl().Id()])[0];
+  });
+}
+
+template <class T, class VALUE_FUNCTION>
+void XdmfTimeSeriesWriter::WriteAttribute(bool cell_data,
+                                          const std::string& name, dim_t codim,
+                                          const VALUE_FUNCTION& value) {
+  CheckAttributeSetName(name);
+  internal::SampleAttribute<T>(
+      *mesh_, codim, double_precision_, value,
+      [&](const auto& data, int num_components) {
+        using OUT = typename std::decay_t<decltype(data)>::value_type;
+        AppendArray({name, internal::XdmfNumberType<OUT>(),
+                     data.size() / num_components, num_components, 0,
+                     cell_data},
+                    data.data(), data.size() * sizeof(OUT));
+      });
+}
+
+}  // namespace lf::io
+
+#endif  // __4b91e3f7a0c24d56b8e2f61d9c3a7e05
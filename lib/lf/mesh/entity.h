@@ -39,6 +39,11 @@ char to_char(Orientation o);
 class Entity {
  protected:
   Entity() = default;
+  /**
+   * @brief Initializes the index of the entity, see Entity::index()
+   * @param index index of the entity within the mesh it belongs to
+   */
+  explicit Entity(base::glb_idx_t index) : index_(index) {}
   Entity(const Entity&) = default;
   Entity(Entity&&) = default;
   Entity& operator=(const Entity&) = default;
@@ -139,6 +144,16 @@ class Entity {
     return !operator==(rhs);
   }
 
+  /**
+   * @brief The index of this entity within the mesh it belongs to
+   *
+   * Mesh implementations assign the index when creating the entity, so that
+   * Mesh::Index() boils down to reading this value.
+   *
+   * @sa Mesh::Index()
+   */
+  [[nodiscard]] base::glb_idx_t index() const { return index_; }
+
   /**
    * @brief Virtual Destructor.
    */
@@ -147,6 +162,9 @@ class Entity {
   // Add global output control
   /** @brief Diagnostics control variable */
   static unsigned int output_ctrl_;
+
+ private:
+  base::glb_idx_t index_ = base::kIdxNil;  // zero-based index of this entity
 };  // class entity
 
 /**
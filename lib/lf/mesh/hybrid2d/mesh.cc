@@ -7,6 +7,8 @@
  */
 
 #include "mesh.h"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 
@@ -81,28 +83,6 @@ Mesh::size_type Mesh::NumEntities(lf::base::RefEl ref_el_type) const {
   return 0;
 }
 
-Mesh::size_type Mesh::Index(const Entity &e) const {
-  switch (e.Codim()) {
-    case 0: {
-      if (e.RefEl() == lf::base::RefEl::kTria()) {
-        return dynamic_cast<const Triangle &>(e).index();
-      }
-      if (e.RefEl() == lf::base::RefEl::kQuad()) {
-        return dynamic_cast<const Quadrilateral &>(e).index();
-      }
-      LF_VERIFY_MSG(false, "Illegal cell type");
-    }
-    case 1:
-      return dynamic_cast<const Segment &>(e).index();
-    case 2:
-      return dynamic_cast<const Point &>(e).index();
-    default:
-      LF_VERIFY_MSG(false,
-                    "Something is horribyl wrong, this entity has codim = " +
-                        std::to_string(e.Codim()));
-  }
-}
-
 const Entity *Mesh::EntityByIndex(dim_t codim, glb_idx_t index) const {
   LF_ASSERT_MSG(codim <= 2, "Illegal codimension " << codim);
   LF_ASSERT_MSG(index < NumEntities(codim),
@@ -126,43 +106,73 @@ bool Mesh::Contains(const Entity &e) const {
 }
 
 namespace /*anonymous */ {
-/** @brief Auxliary class for mesh_from_node_incidence */
-class EndpointIndexPair {
- public:
-  using size_type = Mesh::size_type;
-  // Constructor
-  EndpointIndexPair(size_type p0, size_type p1) : p0_(p0), p1_(p1) {
-    LF_ASSERT_MSG(p0 != p1, "No loops allowed");
-    if (p1 > p0) {
-      cmp_p0_ = p0;
-      cmp_p1_ = p1;
-    } else {
-      cmp_p0_ = p1;
-      cmp_p1_ = p0;
-    }
-  }
-  // Access operators
-  [[nodiscard]] size_type first_node() const { return p0_; }
-  [[nodiscard]] size_type second_node() const { return p1_; }
-  // The only comparison operator expected from a Map key
-  // Edges are considered equal even if they have the opposite orientation
-  friend bool operator<(const EndpointIndexPair &e1,
-                        const EndpointIndexPair &e2) {
-    return ((e1.cmp_p0_ == e2.cmp_p0_) ? (e1.cmp_p1_ < e2.cmp_p1_)
-                                       : (e1.cmp_p0_ < e2.cmp_p0_));
+/**
+ * @brief Auxiliary record for the construction of the edges: an occurrence of
+ * an edge either in the list of supplied edges or as an edge of a cell
+ */
+struct EdgeOccurrence {
+  // Orientation independent identifier of the edge: smaller endpoint index in
+  // the upper, larger endpoint index in the lower 32 bits
+  std::uint64_t key;
+  // index of the cell, idx_nil for an edge from the list of supplied edges
+  size_type cell_idx;
+  // local index of the edge in the cell, or position in the list of edges
+  size_type edge_idx;
+};
+
+std::uint64_t EdgeKey(size_type p0, size_type p1) {
+  static_assert(sizeof(size_type) <= 4, "node indices must fit into 32 bits");
+  LF_ASSERT_MSG(p0 != p1, "No loops allowed");
+  return (p0 < p1) ? ((std::uint64_t{p0} << 32U) | p1)
+                   : ((std::uint64_t{p1} << 32U) | p0);
+}
+
+// Number of threads for processing n items. Below a few thousand items per
+// thread the cost for starting the threads outweighs the gain.
+unsigned int NumChunks(std::size_t n) {
+  constexpr std::size_t min_chunk_size = 1U << 14U;
+  return static_cast<unsigned int>(std::min<std::size_t>(
+      lf::base::DefaultNumThreads(), 1 + n / min_chunk_size));
+}
+
+// Stable sort of edge occurrences according to their key: contiguous chunks
+// are sorted concurrently and then merged pairwise.
+void SortByKey(std::vector<EdgeOccurrence> &occurrences) {
+  auto less = [](const EdgeOccurrence &a, const EdgeOccurrence &b) {
+    return a.key < b.key;
+  };
+  const std::size_t n = occurrences.size();
+  const unsigned int num_chunks = NumChunks(n);
+  // bounds of the chunks, as chosen by ParallelForChunks()
+  std::vector<std::size_t> bounds(num_chunks + 1);
+  for (unsigned int k = 0; k <= num_chunks; ++k) {
+    bounds[k] = n * k / num_chunks;
   }
-  // Reorienting an edge
-  void flip() { std::swap(p0_, p1_); }
-  // Checking topological equality (taking into account orientation)
-  friend bool coincide(const EndpointIndexPair &e1,
-                       const EndpointIndexPair &e2) {
-    return ((e1.p0_ == e2.p0_) && (e1.p1_ == e2.p1_));
+  auto begin = occurrences.begin();
+  lf::base::ParallelForChunks(
+      n, num_chunks, [&](unsigned int /*chunk*/, std::size_t b, std::size_t e) {
+        std::stable_sort(begin + b, begin + e, less);
+      });
+  while (bounds.size() > 2) {
+    const std::size_t num_merges = (bounds.size() - 1) / 2;
+    lf::base::ParallelForChunks(
+        num_merges, num_merges,
+        [&](unsigned int /*chunk*/, std::size_t b, std::size_t e) {
+          for (std::size_t m = b; m < e; ++m) {
+            std::inplace_merge(begin + bounds[2 * m], begin + bounds[2 * m + 1],
+                               begin + bounds[2 * m + 2], less);
+          }
+        });
+    std::vector<std::size_t> merged_bounds;
+    for (std::size_t k = 0; k < bounds.size(); k += 2) {
+      merged_bounds.push_back(bounds[k]);
+    }
+    if (merged_bounds.back() != n) {
+      merged_bounds.push_back(n);
+    }
+    bounds = std::move(merged_bounds);
   }
-
- private:
-  size_type p0_, p1_;  // indices of endpoints
-  size_type cmp_p0_, cmp_p1_;
-};
+}
 }  // namespace
 
 // **********************************************************************
@@ -175,74 +185,122 @@ class EndpointIndexPair {
 // CellList = std::vector<std::pair<std::array<size_type, 4>, GeometryPtr>>;
 // **********************************************************************
 Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
-           bool check_completeness)
-    : dim_world_(dim_world) {
-  // Auxiliary data type for gathering information about cells adjacent to an
-  // edge
-  struct AdjCellInfo {
-    AdjCellInfo(size_type _cell_idx, size_type _edge_idx)
-        : cell_idx(_cell_idx), edge_idx(_edge_idx) {}
-    size_type cell_idx;  // index of adjacent cell
-    size_type edge_idx;  // local index of edge in adjacent cell
-  };
-  // Information about cells adjacent to an edge
-  using AdjCellsList = std::vector<AdjCellInfo>;
-  // Information about edge in auxiliary array
+           bool check_completeness, RetainedEntities retained)
+    : dim_world_(dim_world), geometry_source_(std::move(retained.source)) {
+  // Information about an edge collected from all its occurrences
   struct EdgeData {
-    EdgeData(GeometryPtr geo_uptr, AdjCellsList _adj_cells_list)
-        : geo_uptr(std::move(geo_uptr)),
-          adj_cells_list(std::move(_adj_cells_list)),
-          edge_global_index(-1),
-          reversed(false) {}
-    EdgeData(GeometryPtr geo_uptr, AdjCellsList _adj_cells_list,
-             glb_idx_t global_index)
-        : geo_uptr(std::move(geo_uptr)),
-          adj_cells_list(std::move(_adj_cells_list)),
-          edge_global_index(global_index),
-          reversed(false) {}
-    EdgeData(const EdgeData &) = delete;
-    EdgeData(EdgeData &&) = default;
-    EdgeData &operator=(const EdgeData &) = delete;
-    EdgeData &operator=(EdgeData &&) = default;
-    ~EdgeData() = default;
-    // temporary storage for unique pointer to edge geometry, if provided
+    // endpoints of the edge, in the orientation of the edge
+    size_type p0 = idx_nil;
+    size_type p1 = idx_nil;
+    // geometry of the edge, if supplied or inherited from a cell
     GeometryPtr geo_uptr;
-    // Information about neighbors
-    AdjCellsList adj_cells_list;
-    // Index of the edge
-    glb_idx_t edge_global_index;
-    // Flag indicating reversed orientation
-    bool reversed;
+    // geometry of a retained edge, owned by geometry_source_
+    geometry::Geometry *shared_geo = nullptr;
+    // Index of the edge, idx_nil for edges created from cells
+    glb_idx_t edge_global_index = idx_nil;
+    // Does the edge belong to at least one cell?
+    bool has_adjacent_cell = false;
   };
 
-  // Type of associative auxiliary array for edge information
-  using EdgeMap = std::map<EndpointIndexPair, EdgeData>;
-
   // For extracting point coordinates
   const Eigen::MatrixXd zero_point = base::RefEl::kPoint().NodeCoords();
 
   // ASSUMPTION: The length of the nodes vector gives the number of nodes
 
   const size_type no_of_nodes(nodes.size());
+  const size_type no_of_cells = cells.size();
   if (output_ctrl_ > 0) {
     std::cout << "Constructing mesh: " << no_of_nodes << " nodes" << std::endl;
   }
 
+  // Entity of the source mesh retained as entity `idx` of codimension `codim`,
+  // nullptr for new entities
+  const bool has_retained = (geometry_source_ != nullptr);
+  if (has_retained) {
+    LF_VERIFY_MSG(retained.entities[0].size() == no_of_cells &&
+                      retained.entities[1].size() == edges.size() &&
+                      retained.entities[2].size() == no_of_nodes,
+                  "Retained entities do not match lists of entities");
+  }
+  auto retained_entity = [&retained, has_retained](
+                             dim_t codim,
+                             size_type idx) -> const mesh::Entity * {
+    return has_retained ? retained.entities[codim][idx] : nullptr;
+  };
+  // Geometry of a cell, supplied or shared with a retained cell
+  auto cell_geometry = [&cells, &retained_entity](
+                           size_type cell_idx) -> geometry::Geometry * {
+    if (cells[cell_idx].second != nullptr) {
+      return cells[cell_idx].second.get();
+    }
+    const mesh::Entity *source_cell = retained_entity(0, cell_idx);
+    return (source_cell != nullptr) ? source_cell->Geometry() : nullptr;
+  };
+
   // ======================================================================
-  // STEP I: Initialize array of edges using pointers to
-  //          entries of the array of nodes
+  // Retained cells whose edges are all retained are taken over as they are:
+  // their edges are known and need not be identified. Only the edges of the
+  // remaining "patch" cells are looked up below.
+  std::vector<std::array<size_type, 4>> edge_indices(no_of_cells);
+  std::vector<bool> is_patch_cell;
+  std::vector<bool> is_patch_node;
+  std::vector<bool> edge_has_retained_cell;
+  if (has_retained) {
+    is_patch_cell.assign(no_of_cells, true);
+    is_patch_node.assign(no_of_nodes, false);
+    edge_has_retained_cell.assign(edges.size(), false);
+    for (size_type c = 0; c < no_of_cells; ++c) {
+      const mesh::Entity *source_cell = retained.entities[0][c];
+      if (source_cell != nullptr) {
+        // For now edge_indices holds the indices of the new edges
+        auto source_edges = source_cell->SubEntities(1);
+        bool all_edges_retained = true;
+        for (Eigen::Index j = 0; j < source_edges.size(); ++j) {
+          edge_indices[c][j] =
+              retained.edge_index[geometry_source_->Index(*source_edges[j])];
+          all_edges_retained =
+              all_edges_retained && (edge_indices[c][j] != idx_nil);
+        }
+        if (all_edges_retained) {
+          is_patch_cell[c] = false;
+          for (Eigen::Index j = 0; j < source_edges.size(); ++j) {
+            edge_has_retained_cell[edge_indices[c][j]] = true;
+          }
+          continue;
+        }
+      }
+      for (size_type node : cells[c].first) {
+        if (node != idx_nil) {
+          LF_VERIFY_MSG(node < no_of_nodes, "Cell " << c << ": invalid node "
+                                                    << node);
+          is_patch_node[node] = true;
+        }
+      }
+    }
+  }
+
+  // Edges are identified by the (unordered) pair of their endpoints. Instead of
+  // looking up each edge in an ordered map, all occurrences of edges (in the
+  // list of supplied edges and as edges of cells) are collected in an array
+  // which is then sorted by a packed 64-bit key of the endpoint indices.
+  // Every run of equal keys corresponds to one edge.
+  std::vector<EdgeOccurrence> occurrences;
+  occurrences.reserve(edges.size() + 4 * cells.size());
+
+  // ======================================================================
+  // STEP I: Register supplied edges
 
-  // Register supplied edges in auxiliary map data structure
   if (output_ctrl_ > 0) {
-    std::cout << "Initializing edge map" << std::endl;
+    std::cout << "Registering supplied edges" << std::endl;
   }
-  EdgeMap edge_map;
   glb_idx_t edge_index = 0;  // position in the array gives index of edge
+  // Retained edges not connecting two nodes of patch cells cannot belong to a
+  // patch cell. They are taken over in Step IV without being registered.
+  std::vector<size_type> direct_edges;
 
   for (auto &e : edges) {
     // Node indices of endpoints: the KEY
     std::array<size_type, 2> end_nodes(e.first);
-    EndpointIndexPair e_endpoint_idx(end_nodes[0], end_nodes[1]);
     LF_ASSERT_MSG(
         (end_nodes[0] < no_of_nodes) && (end_nodes[1] < no_of_nodes),
         "Illegal edge node numbers " << end_nodes[0] << ", " << end_nodes[1]);
@@ -250,62 +308,45 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
       std::cout << "Register edge: " << end_nodes[0] << " <-> " << end_nodes[1]
                 << std::endl;
     }
+    if (retained_entity(1, edge_index) != nullptr) {
+      if (!is_patch_node[end_nodes[0]] || !is_patch_node[end_nodes[1]]) {
+        direct_edges.push_back(edge_index);
+      } else {
+        occurrences.push_back(
+            {EdgeKey(end_nodes[0], end_nodes[1]), idx_nil, edge_index});
+      }
+      edge_index++;
+      continue;
+    }
 
     // If one of the endpoints of a edge does not have a geometry, supply it
     // with one inherited from the edge.
     for (int j = 0; j < 2; ++j) {
-      if (nodes[end_nodes[j]] == nullptr) {
+      if (nodes[end_nodes[j]] == nullptr &&
+          retained_entity(2, end_nodes[j]) == nullptr) {
         // if no geometry for node exists request geomtry for an endpoint of the
         // edge Note: endpoints are entities of relative co-dimension 1
         nodes[end_nodes[j]] = e.second->SubGeometry(1, j);
       }
     }
 
-    // Store provided geometry information; information on adjacent cells
-    // not yet available.
+    // Edge geometry is mandatory for supplied edges
     LF_ASSERT_MSG(e.second != nullptr,
                   "Edge " << edge_index << ": missing geometry!");
-    AdjCellsList empty_cells_list{};
-    EdgeData edge_data(std::move(e.second), empty_cells_list, edge_index);
-    EdgeMap::value_type edge_info =
-        std::make_pair(e_endpoint_idx, std::move(edge_data));
-    std::pair<EdgeMap::iterator, bool> insert_status =
-        edge_map.insert(std::move(edge_info));
-    LF_ASSERT_MSG(insert_status.second,
-                  "Duplicate edge " << end_nodes[0] << " <-> " << end_nodes[1]);
+    occurrences.push_back(
+        {EdgeKey(end_nodes[0], end_nodes[1]), idx_nil, edge_index});
 
     edge_index++;
   }  // end loop over predefined edges
   // ======================================================================
 
   // ======================================================================
-  // Step II: Building edge map from cell information
+  // Step II: Register the edges of all cells
   //
-  // At this point all predefined edges have been stored in the auxiliary
-  // associative array, though without information about adjacent cells.
   // The variable edge_index contains the number of edges with externally
   // supplied geometry. The indexing of all extra edges created below must start
   // from this offset.
 
-  if (output_ctrl_ > 10) {
-    std::cout << "Edge map after edge registration" << std::endl;
-    for (auto &edge_info : edge_map) {
-      const EndpointIndexPair &eip(edge_info.first);
-      const EdgeData &edat(edge_info.second);
-      std::cout << "Edge " << eip.first_node() << " <-> " << eip.second_node()
-                << ": ";
-      const AdjCellsList &acl(edat.adj_cells_list);
-      const GeometryPtr &gptr(edat.geo_uptr);
-      for (auto &i : acl) {
-        std::cout << "[" << i.cell_idx << "," << i.edge_idx << "] ";
-      }
-      std::cout << std::endl;
-    }
-  }
-
-  // Run through cells in order to
-  // (i) build edges missing in the list of predefined edges
-  // (ii) determine cells adjacent to edges
   size_type cell_index = 0;
   size_type no_of_trilaterals = 0;
   size_type no_of_quadrilaterals = 0;
@@ -318,7 +359,7 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
     // node indices of corners of cell c
     const std::array<size_type, 4> &cell_node_list(c.first);
     // Geometry of current cell
-    const GeometryPtr &cell_geometry(c.second);
+    geometry::Geometry *const cell_geo = cell_geometry(cell_index);
     // Can be either a trilateral or a quadrilateral
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     // A triangle is marked by an invalid node number
@@ -352,87 +393,45 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
                             << ": invalid index " << cell_node_list[l]);
     }
 
+    // The edges of retained cells outside the patch are already known
+    if (has_retained && !is_patch_cell[cell_index]) {
+      cell_index++;
+      if (output_ctrl_ > 10) {
+        std::cout << "retained" << std::endl;
+      }
+      continue;
+    }
+
     // If the cell has a geometry, it can be used to generate the
     // geometry for its vertices through the SubGeometry() method of Geometry
     // objects
-    if (cell_geometry != nullptr) {
+    if (cell_geo != nullptr) {
       for (unsigned j = 0; j < no_of_vertices; ++j) {
-        if (nodes[cell_node_list[j]] == nullptr) {
+        if (nodes[cell_node_list[j]] == nullptr &&
+            retained_entity(2, cell_node_list[j]) == nullptr) {
           // if no geometry for node exists request geomtry for an vertex from
           // the cell Note: vertices are entities of relative co-dimension 2
-          nodes[cell_node_list[j]] = cell_geometry->SubGeometry(2, j);
+          nodes[cell_node_list[j]] = cell_geo->SubGeometry(2, j);
         }
       }
     }
 
-    //  A variant:
-    //    There may be cells without a specified geometry.
-    //    In case an edge is not equipped with a geometry and not
-    //    adjacent to a cell with a specific geometry, assume a straight
-    //    edge connecting the two endpoints.
-    //
-
-    // Visit all edges of the current cell
+    // Register all edges of the current cell
     for (unsigned int j = 0; j < ref_el.NumSubEntities(1); j++) {
       // Fetch local indices of endpoints of edge j
       const size_type p0_local_index =
           ref_el.SubSubEntity2SubEntity(1, j, 1, 0);
       const size_type p1_local_index =
           ref_el.SubSubEntity2SubEntity(1, j, 1, 1);
-      // Fetch global indices of the endnodes of edge j
-      EndpointIndexPair c_edge_vertex_indices(cell_node_list[p0_local_index],
-                                              cell_node_list[p1_local_index]);
-
       if (output_ctrl_ > 10) {
         std::cout << "e(" << j << ") = local " << p0_local_index << " <-> "
                   << p1_local_index << ", global "
-                  << c_edge_vertex_indices.first_node() << " <-> "
-                  << c_edge_vertex_indices.second_node() << " # ";
+                  << cell_node_list[p0_local_index] << " <-> "
+                  << cell_node_list[p1_local_index] << " # ";
       }
-      // Store number of cell and the local index j of the edge
-      AdjCellInfo edge_cell_info(cell_index, j);
-      // Check whether edge exists already
-      auto edge_ptr = edge_map.find(c_edge_vertex_indices);
-      if (edge_ptr == edge_map.end()) {
-        // Inherit geometry of edge from adjacent cell
-        GeometryPtr edge_geo_ptr;
-        if (cell_geometry) {
-          edge_geo_ptr = cell_geometry->SubGeometry(1, j);
-        }
-        // Beginning of list of adjacent elements
-        AdjCellsList single_cell_list{edge_cell_info};
-        EdgeData edge_data(std::move(edge_geo_ptr), single_cell_list);
-        std::pair<EdgeMap::iterator, bool> insert_status = edge_map.insert(
-            std::make_pair(c_edge_vertex_indices, std::move(edge_data)));
-        LF_ASSERT_MSG(insert_status.second, "Duplicate not found earlier!");
-        edge_ptr = insert_status.first;  // pointer to newly inserted edge
-      } else {
-        // Here *edge_ptr is a valid std::pair<EndpointIndexPair,EdgeData>
-
-        // Store information about neighboring cell
-        AdjCellsList &edge_adj_cellslist((edge_ptr->second).adj_cells_list);
-        edge_adj_cellslist.push_back(edge_cell_info);
-        // Check, if the edge possesses geometry information
-        GeometryPtr &edge_supplied_geo_uptr((*edge_ptr).second.geo_uptr);
-        if (edge_supplied_geo_uptr == nullptr) {
-          // Edge does not know its geometry yet. Try to obtain it from the
-          // cell.
-          if (cell_geometry) {
-            edge_supplied_geo_uptr =
-                std::move(cell_geometry->SubGeometry(1, j));
-            // NOTE: the local orientation of the edge of the cell and that
-            // pointed to by edge_ptr can differ. In this case the
-            // endpoints of the edge have to be swapped. To detect orientation
-            // mismatch, compare c_edge_vertex_indices (cell infomation) and
-            // edge_ptr->first (edge information)
-            if (!coincide(c_edge_vertex_indices, edge_ptr->first)) {
-              // Reverse the direction of the edge
-              (edge_ptr->second).reversed = true;
-            }
-          }
-        }
-      }
-      // At this point edge_ptr points to the map entry for the current edge
+      occurrences.push_back({EdgeKey(cell_node_list[p0_local_index],
+                                     cell_node_list[p1_local_index]),
+                             cell_index, j});
     }  // end of loop over edges
     cell_index++;
 
@@ -442,42 +441,25 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
     }
   }  // end loop over cells
 
-  // DIAGNOSTICS
-  {
-    if (output_ctrl_ > 0) {
-      std::cout << "=============================================" << std::endl;
+  // ======================================================================
+  // Step III: Identify the edges
+  //
+  // After a stable sort the occurrences of an edge are contiguous. A supplied
+  // edge precedes the occurrences in cells and the cells appear in the order of
+  // their indices. The edges are thus ordered lexicographically by their
+  // endpoint indices (smaller first).
+  SortByKey(occurrences);
+
+  // first_occurrence[k] points to the first occurrence of edge k
+  std::vector<std::size_t> first_occurrence;
+  for (std::size_t i = 0; i < occurrences.size(); ++i) {
+    if (i == 0 || occurrences[i].key != occurrences[i - 1].key) {
+      first_occurrence.push_back(i);
     }
-    if (output_ctrl_ > 10) {
-      std::cout << "Edge map after cell scan" << std::endl;
-      size_type edge_cnt = 0;
-      for (auto &edge_info : edge_map) {
-        const EndpointIndexPair &eip(edge_info.first);
-        const EdgeData &edat(edge_info.second);
-        std::cout << "Edge " << edge_cnt << ": " << eip.first_node() << " <-> "
-                  << eip.second_node();
-        if (edat.edge_global_index == -1) {
-          std::cout << " no index : ";
-        } else {
-          std::cout << ": index = " << edat.edge_global_index << ": ";
-        }
-        const AdjCellsList &acl(edat.adj_cells_list);
-        const GeometryPtr &gptr(edat.geo_uptr);
-        for (auto &i : acl) {
-          std::cout << "[" << i.cell_idx << "," << i.edge_idx << "] ";
-        }
-        std::cout << " geo = " << std::endl;
-        if (gptr) {
-          Eigen::MatrixXd edp_c(
-              gptr->Global(base::RefEl::kSegment().NodeCoords()));
-          std::cout << edp_c << std::endl;
-        } else {
-          std::cout << "NO GEOMETRY" << std::endl;
-        }
-        edge_cnt++;
-      }
-      std::cout << "=============================================" << std::endl;
-    }  // end if(output_ctrl > 10)
   }
+  const size_type no_of_sorted_edges = first_occurrence.size();
+  first_occurrence.push_back(occurrences.size());
+  const size_type no_of_edges = no_of_sorted_edges + direct_edges.size();
 
   // ======================================================================
   // NEXT STEP : Set up and fill array of nodes: points_
@@ -490,6 +472,12 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
     // OLD VERSION. In the new version the geomtry of a point is passed in
     // 'nodes' const Eigen::VectorXd &node_coordinates(v); GeometryPtr point_geo
     // = std::make_unique<geometry::Point>(node_coordinates);
+    if (const mesh::Entity *source_node = retained_entity(2, node_index)) {
+      // Retained node: shares the geometry of the node of the source mesh
+      points_.emplace_back(node_index, source_node->Geometry());
+      node_index++;
+      continue;
+    }
     LF_VERIFY_MSG(pt_geo_ptr != nullptr,
                   "Missing geometry for node " << node_index);
     if (output_ctrl_ > 10) {
@@ -502,10 +490,166 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
     node_index++;
   }
 
-  // Run through the entire associative container for edges
-  // and build edge Entities
-  // This is the length to be reserved for the edge vector
-  size_type no_of_edges = edge_map.size();
+  // ======================================================================
+  // Step IV: Gather the information about every edge from its occurrences
+  //
+  // The edges are independent of each other and are processed concurrently.
+  // Since every occurrence in a cell belongs to exactly one edge, the
+  // auxiliary array `edge_indices`, which stores the edge indices for all cells
+  // can be filled without synchronization. The retained edges that were not
+  // registered come after the sorted edges.
+  std::vector<EdgeData> edge_data(no_of_edges);
+  // position in edge_data of every supplied edge, only needed for the edges
+  // of retained cells
+  std::vector<size_type> edge_position;
+  if (has_retained) {
+    edge_position.assign(edges.size(), idx_nil);
+  }
+
+  // global indices of the endpoints of edge j of a cell (cell orientation)
+  auto cell_edge_endpoints = [&cells](size_type cell_idx, size_type j) {
+    const std::array<size_type, 4> &cell_node_list(cells[cell_idx].first);
+    const base::RefEl ref_el = (cell_node_list[3] == idx_nil)
+                                   ? base::RefEl::kTria()
+                                   : base::RefEl::kQuad();
+    return std::array<size_type, 2>{
+        cell_node_list[ref_el.SubSubEntity2SubEntity(1, j, 1, 0)],
+        cell_node_list[ref_el.SubSubEntity2SubEntity(1, j, 1, 1)]};
+  };
+
+  lf::base::ParallelForChunks(
+      no_of_sorted_edges, NumChunks(occurrences.size()),
+      [&](unsigned int /*chunk*/, std::size_t edge_begin,
+          std::size_t edge_end) {
+        for (std::size_t k = edge_begin; k < edge_end; ++k) {
+          EdgeData &edat(edge_data[k]);
+          auto occ = occurrences.begin() + first_occurrence[k];
+          const auto occ_end = occurrences.begin() + first_occurrence[k + 1];
+          if (occ->cell_idx == idx_nil) {
+            // Supplied edge: fixes index, orientation and geometry
+            auto &e = edges[occ->edge_idx];
+            edat.p0 = e.first[0];
+            edat.p1 = e.first[1];
+            edat.geo_uptr = std::move(e.second);
+            edat.edge_global_index = occ->edge_idx;
+            if (has_retained) {
+              edge_position[occ->edge_idx] = k;
+              if (const mesh::Entity *source_edge =
+                      retained_entity(1, occ->edge_idx)) {
+                edat.shared_geo = source_edge->Geometry();
+              }
+            }
+            ++occ;
+            LF_ASSERT_MSG(occ == occ_end || occ->cell_idx != idx_nil,
+                          "Duplicate edge " << edat.p0 << " <-> " << edat.p1);
+          } else {
+            // Edge created from a cell: the first cell fixes the orientation
+            const std::array<size_type, 2> endpoints =
+                cell_edge_endpoints(occ->cell_idx, occ->edge_idx);
+            edat.p0 = endpoints[0];
+            edat.p1 = endpoints[1];
+          }
+          edat.has_adjacent_cell =
+              (occ != occ_end) ||
+              (has_retained && edat.edge_global_index != idx_nil &&
+               edge_has_retained_cell[edat.edge_global_index]);
+          for (; occ != occ_end; ++occ) {
+            const size_type adj_cell_index = occ->cell_idx;
+            const size_type edge_local_index = occ->edge_idx;
+            LF_ASSERT_MSG(adj_cell_index < no_of_cells,
+                          "adj_cell_idx out of bounds");
+            edge_indices[adj_cell_index][edge_local_index] = k;
+            // Edge does not know its geometry yet. Try to obtain it from the
+            // first cell that has a geometry.
+            geometry::Geometry *const cell_geo = cell_geometry(adj_cell_index);
+            if (edat.geo_uptr == nullptr && edat.shared_geo == nullptr &&
+                cell_geo != nullptr) {
+              edat.geo_uptr = cell_geo->SubGeometry(1, edge_local_index);
+              // NOTE: the local orientation of the edge of the cell and that
+              // of the edge can differ. In this case the endpoints of the edge
+              // have to be swapped.
+              if (cell_edge_endpoints(adj_cell_index, edge_local_index)[0] !=
+                  edat.p0) {
+                std::swap(edat.p0, edat.p1);
+              }
+            }
+          }
+          if (!edat.geo_uptr && edat.shared_geo == nullptr) {
+            // If the edge does not have a geometry build a straight edge
+            Eigen::Matrix<double, 2, 2> straight_edge_coords;
+            straight_edge_coords.block<2, 1>(0, 0) =
+                points_[edat.p0].Geometry()->Global(zero_point);
+            straight_edge_coords.block<2, 1>(0, 1) =
+                points_[edat.p1].Geometry()->Global(zero_point);
+            edat.geo_uptr =
+                std::make_unique<geometry::SegmentO1>(straight_edge_coords);
+          }
+        }
+      });
+
+  // Retained edges outside the patch and the edges of retained cells
+  for (std::size_t i = 0; i < direct_edges.size(); ++i) {
+    const size_type k = no_of_sorted_edges + i;
+    const size_type supplied_idx = direct_edges[i];
+    EdgeData &edat(edge_data[k]);
+    edat.p0 = edges[supplied_idx].first[0];
+    edat.p1 = edges[supplied_idx].first[1];
+    edat.shared_geo = retained.entities[1][supplied_idx]->Geometry();
+    edat.edge_global_index = supplied_idx;
+    edat.has_adjacent_cell = edge_has_retained_cell[supplied_idx];
+    edge_position[supplied_idx] = k;
+  }
+  if (has_retained) {
+    for (size_type c = 0; c < no_of_cells; ++c) {
+      if (!is_patch_cell[c]) {
+        const size_type no_of_cell_edges =
+            (cells[c].first[3] == idx_nil) ? 3 : 4;
+        for (size_type j = 0; j < no_of_cell_edges; ++j) {
+          edge_indices[c][j] = edge_position[edge_indices[c][j]];
+        }
+      }
+    }
+  }
+
+  // DIAGNOSTICS
+  {
+    if (output_ctrl_ > 0) {
+      std::cout << "=============================================" << std::endl;
+    }
+    if (output_ctrl_ > 10) {
+      std::cout << "Edges after cell scan" << std::endl;
+      for (size_type k = 0; k < no_of_edges; ++k) {
+        const EdgeData &edat(edge_data[k]);
+        std::cout << "Edge " << k << ": " << edat.p0 << " <-> " << edat.p1;
+        if (edat.edge_global_index == idx_nil) {
+          std::cout << " no index : ";
+        } else {
+          std::cout << ": index = " << edat.edge_global_index << ": ";
+        }
+        if (k < no_of_sorted_edges) {
+          for (std::size_t i = first_occurrence[k];
+               i < first_occurrence[k + 1]; ++i) {
+            if (occurrences[i].cell_idx != idx_nil) {
+              std::cout << "[" << occurrences[i].cell_idx << ","
+                        << occurrences[i].edge_idx << "] ";
+            }
+          }
+        } else {
+          std::cout << "retained ";
+        }
+        std::cout << " geo = " << std::endl;
+        const geometry::Geometry *edge_geo =
+            edat.geo_uptr ? edat.geo_uptr.get() : edat.shared_geo;
+        Eigen::MatrixXd edp_c(
+            edge_geo->Global(base::RefEl::kSegment().NodeCoords()));
+        std::cout << edp_c << std::endl;
+      }
+      std::cout << "=============================================" << std::endl;
+    }  // end if(output_ctrl > 10)
+  }
+
+  // ======================================================================
+  // Step V: Build the edge entities in the order of their keys
 
   // Initialized vector of Edge entities here
   segments_.reserve(no_of_edges);
@@ -520,46 +664,16 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
   // Note: the variable edge_index contains the number externally supplied
   // edges, whose index must agree with their position in the
   // 'edges' array.
-
-  // Note: iteration variable cannot be declared const, because
-  // moving the geometry pointer changes it!
-  for (EdgeMap::value_type &edge : edge_map) {
-    // Indices of the two endpoints of the current edge
-    // Use this to obtain pointers/references to nodes
-    // from the vector of nodes
-    size_type p0(edge.first.first_node());   // index of first endpoint
-    size_type p1(edge.first.second_node());  // index of second endpoint
-
-    // Swap the indices of the endpoints in case of a geometry mismatch
-    // that requires a reversal of orientation.
-    if (edge.second.reversed) {
-      std::swap(p0, p1);
-    }
-
-    const Point *p0_ptr = &points_[p0];  // pointer to first endpoint
-    const Point *p1_ptr = &points_[p1];  // pointer to second endpoint
-
-    // obtain geometry of the edge
-    GeometryPtr edge_geo_ptr(std::move(edge.second.geo_uptr));
-    if (!edge_geo_ptr) {
-      // If the edge does not have a geometry build a straight edge
-      Eigen::Matrix<double, 2, 2> straight_edge_coords;
-      straight_edge_coords.block<2, 1>(0, 0) =
-          p0_ptr->Geometry()->Global(zero_point);
-      straight_edge_coords.block<2, 1>(0, 1) =
-          p1_ptr->Geometry()->Global(zero_point);
-      edge_geo_ptr =
-          std::make_unique<geometry::SegmentO1>(straight_edge_coords);
-    }
+  for (EdgeData &edat : edge_data) {
     // Determine index of current edge. Two cases have to be distinguished:
     // (i) the edge geometry was specified in the `edges` argument. In this case
     // the edge index must agree with its possition in that array. This position
     /// is stored in the 'edge_global_index' field of the EdgeData structure.
     // (ii) the edge has to be created internally. In this case assign an index
     // larger than the index of any supplied edge.
-    if (edge.second.edge_global_index == idx_nil) {
+    if (edat.edge_global_index == idx_nil) {
       // Internally created edge needs new index.
-      edge.second.edge_global_index = edge_index;
+      edat.edge_global_index = edge_index;
       // Increment 'edge_index', which will give the index of the next
       // internally created edge
       edge_index++;
@@ -567,24 +681,29 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
 
     if (check_completeness) {
       // record that the nodes of this edge have a super-entity (this edge):
-      nodeHasSuperEntity[p0] = true;
-      nodeHasSuperEntity[p1] = true;
+      nodeHasSuperEntity[edat.p0] = true;
+      nodeHasSuperEntity[edat.p1] = true;
 
       // make sure that the edge belongs to at least one cell:
-      LF_VERIFY_MSG(!edge.second.adj_cells_list.empty(),
+      LF_VERIFY_MSG(edat.has_adjacent_cell,
                     "Mesh is incomplete: Edge with global index "
-                        << edge.second.edge_global_index
+                        << edat.edge_global_index
                         << " does not belong to a cell.");
     }
 
     // Diagnostics
     if (output_ctrl_ > 10) {
-      std::cout << "Registering edge " << edge.second.edge_global_index << ": "
-                << p0 << " <-> " << p1 << std::endl;
+      std::cout << "Registering edge " << edat.edge_global_index << ": "
+                << edat.p0 << " <-> " << edat.p1 << std::endl;
     }
     // Building edge by adding another element to the edge vector.
-    segments_.emplace_back(edge.second.edge_global_index,
-                           std::move(edge_geo_ptr), p0_ptr, p1_ptr);
+    if (edat.shared_geo != nullptr) {
+      segments_.emplace_back(edat.edge_global_index, edat.shared_geo,
+                             &points_[edat.p0], &points_[edat.p1]);
+    } else {
+      segments_.emplace_back(edat.edge_global_index, std::move(edat.geo_uptr),
+                             &points_[edat.p0], &points_[edat.p1]);
+    }
   }  // end loop over all edges
   LF_ASSERT_MSG(edge_index == no_of_edges, "Edge index mismatch");
 
@@ -599,30 +718,6 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
   // ======================================================================
   // NEXT STEP: Create cells
 
-  const size_type no_of_cells = cells.size();
-
-  // Create an auxiliary data structure to store the edges for the cells
-  // For every cell and its edges the global edge index is extracted
-  // from the auxiliary associative array.
-  std::vector<std::array<size_type, 4>> edge_indices(no_of_cells);
-
-  size_type edge_array_position = 0;  // actual position in edge array
-  for (const EdgeMap::value_type &edge : edge_map) {
-    // Obtain array of indices of adjacent cells
-    AdjCellsList adjacent_cells(edge.second.adj_cells_list);
-    for (const auto &adj_cell : adjacent_cells) {
-      const size_type adj_cell_index = adj_cell.cell_idx;
-      // Local index of edge in adjacent cell
-      const size_type edge_local_index = adj_cell.edge_idx;
-      LF_ASSERT_MSG(adj_cell_index < no_of_cells, "adj_cell_idx out of bounds");
-      LF_ASSERT_MSG(edge_local_index < cells[adj_cell_index].first.size(),
-                    "local edge index out of bounds");
-      // Set edge index in auxiliary cell matrix
-      edge_indices[adj_cell_index][edge_local_index] = edge_array_position;
-    }
-    edge_array_position++;
-  }
-
   // Diagnostics
   if (output_ctrl_ > 10) {
     std::cout << "########################################" << std::endl;
@@ -663,6 +758,8 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
 
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     GeometryPtr c_geo_ptr(std::move(c.second));
+    // A retained cell shares the geometry of the cell of the source mesh
+    const mesh::Entity *source_cell = retained_entity(0, cell_index);
     if (no_of_vertices == 3) {
       // Case of a trilateral
 
@@ -686,7 +783,7 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
       const Segment *edge0 = &segments_[c_edge_indices[0]];
       const Segment *edge1 = &segments_[c_edge_indices[1]];
       const Segment *edge2 = &segments_[c_edge_indices[2]];
-      if (!c_geo_ptr) {
+      if (!c_geo_ptr && source_cell == nullptr) {
         // Cell is lacking a geometry and its shape has to
         // be determined from the shape of the edges or
         // location of the vertices
@@ -713,8 +810,13 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
         // If blended geometries are available, a cell could also
         // inherit its geometry from the edges
       }
-      trias_.emplace_back(cell_index, std::move(c_geo_ptr), corner0, corner1,
-                          corner2, edge0, edge1, edge2);
+      if (source_cell != nullptr) {
+        trias_.emplace_back(cell_index, source_cell->Geometry(), corner0,
+                            corner1, corner2, edge0, edge1, edge2);
+      } else {
+        trias_.emplace_back(cell_index, std::move(c_geo_ptr), corner0,
+                            corner1, corner2, edge0, edge1, edge2);
+      }
     } else {
       // Case of a quadrilateral
 
@@ -741,7 +843,7 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
       const Segment *edge1 = &segments_[c_edge_indices[1]];
       const Segment *edge2 = &segments_[c_edge_indices[2]];
       const Segment *edge3 = &segments_[c_edge_indices[3]];
-      if (!c_geo_ptr) {
+      if (!c_geo_ptr && source_cell == nullptr) {
         // Cell is lacking a geometry and its shape has to
         // be determined from the shape of the edges or
         // location of the vertices
@@ -768,8 +870,15 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
 
         c_geo_ptr = std::make_unique<geometry::QuadO1>(quad_corner_coords);
       }
-      quads_.emplace_back(cell_index, std::move(c_geo_ptr), corner0, corner1,
-                          corner2, corner3, edge0, edge1, edge2, edge3);
+      if (source_cell != nullptr) {
+        quads_.emplace_back(cell_index, source_cell->Geometry(), corner0,
+                            corner1, corner2, corner3, edge0, edge1, edge2,
+                            edge3);
+      } else {
+        quads_.emplace_back(cell_index, std::move(c_geo_ptr), corner0,
+                            corner1, corner2, corner3, edge0, edge1, edge2,
+                            edge3);
+      }
     }
     cell_index++;
   }
@@ -784,8 +893,8 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
 
   // First retrieve pointers to triangular cells
   for (int j = 0; j < trias_.size(); j++, cell_ptr_cnt++) {
-    // Fetch index of a triangle  by a non-virtual call to Index()
-    const glb_idx_t cell_index = lf::mesh::hybrid2d::Mesh::Index(trias_[j]);
+    // Fetch index of a triangle
+    const glb_idx_t cell_index = trias_[j].index();
     LF_ASSERT_MSG(cell_index < entity_pointers_[0].size(),
                   "Cell index out of range");
     // This index must be unique !
@@ -796,8 +905,8 @@ Mesh::Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
 
   // Second deal with the quadrilateral cells
   for (int j = 0; j < quads_.size(); j++, cell_ptr_cnt++) {
-    // Fetch index of a quadrilateral by a non-virtual call to Index()
-    const glb_idx_t cell_index = lf::mesh::hybrid2d::Mesh::Index(quads_[j]);
+    // Fetch index of a quadrilateral
+    const glb_idx_t cell_index = quads_[j].index();
     LF_ASSERT_MSG(cell_index < entity_pointers_[0].size(),
                   "Cell index out of range");
     // This index must be unique !
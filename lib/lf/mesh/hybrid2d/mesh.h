@@ -41,7 +41,6 @@ class Mesh : public mesh::Mesh {
   [[nodiscard]] size_type NumEntities(unsigned codim) const override;
   [[nodiscard]] size_type NumEntities(
       lf::base::RefEl ref_el_type) const override;
-  [[nodiscard]] size_type Index(const Entity& e) const override;
   [[nodiscard]] const mesh::Entity* EntityByIndex(
       dim_t codim, glb_idx_t index) const override;
   [[nodiscard]] bool Contains(const mesh::Entity& e) const override;
@@ -65,6 +64,13 @@ class Mesh : public mesh::Mesh {
    */
   std::array<std::vector<const mesh::Entity*>, 3> entity_pointers_;
 
+  /** @brief Mesh owning the geometry objects shared by retained entities
+   *
+   * Empty unless the mesh was built with retained entities, see
+   * MeshFactory::RetainEntity().
+   */
+  std::shared_ptr<const mesh::Mesh> geometry_source_;
+
   /** @brief Data types for passing information about mesh intities */
   using GeometryPtr = std::unique_ptr<geometry::Geometry>;
   using NodeCoordList = std::vector<GeometryPtr>;
@@ -73,6 +79,23 @@ class Mesh : public mesh::Mesh {
   using CellList =
       std::vector<std::pair<std::array<size_type, 4>, GeometryPtr>>;
 
+  /** @brief Entities of another mesh taken over by the new mesh
+   *
+   * The geometry objects of retained entities are not copied but shared with
+   * the `source` mesh. For a retained entity the corresponding entry of the
+   * node, edge or cell list carries no geometry.
+   */
+  struct RetainedEntities {
+    /** @brief mesh owning the retained entities, nullptr if there are none */
+    std::shared_ptr<const mesh::Mesh> source;
+    /** @brief for every codimension and every entity of the new mesh the
+     * retained entity of `source`, nullptr for new entities */
+    std::array<std::vector<const mesh::Entity*>, 3> entities;
+    /** @brief index of the new edge for every edge of `source`, idx_nil for
+     * edges that are not retained */
+    std::vector<size_type> edge_index;
+  };
+
   /**
    * @brief Construction of mesh from information gathered in a MeshFactory
    * @param dim_world Dimension of the ambient space.
@@ -123,9 +146,17 @@ class Mesh : public mesh::Mesh {
    *        determines the interpretation of the index numbers,
    *        that is the n-th node in the container has index n-1.
    *
+   * ### Retained entities
+   *
+   * Entities listed in `retained` share their geometry with an entity of
+   * another mesh, which is kept alive by the new mesh. Only the edges
+   * connecting nodes of non-retained cells have to be identified from the
+   * cells; the edges of a retained cell whose edges are all retained are known
+   * beforehand. This makes building a mesh that differs from another one only
+   * in a small patch, as in local refinement, considerably cheaper.
    */
   Mesh(dim_t dim_world, NodeCoordList nodes, EdgeList edges, CellList cells,
-       bool check_completeness);
+       bool check_completeness, RetainedEntities retained = {});
 
   friend class MeshFactory;
 
@@ -1,13 +1,41 @@
 #include "mesh_factory.h"
 #include "hybrid2d.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
 
 namespace lf::mesh::hybrid2d {
 
 ADDOPTION(MeshFactory::output_ctrl_, hybrid2dmf_output_ctrl,
           "Enables printing of internal lists for MeshFactory");
 
+namespace /* anonymous */ {
+
+// Position of the point (x,y) of a 2^16 x 2^16 grid along the Hilbert curve
+// traversing the grid
+std::uint64_t HilbertCurveIndex(std::uint32_t x, std::uint32_t y) {
+  constexpr std::uint32_t n = 1U << 16U;
+  std::uint64_t d = 0;
+  for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+    const std::uint32_t rx = (x & s) > 0 ? 1 : 0;
+    const std::uint32_t ry = (y & s) > 0 ? 1 : 0;
+    d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant
+    if (ry == 0) {
+      if (rx == 1) {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+}  // namespace
+
 MeshFactory::size_type MeshFactory::AddPoint(coord_t coord) {
   LF_ASSERT_MSG(coord.rows() == dim_world_,
                 "coord has incompatible number of rows.");
@@ -95,26 +123,266 @@ MeshFactory::size_type MeshFactory::AddEntity(
   return elements_.size() - 1;
 }
 
+MeshFactory::size_type MeshFactory::RetainEntity(
+    const std::shared_ptr<const mesh::Mesh>& mesh, const mesh::Entity& entity) {
+  LF_ASSERT_MSG(mesh != nullptr, "No mesh given");
+  LF_ASSERT_MSG(mesh->DimWorld() == dim_world_,
+                "mesh->DimWorld() != dim_world_");
+  if (retained_.source == nullptr) {
+    retained_.source = mesh;
+    for (dim_t codim = 0; codim <= 2; ++codim) {
+      retained_index_[codim].assign(mesh->NumEntities(codim), idx_nil);
+    }
+  }
+  LF_VERIFY_MSG(retained_.source == mesh,
+                "All retained entities must belong to the same mesh");
+  const dim_t codim = entity.Codim();
+  const size_type source_index = mesh->Index(entity);
+  LF_ASSERT_MSG(retained_index_[codim][source_index] == idx_nil,
+                "Entity " << source_index << " of codim " << codim
+                          << " retained twice");
+
+  // Indices of the vertices in the new mesh, idx_nil marks a triangle
+  std::array<size_type, 4> ns{idx_nil, idx_nil, idx_nil, idx_nil};
+  if (codim < 2) {
+    auto vertices = entity.SubEntities(2 - codim);
+    for (Eigen::Index j = 0; j < vertices.size(); ++j) {
+      ns[j] = retained_index_[2][mesh->Index(*vertices[j])];
+      LF_VERIFY_MSG(ns[j] != idx_nil,
+                    "Vertices must be retained before " << entity.RefEl());
+    }
+  }
+
+  // The entity is added without geometry, which is taken from the source
+  // entity by the mesh
+  std::vector<const mesh::Entity*>& source_entities =
+      retained_.entities[codim];
+  size_type new_index;
+  switch (codim) {
+    case 2: {
+      new_index = nodes_.size();
+      nodes_.emplace_back(nullptr);
+      break;
+    }
+    case 1: {
+      new_index = edges_.size();
+      edges_.emplace_back(std::array<size_type, 2>{ns[0], ns[1]}, nullptr);
+      break;
+    }
+    default: {
+      new_index = elements_.size();
+      elements_.emplace_back(ns, nullptr);
+      break;
+    }
+  }
+  source_entities.resize(new_index, nullptr);
+  source_entities.push_back(&entity);
+  retained_index_[codim][source_index] = new_index;
+  return new_index;
+}
+
 std::shared_ptr<mesh::Mesh> MeshFactory::Build() {
   // DIAGNOSTICS
   if (output_ctrl_ > 0) {
     PrintLists();
   }
 
+  // Complete the lists of retained entities with the entities added otherwise
+  if (retained_.source != nullptr) {
+    retained_.entities[0].resize(elements_.size(), nullptr);
+    retained_.entities[1].resize(edges_.size(), nullptr);
+    retained_.entities[2].resize(nodes_.size(), nullptr);
+    retained_.edge_index = std::move(retained_index_[1]);
+  }
+
+  // Optional renumbering of nodes and cells
+  new_point_indices_.clear();
+  new_cell_indices_.clear();
+  if (ordering_ != EntityOrdering::insertion) {
+    ReorderEntities();
+  }
+
   // Obtain points to new mesh object; the actual construction of the
   // mesh is done by the constructor of that object
   mesh::Mesh* mesh_ptr =
       new hybrid2d::Mesh(dim_world_, std::move(nodes_), std::move(edges_),
-                         std::move(elements_), check_completeness_);
+                         std::move(elements_), check_completeness_,
+                         std::move(retained_));
 
   // Clear all information supplied to the MeshFactory object
   nodes_ = hybrid2d::Mesh::NodeCoordList{};  // .clear();
   edges_ = hybrid2d::Mesh::EdgeList{};       // .clear();
   elements_ = hybrid2d::Mesh::CellList{};    // clear();
+  retained_ = hybrid2d::Mesh::RetainedEntities{};
+  retained_index_ = {};
 
   return std::shared_ptr<mesh::Mesh>(mesh_ptr);
 }
 
+void MeshFactory::ReorderEntities() {
+  const size_type no_of_nodes = nodes_.size();
+  const size_type no_of_cells = elements_.size();
+  const auto idx_nil = static_cast<size_type>(-1);
+
+  // Number of nodes of cell number i
+  auto num_cell_nodes = [this, idx_nil](size_type i) -> size_type {
+    return elements_[i].first[3] == idx_nil ? 3 : 4;
+  };
+  // Geometry of node number i, possibly that of a retained node
+  auto node_geometry = [this](size_type i) -> const geometry::Geometry* {
+    if (nodes_[i] != nullptr || retained_.source == nullptr) {
+      return nodes_[i].get();
+    }
+    return retained_.entities[2][i]->Geometry();
+  };
+
+  // Step I: New numbering of the cells
+  std::vector<size_type> cell_order(no_of_cells);
+  switch (ordering_) {
+    case EntityOrdering::hilbert_curve: {
+      // Barycenters of the cells (first two world coordinates)
+      const Eigen::Matrix<double, 0, 1> origin;
+      std::vector<Eigen::Vector2d> centers(no_of_cells, Eigen::Vector2d::Zero());
+      for (size_type i = 0; i < no_of_cells; ++i) {
+        const size_type n = num_cell_nodes(i);
+        for (size_type j = 0; j < n; ++j) {
+          const Eigen::VectorXd x =
+              node_geometry(elements_[i].first[j])->Global(origin);
+          for (int k = 0; k < std::min<int>(2, x.rows()); ++k) {
+            centers[i][k] += x[k] / n;
+          }
+        }
+      }
+      // Map the bounding box of the barycenters to the grid of the curve
+      Eigen::Vector2d lower = Eigen::Vector2d::Zero();
+      Eigen::Vector2d upper = Eigen::Vector2d::Zero();
+      if (no_of_cells > 0) {
+        lower = upper = centers[0];
+      }
+      for (const Eigen::Vector2d& c : centers) {
+        lower = lower.cwiseMin(c);
+        upper = upper.cwiseMax(c);
+      }
+      const double extent = std::max((upper - lower).maxCoeff(), 1.0E-300);
+      const double scale = static_cast<double>((1U << 16U) - 1) / extent;
+      std::vector<std::uint64_t> curve_index(no_of_cells);
+      for (size_type i = 0; i < no_of_cells; ++i) {
+        const Eigen::Vector2d g = (centers[i] - lower) * scale;
+        curve_index[i] = HilbertCurveIndex(static_cast<std::uint32_t>(g[0]),
+                                           static_cast<std::uint32_t>(g[1]));
+      }
+      std::iota(cell_order.begin(), cell_order.end(), 0);
+      std::stable_sort(cell_order.begin(), cell_order.end(),
+                       [&curve_index](size_type a, size_type b) {
+                         return curve_index[a] < curve_index[b];
+                       });
+      break;
+    }
+    case EntityOrdering::reverse_cuthill_mckee: {
+      // Cells adjacent to the nodes (compressed row storage)
+      std::vector<size_type> node_offsets(no_of_nodes + 1, 0);
+      for (size_type i = 0; i < no_of_cells; ++i) {
+        for (size_type j = 0; j < num_cell_nodes(i); ++j) {
+          node_offsets[elements_[i].first[j] + 1]++;
+        }
+      }
+      std::partial_sum(node_offsets.begin(), node_offsets.end(),
+                       node_offsets.begin());
+      std::vector<size_type> node_cells(node_offsets[no_of_nodes]);
+      std::vector<size_type> fill(node_offsets.begin(), node_offsets.end() - 1);
+      for (size_type i = 0; i < no_of_cells; ++i) {
+        for (size_type j = 0; j < num_cell_nodes(i); ++j) {
+          node_cells[fill[elements_[i].first[j]]++] = i;
+        }
+      }
+      // Graph of cells sharing a node
+      std::vector<size_type> offsets(no_of_cells + 1, 0);
+      std::vector<size_type> neighbors;
+      std::vector<size_type> cell_neighbors;
+      for (size_type i = 0; i < no_of_cells; ++i) {
+        cell_neighbors.clear();
+        for (size_type j = 0; j < num_cell_nodes(i); ++j) {
+          const size_type node = elements_[i].first[j];
+          cell_neighbors.insert(cell_neighbors.end(),
+                                node_cells.begin() + node_offsets[node],
+                                node_cells.begin() + node_offsets[node + 1]);
+        }
+        std::sort(cell_neighbors.begin(), cell_neighbors.end());
+        cell_neighbors.erase(
+            std::unique(cell_neighbors.begin(), cell_neighbors.end()),
+            cell_neighbors.end());
+        neighbors.insert(neighbors.end(), cell_neighbors.begin(),
+                         cell_neighbors.end());
+        offsets[i + 1] = neighbors.size();
+      }
+      const std::vector<size_type> new_index =
+          base::ReverseCuthillMcKee(offsets, neighbors);
+      for (size_type i = 0; i < no_of_cells; ++i) {
+        cell_order[new_index[i]] = i;
+      }
+      break;
+    }
+    default: {
+      LF_VERIFY_MSG(false, "Illegal entity ordering");
+    }
+  }
+
+  // Step II: Number the nodes in the order of their first occurrence in the
+  // renumbered cells, then the nodes without cells
+  new_cell_indices_.resize(no_of_cells);
+  new_point_indices_.assign(no_of_nodes, idx_nil);
+  size_type node_count = 0;
+  for (size_type k = 0; k < no_of_cells; ++k) {
+    const size_type i = cell_order[k];
+    new_cell_indices_[i] = k;
+    for (size_type j = 0; j < num_cell_nodes(i); ++j) {
+      size_type& new_node = new_point_indices_[elements_[i].first[j]];
+      if (new_node == idx_nil) {
+        new_node = node_count++;
+      }
+    }
+  }
+  for (size_type& new_node : new_point_indices_) {
+    if (new_node == idx_nil) {
+      new_node = node_count++;
+    }
+  }
+
+  // Step III: Apply the permutations
+  hybrid2d::Mesh::NodeCoordList new_nodes(no_of_nodes);
+  for (size_type i = 0; i < no_of_nodes; ++i) {
+    new_nodes[new_point_indices_[i]] = std::move(nodes_[i]);
+  }
+  nodes_ = std::move(new_nodes);
+  if (retained_.source != nullptr) {
+    std::vector<const mesh::Entity*> new_retained_nodes(no_of_nodes);
+    for (size_type i = 0; i < no_of_nodes; ++i) {
+      new_retained_nodes[new_point_indices_[i]] = retained_.entities[2][i];
+    }
+    retained_.entities[2] = std::move(new_retained_nodes);
+    std::vector<const mesh::Entity*> new_retained_cells(no_of_cells);
+    for (size_type i = 0; i < no_of_cells; ++i) {
+      new_retained_cells[new_cell_indices_[i]] = retained_.entities[0][i];
+    }
+    retained_.entities[0] = std::move(new_retained_cells);
+  }
+  hybrid2d::Mesh::CellList new_elements(no_of_cells);
+  for (size_type i = 0; i < no_of_cells; ++i) {
+    const size_type n = num_cell_nodes(i);
+    auto& cell = new_elements[new_cell_indices_[i]];
+    cell = std::move(elements_[i]);
+    for (size_type j = 0; j < n; ++j) {
+      cell.first[j] = new_point_indices_[cell.first[j]];
+    }
+  }
+  elements_ = std::move(new_elements);
+  for (auto& edge : edges_) {
+    for (size_type& node : edge.first) {
+      node = new_point_indices_[node];
+    }
+  }
+}
+
 // For diagnostic output
 void MeshFactory::PrintLists(std::ostream& o) const {
   o << "hybrid2d::MeshFactory: Internal information" << std::endl;
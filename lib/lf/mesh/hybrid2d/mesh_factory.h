@@ -5,6 +5,7 @@
 #include "mesh.h"
 
 #include <iostream>
+#include <vector>
 
 namespace lf::mesh::hybrid2d {
 
@@ -21,6 +22,29 @@ namespace lf::mesh::hybrid2d {
  */
 class MeshFactory : public mesh::MeshFactory {
  public:
+  /**
+   * @brief Numbering of the nodes and cells of the mesh created by Build()
+   *
+   * - `insertion`: entities are numbered in the order in which they were
+   *   added by AddPoint() and AddEntity() (default)
+   * - `hilbert_curve`: cells are numbered along a Hilbert space-filling curve
+   *   through their barycenters
+   * - `reverse_cuthill_mckee`: cells are numbered by the reverse
+   *   Cuthill-McKee algorithm applied to the graph of cells sharing a node,
+   *   see lf::base::ReverseCuthillMcKee()
+   *
+   * For the latter two options the nodes are numbered in the order of their
+   * first occurrence in the renumbered cells. Nodes that do not belong to any
+   * cell come last, in insertion order. Edges are numbered by the mesh based
+   * on the node numbering, see hybrid2d::Mesh.
+   *
+   * With a reordering, neighboring cells tend to have close indices. This
+   * improves the memory locality of loops over the entities of the mesh and
+   * of data indexed by entities, and it reduces the bandwidth of Galerkin
+   * matrices.
+   */
+  enum class EntityOrdering { insertion, hilbert_curve, reverse_cuthill_mckee };
+
   MeshFactory(const MeshFactory&) = delete;
   MeshFactory(MeshFactory&&) = delete;
   MeshFactory& operator=(const MeshFactory&) = delete;
@@ -55,23 +79,93 @@ class MeshFactory : public mesh::MeshFactory {
                       const nonstd::span<const size_type>& nodes,
                       std::unique_ptr<geometry::Geometry>&& geometry) override;
 
+  /**
+   * @brief Add an entity of another mesh to the new mesh without copying its
+   * geometry
+   * @param mesh the mesh owning `entity`
+   * @param entity node, edge or cell of `mesh`
+   * @return index of the entity in the new mesh, as returned by AddPoint() or
+   * AddEntity()
+   *
+   * The entity of the new mesh shares the geometry object of `entity`, and the
+   * new mesh keeps `mesh` alive. The vertices of the new entity are the
+   * retained vertices of `entity`, which therefore must have been retained
+   * before. Mixing retained entities with entities added through AddPoint()
+   * and AddEntity() is allowed, but all retained entities have to belong to the
+   * same mesh.
+   *
+   * Retaining most of the entities of a mesh makes building a mesh that differs
+   * only locally from it considerably cheaper, see hybrid2d::Mesh.
+   */
+  // NOLINTNEXTLINE(modernize-use-nodiscard)
+  size_type RetainEntity(const std::shared_ptr<const mesh::Mesh>& mesh,
+                         const mesh::Entity& entity);
+
   [[nodiscard]] std::shared_ptr<mesh::Mesh> Build() override;
 
+  /**
+   * @brief Select the numbering of nodes and cells applied by Build()
+   *
+   * @note If the ordering is different from `EntityOrdering::insertion`, the
+   * indices returned by AddPoint() and AddEntity() for nodes and cells are not
+   * the indices of the entities in the mesh. Use NewPointIndices() and
+   * NewCellIndices() to translate them. Indices of edges supplied through
+   * AddEntity() are preserved.
+   */
+  void SetEntityOrdering(EntityOrdering ordering) { ordering_ = ordering; }
+
+  /** @brief The numbering of nodes and cells applied by Build() */
+  [[nodiscard]] EntityOrdering GetEntityOrdering() const { return ordering_; }
+
+  /**
+   * @brief Index in the last mesh created by Build() of the point with the
+   * given index returned by AddPoint()
+   *
+   * Empty if no reordering took place during the last call of Build().
+   */
+  [[nodiscard]] const std::vector<size_type>& NewPointIndices() const {
+    return new_point_indices_;
+  }
+
+  /**
+   * @brief Index in the last mesh created by Build() of the cell with the
+   * given index returned by AddEntity()
+   *
+   * Empty if no reordering took place during the last call of Build().
+   */
+  [[nodiscard]] const std::vector<size_type>& NewCellIndices() const {
+    return new_cell_indices_;
+  }
+
   /** @brief output function printing assembled lists of entity information */
   void PrintLists(std::ostream& o = std::cout) const;
 
   ~MeshFactory() override = default;
 
  private:
+  /** @brief Renumber nodes_ and elements_ according to ordering_ */
+  void ReorderEntities();
+
   dim_t dim_world_;  // dimension of ambient space
   hybrid2d::Mesh::NodeCoordList nodes_;
   hybrid2d::Mesh::EdgeList edges_;
   hybrid2d::Mesh::CellList elements_;
+  // Entities of another mesh added through RetainEntity()
+  hybrid2d::Mesh::RetainedEntities retained_;
+  // For every codimension the index of the retained entities of
+  // retained_.source in the new mesh
+  std::array<std::vector<size_type>, 3> retained_index_;
 
   // If set to true, the Build() method will check whether all sub-entities
   // belong to at least one entity */
   bool check_completeness_;
 
+  // Numbering of nodes and cells applied by Build()
+  EntityOrdering ordering_{EntityOrdering::insertion};
+  // Permutations applied during the last call of Build()
+  std::vector<size_type> new_point_indices_;
+  std::vector<size_type> new_cell_indices_;
+
  public:
   // Switch for verbosity level of output
   /** @brief Diagnostics control variable */
@@ -52,13 +52,25 @@ class Point : public mesh::Entity {
    */
   explicit Point(size_type index,
                  std::unique_ptr<geometry::Geometry>&& geometry)
-      : index_(index), geometry_(std::move(geometry)), this_(this) {
+      : Point(index, geometry.get()) {
+    geometry_ = std::move(geometry);
+  }
+
+  /**
+   * @brief constructor for a point sharing the geometry object of a point of
+   * another mesh
+   * @param index index of the entity to be created
+   * @param shared_geometry geometry object owned by another mesh, which must
+   * outlive this point
+   */
+  explicit Point(size_type index, geometry::Geometry* shared_geometry)
+      : mesh::Entity(index), geometry_ptr_(shared_geometry), this_(this) {
     // DIAGNOSTICS
     // std::cout << "hybrid2d::Point(" << index_ << ") " << std::endl;
-    LF_VERIFY_MSG(geometry_, "Point must be supplied with a geometry");
-    LF_VERIFY_MSG(geometry_->DimLocal() == 0,
+    LF_VERIFY_MSG(geometry_ptr_, "Point must be supplied with a geometry");
+    LF_VERIFY_MSG(geometry_ptr_->DimLocal() == 0,
                   "Geometry must be that of a point");
-    LF_VERIFY_MSG(geometry_->RefEl() == base::RefEl::kPoint(),
+    LF_VERIFY_MSG(geometry_ptr_->RefEl() == base::RefEl::kPoint(),
                   "Geometry must fit point");
   }
 
@@ -80,12 +92,9 @@ class Point : public mesh::Entity {
 
   /** @brief return _pointer_ to associated geometry object */
   [[nodiscard]] geometry::Geometry* Geometry() const override {
-    return geometry_.get();
+    return geometry_ptr_;
   }
 
-  /** @brief access to index of an entity */
-  [[nodiscard]] size_type index() const { return index_; }
-
   [[nodiscard]] base::RefEl RefEl() const override {
     return base::RefEl::kPoint();
   }
@@ -97,8 +106,8 @@ class Point : public mesh::Entity {
   ~Point() override = default;
 
  private:
-  size_type index_ = -1;  // zero-based index of this entity.
-  std::unique_ptr<geometry::Geometry> geometry_ = nullptr;  // shape information
+  std::unique_ptr<geometry::Geometry> geometry_ = nullptr;  // owned shape
+  geometry::Geometry* geometry_ptr_ = nullptr;  // shape, owned or shared
   static constexpr std::array<lf::mesh::Orientation, 1> dummy_or_{
       lf::mesh::Orientation::positive};
   Entity* this_ = nullptr;  // needed for SubEntity()
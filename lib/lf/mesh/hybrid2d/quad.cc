@@ -17,8 +17,19 @@ Quadrilateral::Quadrilateral(size_type index,
                              const Point* corner2, const Point* corner3,
                              const Segment* edge0, const Segment* edge1,
                              const Segment* edge2, const Segment* edge3)
-    : index_(index),
-      geometry_(std::move(geometry)),
+    : Quadrilateral(index, geometry.get(), corner0, corner1, corner2, corner3,
+                    edge0, edge1, edge2, edge3) {
+  geometry_ = std::move(geometry);
+}
+
+Quadrilateral::Quadrilateral(size_type index,
+                             geometry::Geometry* shared_geometry,
+                             const Point* corner0, const Point* corner1,
+                             const Point* corner2, const Point* corner3,
+                             const Segment* edge0, const Segment* edge1,
+                             const Segment* edge2, const Segment* edge3)
+    : mesh::Entity(index),
+      geometry_ptr_(shared_geometry),
       nodes_({corner0, corner1, corner2, corner3}),
       edges_({edge0, edge1, edge2, edge3}),
       edge_ori_(),
@@ -31,10 +42,10 @@ Quadrilateral::Quadrilateral(size_type index,
   LF_VERIFY_MSG(edge1 != nullptr, "Invalid pointer to edge 1");
   LF_VERIFY_MSG(edge2 != nullptr, "Invalid pointer to edge 2");
   LF_VERIFY_MSG(edge3 != nullptr, "Invalid pointer to edge 3");
-  if (geometry_) {
-    LF_VERIFY_MSG(geometry_->DimLocal() == 2,
+  if (geometry_ptr_) {
+    LF_VERIFY_MSG(geometry_ptr_->DimLocal() == 2,
                   "Geometry must describe a 2D cell");
-    LF_VERIFY_MSG(geometry_->RefEl() == base::RefEl::kQuad(),
+    LF_VERIFY_MSG(geometry_ptr_->RefEl() == base::RefEl::kQuad(),
                   "Cell geometry must fit a quad");
   }
 
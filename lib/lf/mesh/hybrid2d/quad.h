@@ -69,6 +69,19 @@ class Quadrilateral : public mesh::Entity {
                          const Segment* edge0, const Segment* edge1,
                          const Segment* edge2, const Segment* edge3);
 
+  /**
+   * @brief constructor for a cell sharing the geometry object of a cell of
+   * another mesh
+   *
+   * Same as the other constructor, but `shared_geometry` is owned by another
+   * mesh, which must outlive this cell.
+   */
+  explicit Quadrilateral(size_type index, geometry::Geometry* shared_geometry,
+                         const Point* corner0, const Point* corner1,
+                         const Point* corner2, const Point* corner3,
+                         const Segment* edge0, const Segment* edge1,
+                         const Segment* edge2, const Segment* edge3);
+
   /** @brief an edge is an entity of co-dimension 1 */
   [[nodiscard]] unsigned Codim() const override { return 0; }
 
@@ -92,16 +105,13 @@ class Quadrilateral : public mesh::Entity {
     return edge_ori_;
   }
 
-  /** @brief access to index of an entity */
-  [[nodiscard]] size_type index() const { return index_; }
-
   /**
    * @name Standard methods inherited from Entity object
    * @sa mesh::Entity
    * @{
    */
   [[nodiscard]] geometry::Geometry* Geometry() const override {
-    return geometry_.get();
+    return geometry_ptr_;
   }
   [[nodiscard]] base::RefEl RefEl() const override {
     return base::RefEl::kQuad();
@@ -114,8 +124,8 @@ class Quadrilateral : public mesh::Entity {
   ~Quadrilateral() override = default;
 
  private:
-  size_type index_ = -1;  // zero-based index of this entity.
-  std::unique_ptr<geometry::Geometry> geometry_;  // shape information
+  std::unique_ptr<geometry::Geometry> geometry_;  // owned shape information
+  geometry::Geometry* geometry_ptr_ = nullptr;    // shape, owned or shared
   std::array<const Point*, 4> nodes_{};           // nodes = corners of quad
   std::array<const Segment*, 4> edges_{};         // edges of quad
   std::array<lf::mesh::Orientation, 4>
@@ -56,16 +56,31 @@ class Segment : public mesh::Entity {
   explicit Segment(size_type index,
                    std::unique_ptr<geometry::Geometry>&& geometry,
                    const Point* endpoint0, const Point* endpoint1)
-      : index_(index),
-        geometry_(std::move(geometry)),
+      : Segment(index, geometry.get(), endpoint0, endpoint1) {
+    geometry_ = std::move(geometry);
+  }
+
+  /**
+   * @brief constructor for an edge sharing the geometry object of an edge of
+   * another mesh
+   * @param index index of the entity to be created
+   * @param shared_geometry geometry object owned by another mesh, which must
+   * outlive this edge
+   * @param endpoint0 pointer to the first node
+   * @param endpoint1 pointer to the second node
+   */
+  explicit Segment(size_type index, geometry::Geometry* shared_geometry,
+                   const Point* endpoint0, const Point* endpoint1)
+      : mesh::Entity(index),
+        geometry_ptr_(shared_geometry),
         nodes_({endpoint0, endpoint1}),
         this_(this) {
     LF_VERIFY_MSG((endpoint0 != nullptr) && (endpoint1 != nullptr),
                   "Invalid pointer to endnode of edge");
-    if (geometry_) {
-      LF_VERIFY_MSG(geometry_->DimLocal() == 1,
+    if (geometry_ptr_) {
+      LF_VERIFY_MSG(geometry_ptr_->DimLocal() == 1,
                     "Geometry must describe a curve");
-      LF_VERIFY_MSG(geometry_->RefEl() == base::RefEl::kSegment(),
+      LF_VERIFY_MSG(geometry_ptr_->RefEl() == base::RefEl::kSegment(),
                     "Segment geometry must fit a segment");
     }
   }
@@ -92,15 +107,12 @@ class Segment : public mesh::Entity {
     return endpoint_ori_;
   }
 
-  /** @brief access to index of an entity */
-  [[nodiscard]] size_type index() const { return index_; }
-
   /** @name Standard methods of an Entity object
    * @sa mesh::Entity
    * @{
    */
   [[nodiscard]] geometry::Geometry* Geometry() const override {
-    return geometry_.get();
+    return geometry_ptr_;
   }
   [[nodiscard]] base::RefEl RefEl() const override {
     return base::RefEl::kSegment();
@@ -113,8 +125,8 @@ class Segment : public mesh::Entity {
   ~Segment() override = default;
 
  private:
-  size_type index_ = -1;  // zero-based index of this entity.
-  std::unique_ptr<geometry::Geometry> geometry_;  // shape information
+  std::unique_ptr<geometry::Geometry> geometry_;  // owned shape information
+  geometry::Geometry* geometry_ptr_ = nullptr;    // shape, owned or shared
   std::array<const Point*, 2> nodes_{};           // nodes connected by edge
   Entity* this_ = nullptr;                        // needed for SubEntity()
   static constexpr std::array<lf::mesh::Orientation, 2> endpoint_ori_{
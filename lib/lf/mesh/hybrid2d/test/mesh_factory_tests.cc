@@ -12,6 +12,7 @@
 #include <lf/mesh/mesh.h>
 #include <lf/mesh/utils/utils.h>
 #include <Eigen/Eigen>
+#include <set>
 #include "lf/mesh/test_utils/check_entity_indexing.h"
 #include "lf/mesh/test_utils/check_mesh_completeness.h"
 #include "lf/mesh/test_utils/test_meshes.h"
@@ -201,4 +202,294 @@ TEST(lf_hybrid2d, IncompleteMeshes) {
 #pragma GCC diagnostic pop
 }
 
+TEST(lf_hybrid2d, EntityOrdering) {
+  // n x n grid of unit squares, nodes and cells inserted in scrambled order
+  const size_type n = 16;
+  const size_type no_nodes = (n + 1) * (n + 1);
+  const size_type no_cells = n * n;
+  // Grid point number i is inserted as point number (i*101) % no_nodes
+  std::vector<size_type> point_index(no_nodes);
+  std::vector<Eigen::Vector2d> inserted_points(no_nodes);
+  for (size_type i = 0; i < no_nodes; ++i) {
+    point_index[i] = (i * 101) % no_nodes;
+    inserted_points[point_index[i]] = Eigen::Vector2d(i % (n + 1), i / (n + 1));
+  }
+  std::vector<std::array<size_type, 4>> inserted_cells;
+  for (size_type l = 0; l < no_cells; ++l) {
+    const size_type k = (l * 97) % no_cells;
+    const size_type p = (k / n) * (n + 1) + k % n;
+    inserted_cells.push_back({point_index[p], point_index[p + 1],
+                              point_index[p + n + 2], point_index[p + n + 1]});
+  }
+
+  size_type insertion_bandwidth = 0;
+  for (auto ordering : {MeshFactory::EntityOrdering::insertion,
+                        MeshFactory::EntityOrdering::hilbert_curve,
+                        MeshFactory::EntityOrdering::reverse_cuthill_mckee}) {
+    MeshFactory mf(2);
+    mf.SetEntityOrdering(ordering);
+    for (const Eigen::Vector2d& x : inserted_points) {
+      mf.AddPoint(x);
+    }
+    for (const auto& nodes : inserted_cells) {
+      Eigen::MatrixXd coords(2, 4);
+      for (int v = 0; v < 4; ++v) {
+        coords.col(v) = inserted_points[nodes[v]];
+      }
+      mf.AddEntity(base::RefEl::kQuad(), nodes,
+                   std::make_unique<geometry::QuadO1>(coords));
+    }
+    auto mesh = mf.Build();
+    test_utils::checkEntityIndexing(*mesh);
+    test_utils::checkMeshCompleteness(*mesh);
+    ASSERT_EQ(mesh->NumEntities(0), no_cells);
+    ASSERT_EQ(mesh->NumEntities(2), no_nodes);
+
+    const bool reordered = ordering != MeshFactory::EntityOrdering::insertion;
+    EXPECT_EQ(mf.NewPointIndices().empty(), !reordered);
+    EXPECT_EQ(mf.NewCellIndices().empty(), !reordered);
+    auto new_point = [&](size_type i) {
+      return reordered ? mf.NewPointIndices()[i] : i;
+    };
+    auto new_cell = [&](size_type i) {
+      return reordered ? mf.NewCellIndices()[i] : i;
+    };
+
+    // Nodes and cells keep their location and connectivity
+    const Eigen::VectorXd zero = Eigen::VectorXd::Zero(0);
+    for (size_type i = 0; i < no_nodes; ++i) {
+      EXPECT_TRUE(mesh->EntityByIndex(2, new_point(i))
+                      ->Geometry()
+                      ->Global(zero)
+                      .isApprox(inserted_points[i]));
+    }
+    size_type bandwidth = 0;
+    for (size_type l = 0; l < no_cells; ++l) {
+      auto vertices = mesh->EntityByIndex(0, new_cell(l))->SubEntities(2);
+      for (int v = 0; v < 4; ++v) {
+        EXPECT_EQ(mesh->Index(*vertices[v]), new_point(inserted_cells[l][v]));
+      }
+      for (const Entity* v0 : vertices) {
+        for (const Entity* v1 : vertices) {
+          const size_type i0 = mesh->Index(*v0);
+          const size_type i1 = mesh->Index(*v1);
+          bandwidth = std::max(bandwidth, i0 > i1 ? i0 - i1 : i1 - i0);
+        }
+      }
+    }
+    if (reordered) {
+      EXPECT_LT(bandwidth, insertion_bandwidth);
+    } else {
+      insertion_bandwidth = bandwidth;
+    }
+    if (ordering == MeshFactory::EntityOrdering::reverse_cuthill_mckee) {
+      EXPECT_LE(bandwidth, 4 * n + 4);
+    }
+  }
+}
+
+TEST(lf_hybrid2d, EntityOrderingTriangles) {
+  // Re-insert the nodes and cells of a triangular and of a hybrid mesh in
+  // scrambled order
+  TPTriagMeshBuilder builder(std::make_unique<MeshFactory>(2));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(12)
+      .setNumYCells(12);
+  const std::shared_ptr<const mesh::Mesh> tria_mesh = builder.Build();
+  const std::shared_ptr<const mesh::Mesh> hybrid_mesh =
+      test_utils::GenerateHybrid2DTestMesh(0);
+
+  for (const auto& source : {tria_mesh, hybrid_mesh}) {
+    const size_type no_nodes = source->NumEntities(2);
+    const size_type no_cells = source->NumEntities(0);
+    // Source node i is inserted as point number point_index[i]
+    std::vector<size_type> point_index(no_nodes);
+    for (size_type i = 0; i < no_nodes; ++i) {
+      point_index[i] = (i * 101) % no_nodes;
+    }
+    std::vector<size_type> cell_order(no_cells);
+    for (size_type l = 0; l < no_cells; ++l) {
+      cell_order[l] = (l * 97) % no_cells;
+    }
+    ASSERT_EQ(std::set<size_type>(point_index.begin(), point_index.end())
+                  .size(),
+              no_nodes);
+    ASSERT_EQ(std::set<size_type>(cell_order.begin(), cell_order.end())
+                  .size(),
+              no_cells);
+    std::vector<Eigen::Vector2d> inserted_points(no_nodes);
+    const Eigen::VectorXd zero = Eigen::VectorXd::Zero(0);
+    for (const Entity* node : source->Entities(2)) {
+      inserted_points[point_index[source->Index(*node)]] =
+          node->Geometry()->Global(zero);
+    }
+    std::vector<std::vector<size_type>> inserted_cells;
+    std::vector<base::RefEl> inserted_ref_els;
+    for (const size_type k : cell_order) {
+      const Entity& cell{*source->EntityByIndex(0, k)};
+      std::vector<size_type> nodes;
+      for (const Entity* v : cell.SubEntities(2)) {
+        nodes.push_back(point_index[source->Index(*v)]);
+      }
+      inserted_cells.push_back(nodes);
+      inserted_ref_els.push_back(cell.RefEl());
+    }
+
+    // Sum of the index distances of the nodes of all cells, the Hilbert curve
+    // and the Cuthill-McKee ordering both make it much smaller than the
+    // scrambled insertion order
+    size_type insertion_distance = 0;
+    for (auto ordering : {MeshFactory::EntityOrdering::insertion,
+                          MeshFactory::EntityOrdering::hilbert_curve,
+                          MeshFactory::EntityOrdering::reverse_cuthill_mckee}) {
+      MeshFactory mf(2);
+      mf.SetEntityOrdering(ordering);
+      for (const Eigen::Vector2d& x : inserted_points) {
+        mf.AddPoint(x);
+      }
+      for (size_type l = 0; l < no_cells; ++l) {
+        const std::vector<size_type>& nodes{inserted_cells[l]};
+        Eigen::MatrixXd coords(2, nodes.size());
+        for (std::size_t v = 0; v < nodes.size(); ++v) {
+          coords.col(v) = inserted_points[nodes[v]];
+        }
+        std::unique_ptr<geometry::Geometry> geo;
+        if (inserted_ref_els[l] == base::RefEl::kTria()) {
+          geo = std::make_unique<geometry::TriaO1>(coords);
+        } else {
+          geo = std::make_unique<geometry::QuadO1>(coords);
+        }
+        mf.AddEntity(inserted_ref_els[l], nodes, std::move(geo));
+      }
+      auto mesh = mf.Build();
+      test_utils::checkEntityIndexing(*mesh);
+      test_utils::checkMeshCompleteness(*mesh);
+      ASSERT_EQ(mesh->NumEntities(0), no_cells);
+      ASSERT_EQ(mesh->NumEntities(1), source->NumEntities(1));
+      ASSERT_EQ(mesh->NumEntities(2), no_nodes);
+
+      const bool reordered =
+          ordering != MeshFactory::EntityOrdering::insertion;
+      auto new_point = [&](size_type i) {
+        return reordered ? mf.NewPointIndices()[i] : i;
+      };
+      auto new_cell = [&](size_type i) {
+        return reordered ? mf.NewCellIndices()[i] : i;
+      };
+
+      // Nodes and cells keep their location, type and connectivity
+      for (size_type i = 0; i < no_nodes; ++i) {
+        EXPECT_TRUE(mesh->EntityByIndex(2, new_point(i))
+                        ->Geometry()
+                        ->Global(zero)
+                        .isApprox(inserted_points[i]));
+      }
+      size_type distance = 0;
+      for (size_type l = 0; l < no_cells; ++l) {
+        const Entity& cell{*mesh->EntityByIndex(0, new_cell(l))};
+        EXPECT_EQ(cell.RefEl(), inserted_ref_els[l]);
+        auto vertices = cell.SubEntities(2);
+        ASSERT_EQ(vertices.size(), inserted_cells[l].size());
+        for (std::size_t v = 0; v < inserted_cells[l].size(); ++v) {
+          EXPECT_EQ(mesh->Index(*vertices[v]),
+                    new_point(inserted_cells[l][v]));
+        }
+        for (const Entity* v0 : vertices) {
+          for (const Entity* v1 : vertices) {
+            const size_type i0 = mesh->Index(*v0);
+            const size_type i1 = mesh->Index(*v1);
+            distance += i0 > i1 ? i0 - i1 : i1 - i0;
+          }
+        }
+      }
+      if (!reordered) {
+        insertion_distance = distance;
+      } else if (source == tria_mesh) {
+        EXPECT_LT(2 * distance, insertion_distance);
+      }
+    }
+  }
+}
+
+TEST(lf_hybrid2d, RetainEntity) {
+  std::shared_ptr<const mesh::Mesh> source =
+      test_utils::GenerateHybrid2DTestMesh(0);
+  const Entity& cell0{*source->EntityByIndex(0, 0)};
+  auto is_edge_of_cell0 = [&](const Entity& edge) {
+    for (const Entity* e : cell0.SubEntities(1)) {
+      if (e == &edge) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // Take over all entities but cell 0 and its edges, so that the cells
+  // adjacent to cell 0 have to be connected with new edges
+  MeshFactory mf(2);
+  for (const Entity* node : source->Entities(2)) {
+    EXPECT_EQ(mf.RetainEntity(source, *node), source->Index(*node));
+  }
+  size_type no_retained_edges = 0;
+  for (const Entity* edge : source->Entities(1)) {
+    if (!is_edge_of_cell0(*edge)) {
+      EXPECT_EQ(mf.RetainEntity(source, *edge), no_retained_edges++);
+    }
+  }
+  std::vector<size_type> cell0_nodes;
+  for (const Entity* node : cell0.SubEntities(2)) {
+    cell0_nodes.push_back(source->Index(*node));
+  }
+  EXPECT_EQ(mf.AddEntity(cell0.RefEl(), cell0_nodes, nullptr), 0);
+  for (const Entity* cell : source->Entities(0)) {
+    if (cell != &cell0) {
+      EXPECT_EQ(mf.RetainEntity(source, *cell), source->Index(*cell));
+    }
+  }
+  std::shared_ptr<const mesh::Mesh> mesh = mf.Build();
+  test_utils::checkEntityIndexing(*mesh);
+  test_utils::checkMeshCompleteness(*mesh);
+  EXPECT_EQ(test_utils::isWatertightMesh(*mesh, false).size(), 0);
+  for (dim_t codim = 0; codim <= 2; ++codim) {
+    ASSERT_EQ(mesh->NumEntities(codim), source->NumEntities(codim));
+  }
+
+  // Retained nodes and cells share the geometry of their originals, the
+  // retained edges come first
+  for (const Entity* node : source->Entities(2)) {
+    EXPECT_EQ(mesh->EntityByIndex(2, source->Index(*node))->Geometry(),
+              node->Geometry());
+  }
+  size_type edge_index = 0;
+  for (const Entity* edge : source->Entities(1)) {
+    if (!is_edge_of_cell0(*edge)) {
+      const Entity& new_edge{*mesh->EntityByIndex(1, edge_index++)};
+      EXPECT_EQ(new_edge.Geometry(), edge->Geometry());
+      for (int j = 0; j < 2; ++j) {
+        EXPECT_EQ(mesh->Index(*new_edge.SubEntities(1)[j]),
+                  source->Index(*edge->SubEntities(1)[j]));
+      }
+    }
+  }
+  for (const Entity* cell : source->Entities(0)) {
+    const Entity& new_cell{*mesh->EntityByIndex(0, source->Index(*cell))};
+    EXPECT_EQ(new_cell.RefEl(), cell->RefEl());
+    EXPECT_EQ(new_cell.Geometry() == cell->Geometry(), cell != &cell0);
+    EXPECT_NEAR(Volume(*new_cell.Geometry()), Volume(*cell->Geometry()),
+                1.0E-12);
+    for (size_type j = 0; j < cell->RefEl().NumNodes(); ++j) {
+      EXPECT_EQ(mesh->Index(*new_cell.SubEntities(2)[j]),
+                source->Index(*cell->SubEntities(2)[j]));
+    }
+  }
+
+  // The new mesh keeps the source mesh alive
+  std::weak_ptr<const mesh::Mesh> weak_source = source;
+  source.reset();
+  EXPECT_FALSE(weak_source.expired());
+  mesh.reset();
+  EXPECT_TRUE(weak_source.expired());
+}
+
 }  // namespace lf::mesh::hybrid2d::test
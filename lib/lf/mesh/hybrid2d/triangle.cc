@@ -17,8 +17,17 @@ Triangle::Triangle(size_type index,
                    const Point* corner0, const Point* corner1,
                    const Point* corner2, const Segment* edge0,
                    const Segment* edge1, const Segment* edge2)
-    : index_(index),
-      geometry_(std::move(geometry)),
+    : Triangle(index, geometry.get(), corner0, corner1, corner2, edge0, edge1,
+               edge2) {
+  geometry_ = std::move(geometry);
+}
+
+Triangle::Triangle(size_type index, geometry::Geometry* shared_geometry,
+                   const Point* corner0, const Point* corner1,
+                   const Point* corner2, const Segment* edge0,
+                   const Segment* edge1, const Segment* edge2)
+    : mesh::Entity(index),
+      geometry_ptr_(shared_geometry),
       nodes_({corner0, corner1, corner2}),
       edges_({edge0, edge1, edge2}),
       edge_ori_(),
@@ -29,10 +38,10 @@ Triangle::Triangle(size_type index,
   LF_VERIFY_MSG(edge0 != nullptr, "Invalid pointer to edge 0");
   LF_VERIFY_MSG(edge1 != nullptr, "Invalid pointer to edge 1");
   LF_VERIFY_MSG(edge2 != nullptr, "Invalid pointer to edge 2");
-  if (geometry_) {
-    LF_VERIFY_MSG(geometry_->DimLocal() == 2,
+  if (geometry_ptr_) {
+    LF_VERIFY_MSG(geometry_ptr_->DimLocal() == 2,
                   "Geometry must describe a 2D cell");
-    LF_VERIFY_MSG(geometry_->RefEl() == base::RefEl::kTria(),
+    LF_VERIFY_MSG(geometry_ptr_->RefEl() == base::RefEl::kTria(),
                   "Cell geometry must fit a triangle");
   }
 
@@ -64,12 +64,21 @@ class Triangle : public mesh::Entity {
                     const Point* corner2, const Segment* edge0,
                     const Segment* edge1, const Segment* edge2);
 
+  /**
+   * @brief constructor for a cell sharing the geometry object of a cell of
+   * another mesh
+   *
+   * Same as the other constructor, but `shared_geometry` is owned by another
+   * mesh, which must outlive this cell.
+   */
+  explicit Triangle(size_type index, geometry::Geometry* shared_geometry,
+                    const Point* corner0, const Point* corner1,
+                    const Point* corner2, const Segment* edge0,
+                    const Segment* edge1, const Segment* edge2);
+
   /** @brief an edge is an entity of co-dimension 1 */
   [[nodiscard]] unsigned Codim() const override { return 0; }
 
-  /** @brief access to index of an entity */
-  [[nodiscard]] size_type index() const { return index_; }
-
   /** @brief Access to all subentities selected by **relative** co-dimension
    * @param rel_codim if 1 select edges, if 2 select nodes, if 0 select cell
    itself
@@ -93,7 +102,7 @@ class Triangle : public mesh::Entity {
    * @{
    */
   [[nodiscard]] geometry::Geometry* Geometry() const override {
-    return geometry_.get();
+    return geometry_ptr_;
   }
   [[nodiscard]] base::RefEl RefEl() const override {
     return base::RefEl::kTria();
@@ -106,8 +115,8 @@ class Triangle : public mesh::Entity {
   ~Triangle() override = default;
 
  private:
-  size_type index_ = -1;  // zero-based index of this entity.
-  std::unique_ptr<geometry::Geometry> geometry_;  // shape information
+  std::unique_ptr<geometry::Geometry> geometry_;  // owned shape information
+  geometry::Geometry* geometry_ptr_ = nullptr;    // shape, owned or shared
   std::array<const Point*, 3> nodes_{};           // nodes = corners of cell
   std::array<const Segment*, 3> edges_{};         // edges of the cells
   std::array<lf::mesh::Orientation, 3>
@@ -169,8 +169,14 @@ class Mesh {
    * The indexing of mesh entities is explained in [Lecture
    * Document](https://www.sam.math.ethz.ch/~grsam/NUMPDEFL/NUMPDE.pdf)
    * @lref{sss:lfmeshcnt}
+   *
+   * @note This method is called extremely often, e.g., for every access to a
+   * MeshDataSet and every lookup of degrees of freedom. Therefore it is not
+   * virtual: every mesh implementation stores the index in the Entity base
+   * class (see Entity::index()) when creating the entities and this method
+   * merely reads it.
    */
-  [[nodiscard]] virtual size_type Index(const Entity& e) const = 0;
+  [[nodiscard]] size_type Index(const Entity& e) const { return e.index(); }
 
   /**
    * @brief Method for accessing an entity through its index
@@ -11,6 +11,7 @@
 #include <Eigen/Eigen>
 #include <type_traits>
 #include <vector>
+#include "mesh_function_eval.h"
 #include "mesh_function_traits.h"
 
 namespace lf::mesh::utils {
@@ -37,6 +38,22 @@ namespace lf::mesh::utils {
  * MeshFunctionReturnType of the rhs MeshFunction and `Z` is the type of the
  * mesh function `A OP B`.
  *
+ * - Optionally it can overload
+ * ```
+ * template <class U, class V>
+ * auto operator()(const U& u, const V& v)
+ * ```
+ * which combines two single values. Then nested expressions such as
+ * `(a + b) * c - d` are evaluated in one loop over the evaluation points:
+ * only the values of the leaves `a`, `b`, `c`, `d` are stored (in a
+ * ThreadLocalBuffer()) and the operators are applied pointwise. For
+ * arithmetic and fixed size Eigen types the compiler can vectorize this
+ * loop. `operator()` then allocates only the returned `std::vector`.
+ * EvalInto() allocates no memory of its own once the buffers have grown,
+ * provided that the leaves evaluate without allocation (see their EvalInto())
+ * and that only the outermost operator yields dynamically sized Eigen
+ * objects.
+ *
  * @note Usually there is no need to use MeshFunctionBinary directly. There are
  * a number of operator overloads which use MeshFunctionBinary internally.
  *
@@ -58,20 +75,92 @@ class MeshFunctionBinary {
   MeshFunctionBinary(OP op, A a, B b)
       : op_(std::move(op)), a_(std::move(a)), b_(std::move(b)) {}
 
+  /// true if `OP` combines single values, see internal::FusedEvaluator
+  static constexpr bool kFusable =
+      std::is_invocable_v<const OP&, const MeshFunctionReturnType<A>&,
+                          const MeshFunctionReturnType<B>&> &&
+      std::is_default_constructible_v<MeshFunctionReturnType<A>> &&
+      std::is_default_constructible_v<MeshFunctionReturnType<B>>;
+
   /**
    * see \ref mesh_function for details.
    */
   auto operator()(const lf::mesh::Entity& e,
                   const Eigen::MatrixXd& local) const {
-    return op_(a_(e, local), b_(e, local), 0);
+    using R = typename decltype(op_(a_(e, local), b_(e, local), 0))::value_type;
+    if constexpr (kFusable && std::is_default_constructible_v<R>) {
+      std::vector<R> result(local.cols());
+      EvalInto(e, local, nonstd::span<R>(result.data(), result.size()));
+      return result;
+    } else {
+      return op_(a_(e, local), b_(e, local), 0);
+    }
+  }
+
+  /**
+   * @brief Evaluation into a buffer provided by the caller, see
+   * EvaluateMeshFunction()
+   */
+  template <class R>
+  void EvalInto(const lf::mesh::Entity& e, const Eigen::MatrixXd& local,
+                nonstd::span<R> result) const {
+    if constexpr (kFusable) {
+      const internal::FusedEvaluator<MeshFunctionBinary, MeshFunctionBinary, 0>
+          values(*this, e, local);
+      for (Eigen::Index i = 0; i < result.size(); ++i) {
+        values.AssignTo(i, result[i]);
+      }
+    } else {
+      auto values = op_(a_(e, local), b_(e, local), 0);
+      std::move(values.begin(), values.end(), result.begin());
+    }
   }
 
  private:
   OP op_;
   A a_;
   B b_;
+
+  template <class MF, class ROOT, int FIRST_LEAF, class>
+  friend class internal::FusedEvaluator;
 };
 
+namespace internal {
+
+/**
+ * @brief Values of the expression `a OP b` at all evaluation points, computed
+ * pointwise from the values of `a` and `b` (see FusedEvaluator)
+ */
+template <class OP, class A, class B, class ROOT, int FIRST_LEAF>
+class FusedEvaluator<MeshFunctionBinary<OP, A, B>, ROOT, FIRST_LEAF,
+                     std::enable_if_t<MeshFunctionBinary<OP, A, B>::kFusable>> {
+  using lhs_t = FusedEvaluator<A, ROOT, FIRST_LEAF>;
+  using rhs_t = FusedEvaluator<B, ROOT, FIRST_LEAF + lhs_t::kNumLeaves>;
+
+ public:
+  static constexpr int kNumLeaves = lhs_t::kNumLeaves + rhs_t::kNumLeaves;
+
+  FusedEvaluator(const MeshFunctionBinary<OP, A, B>& mf, const Entity& e,
+                 const Eigen::MatrixXd& local)
+      : op_(mf.op_), lhs_(mf.a_, e, local), rhs_(mf.b_, e, local) {}
+
+  auto operator[](std::size_t i) const {
+    return PointValue(op_(lhs_[i], rhs_[i]));
+  }
+
+  template <class T>
+  void AssignTo(std::size_t i, T& dest) const {
+    dest = op_(lhs_[i], rhs_[i]);
+  }
+
+ private:
+  const OP& op_;
+  lhs_t lhs_;
+  rhs_t rhs_;
+};
+
+}  // namespace internal
+
 /**
  * @brief Contains `OP` types (as used by MeshFunctionBinary) which are used by
  * the respective operator overloads (e.g. `operator+(...)`) to combine two mesh
@@ -92,6 +181,14 @@ namespace internal {
  * (See also MeshFunctionBinary for an explanation)
  */
 struct OperatorAddition {
+  /**
+   * @brief Sum of two single values
+   */
+  template <class U, class V>
+  auto operator()(const U& u, const V& v) const -> decltype(u + v) {
+    return u + v;
+  }
+
   /**
    * @brief Addition of two scalar types (`std::is_arithmetic_v<...> == true`)
    *
@@ -260,6 +357,14 @@ struct OperatorAddition {
  * (See also MeshFunctionBinary for an explanation)
  */
 struct OperatorSubtraction {
+  /**
+   * @brief Difference of two single values
+   */
+  template <class U, class V>
+  auto operator()(const U& u, const V& v) const -> decltype(u - v) {
+    return u - v;
+  }
+
   /**
    * @brief Subtraction of two scalar types (`std::is_arithmetic_v<...> ==
    * true`)
@@ -438,6 +543,14 @@ struct OperatorSubtraction {
  * (See also MeshFunctionBinary for an explanation)
  */
 struct OperatorMultiplication {
+  /**
+   * @brief Product of two single values
+   */
+  template <class U, class V>
+  auto operator()(const U& u, const V& v) const -> decltype(u * v) {
+    return u * v;
+  }
+
   /**
    * @brief Multiplication of two scalar types (`std::is_arithmetic_v<...> ==
    * true`)
@@ -633,7 +746,7 @@ struct OperatorMultiplication {
                   long /*unused*/) const {
     std::vector<decltype(u[0] * v[0])> result;
     result.reserve(u.size());
-    for (int i = 0; i < result.size(); ++i) {
+    for (int i = 0; i < u.size(); ++i) {
       result.emplace_back(u[i] * v[i]);
     }
     return result;
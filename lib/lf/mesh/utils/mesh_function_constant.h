@@ -9,6 +9,7 @@
 
 #ifndef __d0f3b8f133da4af980ce21ffffdf719a
 #define __d0f3b8f133da4af980ce21ffffdf719a
+#include <algorithm>
 #include <vector>
 #include "lf/mesh/mesh_interface.h"
 
@@ -39,6 +40,16 @@ class MeshFunctionConstant {
     return std::vector<R>(local.cols(), value_);
   }
 
+  /**
+   * @brief Evaluation into a buffer provided by the caller, see
+   * EvaluateMeshFunction()
+   */
+  void EvalInto(const mesh::Entity& /*unused*/,
+                const Eigen::MatrixXd& /*unused*/,
+                nonstd::span<R> result) const {
+    std::fill(result.begin(), result.end(), value_);
+  }
+
  private:
   R value_; /**< stored constant value */
 };
@@ -0,0 +1,175 @@
+/**
+ * @file
+ * @brief Evaluation of \ref mesh_function "mesh functions" into buffers owned
+ *        by the caller
+ * @copyright MIT License
+ */
+
+#ifndef __3c1e9a7d52b04f0e8d6a2f4b7c9e1d05
+#define __3c1e9a7d52b04f0e8d6a2f4b7c9e1d05
+
+#include <lf/mesh/mesh.h>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include "mesh_function_traits.h"
+
+namespace lf::mesh::utils {
+namespace internal {
+
+template <class MF, class = void>
+struct HasEvalInto : std::false_type {};
+
+template <class MF>
+struct HasEvalInto<
+    MF, std::void_t<decltype(std::declval<const MF&>().EvalInto(
+            std::declval<const Entity&>(), std::declval<const Eigen::MatrixXd&>(),
+            std::declval<nonstd::span<MeshFunctionReturnType<MF>>>()))>>
+    : std::true_type {};
+
+}  // namespace internal
+
+/**
+ * @brief Determine whether a \ref mesh_function provides the optional member
+ * function `EvalInto()`, which writes its values into a buffer owned by the
+ * caller.
+ * @tparam MF The type of the mesh function
+ */
+template <class MF>
+constexpr bool hasEvalInto = internal::HasEvalInto<MF>::value;
+
+/**
+ * @ingroup mesh_function
+ * @brief Evaluate a \ref mesh_function at several points of an entity and
+ * store the values in a buffer provided by the caller.
+ *
+ * @param mf the mesh function
+ * @param e entity on which the mesh function is evaluated
+ * @param local local coordinates of the evaluation points, one per column
+ * @param result range of length `local.cols()` that receives the values
+ *
+ * If `MF` provides the member function `EvalInto()` (see \ref mesh_function),
+ * it is invoked and no `std::vector` is created. Otherwise the values returned
+ * by `mf(e, local)` are moved into `result`.
+ *
+ * The elements of `result` are assigned to. If they are reused across calls,
+ * dynamically sized Eigen objects keep their memory when the size does not
+ * change.
+ */
+template <class MF>
+void EvaluateMeshFunction(const MF& mf, const Entity& e,
+                          const Eigen::MatrixXd& local,
+                          nonstd::span<MeshFunctionReturnType<MF>> result) {
+  LF_ASSERT_MSG(static_cast<Eigen::Index>(result.size()) == local.cols(),
+                "result has length " << result.size() << " instead of "
+                                     << local.cols());
+  if constexpr (hasEvalInto<MF>) {
+    mf.EvalInto(e, local, result);
+  } else {
+    auto values = mf(e, local);
+    std::move(values.begin(), values.end(), result.begin());
+  }
+}
+
+/**
+ * @brief Scratch memory that is owned by the calling thread
+ *
+ * @tparam T type of the elements, must be default constructible
+ * @tparam TAG type identifying the user of the buffer
+ * @tparam ID distinguishes several buffers of the same user
+ * @param size requested number of elements
+ * @return range of `size` elements. It stays valid until the next call with
+ *         the same template arguments from the same thread.
+ *
+ * The memory is allocated only when a buffer larger than any previous one is
+ * requested. Expressions of mesh functions use the type of the outermost mesh
+ * function as `TAG` and number their leaves with `ID`: the type of an
+ * expression differs from the types of all its subexpressions, so the buffers
+ * of nested evaluations do not overlap.
+ */
+template <class T, class TAG, int ID = 0>
+nonstd::span<T> ThreadLocalBuffer(std::size_t size) {
+  thread_local std::unique_ptr<T[]> buffer;  // NOLINT
+  thread_local std::size_t capacity = 0;
+  if (capacity < size) {
+    buffer = std::make_unique<T[]>(size);  // NOLINT
+    capacity = size;
+  }
+  return nonstd::span<T>(
+      buffer.get(), static_cast<typename nonstd::span<T>::index_type>(size));
+}
+
+namespace internal {
+
+/**
+ * @brief Turns the result of an operator into a value, i.e. evaluates Eigen
+ * expressions that may refer to temporaries.
+ *
+ * Fixed size Eigen objects are stored on the stack, so this does not allocate
+ * memory.
+ */
+template <class T>
+auto PointValue(T&& value) {
+  using value_t = std::decay_t<T>;
+  if constexpr (std::is_base_of_v<Eigen::EigenBase<value_t>, value_t>) {
+    return value.eval();
+  } else {
+    return value_t(std::forward<T>(value));
+  }
+}
+
+/**
+ * @brief Values of a \ref mesh_function at all evaluation points of an entity,
+ * used to evaluate expressions of mesh functions in a single loop.
+ *
+ * @tparam MF type of the mesh function
+ * @tparam ROOT type of the outermost mesh function of the expression
+ * @tparam FIRST_LEAF number of leaves of the expression to the left of `MF`
+ *
+ * The primary template treats `MF` as a leaf of the expression: its values are
+ * computed with EvaluateMeshFunction() and stored in the
+ * ThreadLocalBuffer() with tag `ROOT` and id `FIRST_LEAF`. MeshFunctionUnary
+ * and MeshFunctionBinary specialize it for operators that act on single
+ * values: then `operator[]` applies the operator to the values of the
+ * operands at one point and no intermediate values are stored.
+ *
+ * `operator[]` returns the value at one point as an object, which the
+ * operators of enclosing expressions take as operand. `AssignTo()` assigns
+ * the unevaluated result of the outermost operator to the destination
+ * instead, so that values of dynamically sized Eigen types are written into
+ * the memory of the destination without a temporary.
+ *
+ * The number of leaves is available as `kNumLeaves`.
+ */
+template <class MF, class ROOT, int FIRST_LEAF, class = void>
+class FusedEvaluator {
+ public:
+  /** @brief number of leaves of the expression */
+  static constexpr int kNumLeaves = 1;
+
+  FusedEvaluator(const MF& mf, const Entity& e, const Eigen::MatrixXd& local)
+      : values_(ThreadLocalBuffer<MeshFunctionReturnType<MF>, ROOT, FIRST_LEAF>(
+            local.cols())) {
+    EvaluateMeshFunction(mf, e, local, values_);
+  }
+
+  /** @brief value at the `i`-th evaluation point */
+  const MeshFunctionReturnType<MF>& operator[](std::size_t i) const {
+    return values_[i];
+  }
+
+  /** @brief assigns the value at the `i`-th evaluation point to `dest` */
+  template <class T>
+  void AssignTo(std::size_t i, T& dest) const {
+    dest = values_[i];
+  }
+
+ private:
+  nonstd::span<MeshFunctionReturnType<MF>> values_;
+};
+
+}  // namespace internal
+
+}  // namespace lf::mesh::utils
+
+#endif  // __3c1e9a7d52b04f0e8d6a2f4b7c9e1d05
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include <lf/mesh/mesh.h>
+#include "mesh_function_eval.h"
 
 namespace lf::mesh::utils {
 
@@ -87,9 +88,32 @@ class MeshFunctionGlobal {
     return result;
   }
 
+  /**
+   * @brief Evaluation into a buffer provided by the caller, see
+   * EvaluateMeshFunction()
+   *
+   * The global coordinates of the points are written into a thread-local
+   * matrix per reference element type by geometry::Geometry::GlobalInto(),
+   * which does not allocate memory for first-order cells once the matrix has
+   * the right size.
+   */
+  void EvalInto(const mesh::Entity& e, const Eigen::MatrixXd& local,
+                nonstd::span<F_return_type> result) const {
+    LF_ASSERT_MSG(e.RefEl().Dimension() == local.rows(),
+                  "mismatch between entity dimension and local.rows()");
+    Eigen::MatrixXd& global_points{
+        ThreadLocalBuffer<Eigen::MatrixXd, ScratchTag>(5)[e.RefEl().Id()]};
+    e.Geometry()->GlobalInto(local, global_points);
+    for (long i = 0; i < local.cols(); ++i) {
+      result[i] = f_(global_points.col(i));
+    }
+  }
+
   virtual ~MeshFunctionGlobal() = default;
 
  private:
+  /** Tag of the thread-local scratch memory of EvalInto() */
+  struct ScratchTag {};
   F f_;
 };
 
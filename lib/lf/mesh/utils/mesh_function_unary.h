@@ -10,6 +10,7 @@
 #define __b9b63bcccec548419a52fe0b06ffb3fc
 
 #include <lf/mesh/mesh.h>
+#include "mesh_function_eval.h"
 
 namespace lf::mesh::utils {
 
@@ -31,6 +32,14 @@ namespace lf::mesh::utils {
  * ```
  * where `U` is the MeshFunctionReturnType of the original MeshFunction, and `Z`
  * is the type of the mesh function `OP MF`.
+ * - Optionally it can overload
+ * ```
+ * template <class U>
+ * auto operator()(const U& u)
+ * ```
+ * which applies the operation to a single value. Then the mesh function takes
+ * part in the pointwise evaluation of expressions described in
+ * MeshFunctionBinary.
  *
  * @note Usually there is no need to use MeshFunctionUnary directly. There are
  * a number of operator overloads which use MeshFunctionUnary internally.
@@ -40,17 +49,89 @@ class MeshFunctionUnary {
  public:
   MeshFunctionUnary(OP op, MF mf) : op_(std::move(op)), mf_(std::move(mf)) {}
 
+  /// true if `OP` acts on single values, see internal::FusedEvaluator
+  static constexpr bool kFusable =
+      std::is_invocable_v<const OP&, const MeshFunctionReturnType<MF>&> &&
+      std::is_default_constructible_v<MeshFunctionReturnType<MF>>;
+
   auto operator()(const mesh::Entity& e, const Eigen::MatrixXd& local) const {
-    return op_(mf_(e, local), 0);
+    using R = typename decltype(op_(mf_(e, local), 0))::value_type;
+    if constexpr (kFusable && std::is_default_constructible_v<R>) {
+      std::vector<R> result(local.cols());
+      EvalInto(e, local, nonstd::span<R>(result.data(), result.size()));
+      return result;
+    } else {
+      return op_(mf_(e, local), 0);
+    }
+  }
+
+  /**
+   * @brief Evaluation into a buffer provided by the caller, see
+   * EvaluateMeshFunction()
+   */
+  template <class R>
+  void EvalInto(const mesh::Entity& e, const Eigen::MatrixXd& local,
+                nonstd::span<R> result) const {
+    if constexpr (kFusable) {
+      const internal::FusedEvaluator<MeshFunctionUnary, MeshFunctionUnary, 0>
+          values(*this, e, local);
+      for (Eigen::Index i = 0; i < result.size(); ++i) {
+        values.AssignTo(i, result[i]);
+      }
+    } else {
+      auto values = op_(mf_(e, local), 0);
+      std::move(values.begin(), values.end(), result.begin());
+    }
   }
 
  private:
   OP op_;
   MF mf_;
+
+  template <class MF2, class ROOT, int FIRST_LEAF, class>
+  friend class internal::FusedEvaluator;
+};
+
+namespace internal {
+
+/**
+ * @brief Values of the expression `OP mf` at all evaluation points, computed
+ * pointwise from the values of `mf` (see FusedEvaluator)
+ */
+template <class OP, class MF, class ROOT, int FIRST_LEAF>
+class FusedEvaluator<MeshFunctionUnary<OP, MF>, ROOT, FIRST_LEAF,
+                     std::enable_if_t<MeshFunctionUnary<OP, MF>::kFusable>> {
+  using operand_t = FusedEvaluator<MF, ROOT, FIRST_LEAF>;
+
+ public:
+  static constexpr int kNumLeaves = operand_t::kNumLeaves;
+
+  FusedEvaluator(const MeshFunctionUnary<OP, MF>& mf, const Entity& e,
+                 const Eigen::MatrixXd& local)
+      : op_(mf.op_), operand_(mf.mf_, e, local) {}
+
+  auto operator[](std::size_t i) const { return PointValue(op_(operand_[i])); }
+
+  template <class T>
+  void AssignTo(std::size_t i, T& dest) const {
+    dest = op_(operand_[i]);
+  }
+
+ private:
+  const OP& op_;
+  operand_t operand_;
 };
 
+}  // namespace internal
+
 namespace internal {
 struct UnaryOpMinus {
+  // minus in front of a single value
+  template <class U>
+  auto operator()(const U& u) const -> decltype(-u) {
+    return -u;
+  }
+
   // minus in front of a scalar type
   template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>>
   auto operator()(const std::vector<U>& u, int /*unused*/) const {
@@ -128,6 +209,16 @@ struct UnaryOpMinus {
 };
 
 struct UnaryOpSquaredNorm {
+  // squared norm of a single value
+  template <class U>
+  auto operator()(const U& u) const {
+    if constexpr (std::is_arithmetic_v<U>) {
+      return u * u;
+    } else {
+      return u.squaredNorm();
+    }
+  }
+
   // squared norm of a scalar type
   template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>>
   auto operator()(const std::vector<U>& u, int /*unused*/) const {
@@ -172,6 +263,12 @@ struct UnaryOpSquaredNorm {
 };
 
 struct UnaryOpTranspose {
+  // transpose of a single eigen matrix/array
+  template <class U>
+  auto operator()(const U& u) const -> decltype(u.transpose()) {
+    return u.transpose();
+  }
+
   // transpose the eigen matrix
   template <class S, int R, int C, int O, int MR, int MC>
   auto operator()(const std::vector<Eigen::Matrix<S, R, C, O, MR, MC>>& u,
@@ -211,4 +211,52 @@ TEST(meshFunctionBinary, Multiplication) {
   checkMeshFunctionEqual(*mesh, mfXA * mfXB, MeshFunctionConstant(X(2)));
 }
 
+TEST(meshFunctionBinary, Expressions) {
+  auto mesh = lf::mesh::test_utils::GenerateHybrid2DTestMesh(0);
+
+  // scalar expression with several leaves
+  auto mfC = MeshFunctionConstant(2.);
+  auto mfD = MeshFunctionConstant(3.);
+  checkMeshFunctionEqual(
+      *mesh, (mfA + mfB) * mfC - mfD, MeshFunctionGlobal([](auto x) {
+        return (x[0] * x[0] + 2 * x[1] + x[0]) * 2. - 3.;
+      }));
+
+  // leaves of the same type must not share their values
+  checkMeshFunctionEqual(*mesh, (mfC + mfA) * (mfD + mfA),
+                         MeshFunctionGlobal([](auto x) {
+                           return (2. + x[0] * x[0] + x[1]) *
+                                  (3. + x[0] * x[0] + x[1]);
+                         }));
+
+  // matrix and vector valued subexpressions
+  checkMeshFunctionEqual(
+      *mesh, mfA * (mfMatrixA * (mfVectorA + mfVectorB)) - mfVectorB,
+      MeshFunctionGlobal([](auto x) -> Eigen::Vector2d {
+        Eigen::Vector2d v(2 * x[0], x[1] + 2 * x[0]);
+        return (x[0] * x[0] + x[1]) * (x * x.transpose()) * v -
+               Eigen::Vector2d(x[0], 2 * x[0]);
+      }));
+  checkMeshFunctionEqual(
+      *mesh, mfA * (mfMatrixA * (mfVectorA_dynamic + mfVectorB)),
+      MeshFunctionGlobal([](auto x) -> Eigen::Vector2d {
+        Eigen::Vector2d v(2 * x[0], x[1] + 2 * x[0]);
+        return (x[0] * x[0] + x[1]) * (x * x.transpose()) * v;
+      }));
+  checkMeshFunctionEqual(
+      *mesh, transpose(mfVectorA - mfVectorB) * (mfVectorA + mfVectorB),
+      MeshFunctionGlobal([](auto x) {
+        return (Eigen::Matrix<double, 1, 1>()
+                << x.squaredNorm() - Eigen::Vector2d(x[0], 2 * x[0])
+                                         .squaredNorm())
+            .finished();
+      }));
+  checkMeshFunctionEqual(*mesh, -squaredNorm(mfVectorA + mfVectorB) * mfB,
+                         MeshFunctionGlobal([](auto x) {
+                           return -Eigen::Vector2d(2 * x[0], x[1] + 2 * x[0])
+                                       .squaredNorm() *
+                                  (x[0] + x[1]);
+                         }));
+}
+
 }  // namespace lf::mesh::utils::test
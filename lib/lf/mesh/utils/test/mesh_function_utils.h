@@ -10,52 +10,60 @@
 
 namespace lf::mesh::utils::test {
 
-/** Checks whether two mesh functions are equal */
-template <class A, class B>
-void checkMeshFunctionEqual(const mesh::Mesh& m, A a, B b, int codim = 0) {
-  using scalar_t = MeshFunctionReturnType<A>;
-  static_assert(std::is_convertible_v<scalar_t, MeshFunctionReturnType<B>>);
-
-  if constexpr (std::is_arithmetic_v<scalar_t>) {
-    for (auto e : m.Entities(codim)) {
-      auto ref_el = e->RefEl();
-      auto qr = lf::quad::make_QuadRule(ref_el, 5);
-      auto vals1 = a(*e, qr.Points());
-      auto vals2 = b(*e, qr.Points());
-      for (int i = 0; i < vals1.size(); ++i) {
-        EXPECT_LT(vals1[i] - vals2[i], 1e-10) << "i=" << i;
-      }
+/** Checks whether two vectors of mesh function values are equal */
+template <class U, class V>
+void checkValuesEqual(const std::vector<U>& vals1, const std::vector<V>& vals2) {
+  ASSERT_EQ(vals1.size(), vals2.size());
+  if constexpr (std::is_arithmetic_v<U>) {
+    for (int i = 0; i < vals1.size(); ++i) {
+      EXPECT_LT(vals1[i] - vals2[i], 1e-10) << "i=" << i;
     }
-  } else if constexpr (std::is_convertible_v<MeshFunctionReturnType<A>,
-                                             Eigen::MatrixXd> ||
-                       std::is_convertible_v<MeshFunctionReturnType<A>,
-                                             Eigen::ArrayXd>) {
-    for (auto e : m.Entities(codim)) {
-      auto ref_el = e->RefEl();
-      auto qr = lf::quad::make_QuadRule(ref_el, 5);
-      auto vals1 = a(*e, qr.Points());
-      auto vals2 = b(*e, qr.Points());
-      for (int i = 0; i < vals1.size(); ++i) {
-        ASSERT_EQ(vals1[i].rows(), vals2[i].rows());
-        ASSERT_EQ(vals1[i].cols(), vals2[i].cols());
-        for (int r = 0; r < vals1[i].rows(); ++r) {
-          for (int c = 0; c < vals1[i].cols(); ++c) {
-            EXPECT_LT(std::abs(vals1[i](r, c) - vals2[i](r, c)), 1e-10);
-          }
+  } else if constexpr (std::is_convertible_v<U, Eigen::MatrixXd> ||
+                       std::is_convertible_v<U, Eigen::ArrayXd>) {
+    for (int i = 0; i < vals1.size(); ++i) {
+      ASSERT_EQ(vals1[i].rows(), vals2[i].rows());
+      ASSERT_EQ(vals1[i].cols(), vals2[i].cols());
+      for (int r = 0; r < vals1[i].rows(); ++r) {
+        for (int c = 0; c < vals1[i].cols(); ++c) {
+          EXPECT_LT(std::abs(vals1[i](r, c) - vals2[i](r, c)), 1e-10);
         }
       }
     }
   } else {
-    for (auto e : m.Entities(codim)) {
-      auto ref_el = e->RefEl();
-      auto qr = lf::quad::make_QuadRule(ref_el, 5);
-      auto vals1 = a(*e, qr.Points());
-      auto vals2 = b(*e, qr.Points());
-      for (int i = 0; i < vals1.size(); ++i) {
-        EXPECT_EQ(vals1[i], vals2[i]) << "i=" << i;
-      }
+    for (int i = 0; i < vals1.size(); ++i) {
+      EXPECT_EQ(vals1[i], vals2[i]) << "i=" << i;
     }
   }
 }
 
+/** Checks whether two mesh functions are equal
+ *
+ * The values of both mesh functions are computed with `operator()` and with
+ * EvaluateMeshFunction().
+ */
+template <class A, class B>
+void checkMeshFunctionEqual(const mesh::Mesh& m, A a, B b, int codim = 0) {
+  using scalar_t = MeshFunctionReturnType<A>;
+  static_assert(std::is_convertible_v<scalar_t, MeshFunctionReturnType<B>>);
+
+  for (auto e : m.Entities(codim)) {
+    auto ref_el = e->RefEl();
+    auto qr = lf::quad::make_QuadRule(ref_el, 5);
+    auto vals1 = a(*e, qr.Points());
+    auto vals2 = b(*e, qr.Points());
+    checkValuesEqual(vals1, vals2);
+    std::vector<scalar_t> vals1_into(qr.NumPoints());
+    EvaluateMeshFunction(
+        a, *e, qr.Points(),
+        nonstd::span<scalar_t>(vals1_into.data(), vals1_into.size()));
+    checkValuesEqual(vals1_into, vals2);
+    std::vector<MeshFunctionReturnType<B>> vals2_into(qr.NumPoints());
+    EvaluateMeshFunction(
+        b, *e, qr.Points(),
+        nonstd::span<MeshFunctionReturnType<B>>(vals2_into.data(),
+                                                vals2_into.size()));
+    checkValuesEqual(vals1, vals2_into);
+  }
+}
+
 }  // namespace lf::mesh::utils::test
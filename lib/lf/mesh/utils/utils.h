@@ -21,6 +21,7 @@ namespace lf::mesh::utils {}
 #include "mesh_data_set.h"
 #include "mesh_function_binary.h"
 #include "mesh_function_constant.h"
+#include "mesh_function_eval.h"
 #include "mesh_function_global.h"
 #include "mesh_function_traits.h"
 #include "mesh_function_unary.h"
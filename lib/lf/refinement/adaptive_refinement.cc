@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @brief Implementation of Dörfler marking and of the adaptive refinement
+ * driver
+ */
+
+#include "adaptive_refinement.h"
+#include <algorithm>
+#include <numeric>
+
+namespace lf::refinement {
+
+std::vector<glb_idx_t> DoerflerMarking(nonstd::span<const double> eta_squared,
+                                       double theta) {
+  LF_ASSERT_MSG(theta >= 0.0 && theta <= 1.0,
+                "Bulk parameter theta = " << theta << " not in [0,1]");
+  const std::size_t n = eta_squared.size();
+  std::vector<glb_idx_t> idx(n);
+  std::iota(idx.begin(), idx.end(), 0);
+  const double needed =
+      theta * std::accumulate(eta_squared.begin(), eta_squared.end(), 0.0);
+  if (needed <= 0.0) {
+    return {};
+  }
+  auto larger = [&eta_squared](glb_idx_t i, glb_idx_t j) {
+    return eta_squared[i] > eta_squared[j];
+  };
+
+  // Invariant: the cells idx[0,begin) are selected and do not meet the bulk
+  // criterion, whereas the cells idx[0,end) do. Every cell in idx[begin,end)
+  // has an indicator not larger than those in idx[0,begin).
+  std::size_t begin = 0;
+  std::size_t end = n;
+  double taken = 0.0;
+  while (end - begin > 1) {
+    const std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(idx.begin() + begin, idx.begin() + mid,
+                     idx.begin() + end, larger);
+    double sum = 0.0;
+    for (std::size_t k = begin; k < mid; ++k) {
+      sum += eta_squared[idx[k]];
+    }
+    if (taken + sum >= needed) {
+      end = mid;
+    } else {
+      taken += sum;
+      begin = mid;
+    }
+  }
+  idx.resize(end);
+  return idx;
+}
+
+AdaptiveRefinementDriver::AdaptiveRefinementDriver(
+    std::shared_ptr<MeshHierarchy> mh, double theta, unsigned int num_threads)
+    : mh_(std::move(mh)), theta_(theta), num_threads_(num_threads) {
+  LF_VERIFY_MSG(mh_ != nullptr, "No mesh hierarchy supplied");
+  LF_VERIFY_MSG(theta_ >= 0.0 && theta_ <= 1.0,
+                "Bulk parameter theta = " << theta_ << " not in [0,1]");
+}
+
+const std::vector<glb_idx_t> &AdaptiveRefinementDriver::MarkAndRefine() {
+  const auto mesh = mh_->getMesh(mh_->NumLevels() - 1);
+  LF_VERIFY_MSG(eta_squared_.size() == mesh->NumEntities(0),
+                "No error indicators for the finest mesh, call Estimate()");
+
+  auto start = std::chrono::steady_clock::now();
+  marked_cells_ = DoerflerMarking(eta_squared_, theta_);
+  std::vector<bool> edge_marked(mesh->NumEntities(1), false);
+  for (const glb_idx_t cell_idx : marked_cells_) {
+    for (const mesh::Entity *edge :
+         mesh->EntityByIndex(0, cell_idx)->SubEntities(1)) {
+      edge_marked[mesh->Index(*edge)] = true;
+    }
+  }
+  mh_->MarkEdges([&edge_marked](const mesh::Mesh &m, const mesh::Entity &e) {
+    return static_cast<bool>(edge_marked[m.Index(e)]);
+  });
+  timings_.mark += Seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  mh_->RefineMarked();
+  timings_.refine += Seconds(start);
+  timings_.steps++;
+  // The indicators belong to the previous finest mesh
+  eta_squared_.clear();
+  return marked_cells_;
+}
+
+}  // namespace lf::refinement
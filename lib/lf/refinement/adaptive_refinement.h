@@ -0,0 +1,357 @@
+#ifndef LF_REFINEMENT_ADAPTIVE_REFINEMENT_H
+#define LF_REFINEMENT_ADAPTIVE_REFINEMENT_H
+
+/**
+ * @file
+ * @brief Residual based a posteriori error indicators, Dörfler marking and a
+ * driver for adaptive refinement of the finest mesh of a MeshHierarchy
+ */
+
+#include <lf/base/parallel.h>
+#include <lf/geometry/geometry.h>
+#include <lf/mesh/utils/utils.h>
+#include <lf/quad/quad.h>
+#include <lf/refinement/mesh_hierarchy.h>
+#include <lf/uscalfe/uscalfe.h>
+#include <Eigen/Dense>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace lf::refinement {
+
+/**
+ * @brief Select cells by the bulk criterion of Dörfler
+ *
+ * @param eta_squared squared error indicators \f$\eta_K^2\f$ of all cells,
+ * indexed by cell index
+ * @param theta bulk parameter \f$\theta\in[0,1]\f$
+ * @return indices of a set \f$\mathcal{M}\f$ of cells of least cardinality
+ * such that \f$\sum_{K\in\mathcal{M}}\eta_K^2 \geq
+ * \theta\sum_{K}\eta_K^2\f$. It consists of the cells with the largest
+ * indicators. The indices are not sorted.
+ *
+ * Instead of sorting all indicators, the set is found by repeatedly splitting
+ * the remaining candidates at their median with `std::nth_element()`. Every
+ * step halves the number of candidates, so that the selection takes O(N)
+ * operations on average for N cells.
+ */
+std::vector<glb_idx_t> DoerflerMarking(nonstd::span<const double> eta_squared,
+                                       double theta);
+
+/**
+ * @brief Residual based a posteriori error indicators for a linear finite
+ * element solution of a second-order elliptic boundary value problem
+ *
+ * @tparam MF_ALPHA \ref mesh_function "MeshFunction" type for the diffusion
+ * coefficient, scalar or 2x2-matrix valued and constant on every cell
+ * @tparam MF_GAMMA scalar valued \ref mesh_function "MeshFunction" type for
+ * the reaction coefficient
+ * @tparam MF_F scalar valued \ref mesh_function "MeshFunction" type for the
+ * source function
+ * @param fe_space linear Lagrangian finite element space on a planar mesh
+ * consisting of triangles only
+ * @param mu coefficient vector of the finite element solution \f$u_h\f$
+ * @param alpha diffusion coefficient \f$\alpha\f$
+ * @param gamma reaction coefficient \f$\gamma\f$
+ * @param f source function \f$f\f$
+ * @param num_threads maximal number of threads to use
+ * @return the squared indicator \f$\eta_K^2\f$ for every cell, indexed by
+ * cell index
+ *
+ * For the boundary value problem \f$-\nabla\cdot(\alpha\nabla u)+\gamma u=f\f$
+ * with Dirichlet boundary conditions the indicators are
+ * \f[
+ *   \eta_K^2 = h_K^2\,\|f-\gamma u_h\|^2_{L^2(K)} + \frac{1}{2}
+ *   \sum_{e\subset\partial K\setminus\partial\Omega}
+ *   h_e\,\|[\alpha\nabla u_h\cdot\mathbf{n}]_e\|^2_{L^2(e)}\;,
+ * \f]
+ * where \f$h_K\f$ is the diameter of the cell \f$K\f$ and \f$h_e\f$ the length
+ * of the edge \f$e\f$. The element residual omits the term
+ * \f$\nabla\cdot(\alpha\nabla u_h)\f$. It vanishes on every triangle, because
+ * \f$u_h\f$ is linear there, provided that \f$\alpha\f$ is constant on every
+ * cell. Ensuring this is the responsibility of the caller, it is not checked.
+ * Higher polynomial degrees and quadrilaterals are rejected.
+ *
+ * The computation runs in three concurrent phases, none of which needs
+ * synchronization:
+ * - per cell: the element residual and the fluxes \f$\alpha\nabla u_h\f$ at
+ *   the quadrature points of its edges, in the orientation of the edges,
+ * - per interior edge: the jump of the normal flux between its two cells,
+ * - per cell: the sum of the element residual and the jump terms.
+ */
+template <class MF_ALPHA, class MF_GAMMA, class MF_F>
+std::vector<double> ResidualErrorIndicators(
+    const std::shared_ptr<const uscalfe::UniformScalarFESpace<double>>
+        &fe_space,
+    const Eigen::VectorXd &mu, MF_ALPHA alpha, MF_GAMMA gamma, MF_F f,
+    unsigned int num_threads = base::DefaultNumThreads()) {
+  using mf_uh_t = uscalfe::MeshFunctionFE<double, double>;
+  using mf_grad_uh_t = uscalfe::MeshFunctionGradFE<double, double>;
+  // Tag of the thread-local buffers for the values of the mesh functions
+  struct BufferTag {};
+
+  const mesh::Mesh &mesh{*fe_space->Mesh()};
+  LF_VERIFY_MSG(mesh.DimMesh() == 2 && mesh.DimWorld() == 2,
+                "Only implemented for planar 2D meshes");
+  const auto layout = fe_space->ShapeFunctionLayout(base::RefEl::kTria());
+  LF_VERIFY_MSG(layout != nullptr && layout->Degree() == 1,
+                "Only implemented for linear finite elements");
+  const mf_uh_t uh(fe_space, mu);
+  const mf_grad_uh_t grad_uh(fe_space, mu);
+  const size_type no_of_cells = mesh.NumEntities(0);
+  const size_type no_of_edges = mesh.NumEntities(1);
+  // Below about a thousand items per thread starting the threads does not pay
+  auto num_chunks = [num_threads](std::size_t n) {
+    return std::max(1U, std::min(num_threads,
+                                 static_cast<unsigned int>(1 + n / 1024)));
+  };
+
+  // Quadrature rules exact for the squares of linear functions
+  const quad::QuadRule qr_cell{quad::make_QuadRule(base::RefEl::kTria(), 2)};
+  const quad::QuadRule qr_edge{
+      quad::make_QuadRule(base::RefEl::kSegment(), 2)};
+  const size_type nq = qr_edge.NumPoints();
+  // Quadrature points of the edges in reference coordinates of the triangle:
+  // [local edge][orientation reversed]
+  std::array<std::array<Eigen::MatrixXd, 2>, 3> edge_points;
+  const base::RefEl tria = base::RefEl::kTria();
+  for (unsigned int j = 0; j < 3; ++j) {
+    const Eigen::Vector2d a{
+        tria.NodeCoords().col(tria.SubSubEntity2SubEntity(1, j, 1, 0))};
+    const Eigen::Vector2d b{
+        tria.NodeCoords().col(tria.SubSubEntity2SubEntity(1, j, 1, 1))};
+    for (int reversed = 0; reversed < 2; ++reversed) {
+      Eigen::MatrixXd &pts{edge_points[j][reversed]};
+      pts.resize(2, nq);
+      for (size_type q = 0; q < nq; ++q) {
+        const double s = qr_edge.Points()(0, q);
+        pts.col(q) = a + ((reversed != 0) ? 1.0 - s : s) * (b - a);
+      }
+    }
+  }
+
+  // Phase I: element residuals and fluxes at the quadrature points of the
+  // edges of every cell, stored in slot 3*(cell index)+(local edge index)
+  std::vector<double> eta_squared(no_of_cells, 0.0);
+  std::vector<Eigen::Vector2d> flux(3 * nq * no_of_cells);
+  base::ParallelForChunks(
+      no_of_cells, num_chunks(no_of_cells),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        // The values of the mesh functions are evaluated into buffers, which
+        // every thread reuses for all of its cells
+        auto f_vals = mesh::utils::ThreadLocalBuffer<
+            mesh::utils::MeshFunctionReturnType<MF_F>, BufferTag, 0>(
+            qr_cell.NumPoints());
+        auto gamma_vals = mesh::utils::ThreadLocalBuffer<
+            mesh::utils::MeshFunctionReturnType<MF_GAMMA>, BufferTag, 1>(
+            qr_cell.NumPoints());
+        auto uh_vals = mesh::utils::ThreadLocalBuffer<
+            mesh::utils::MeshFunctionReturnType<mf_uh_t>, BufferTag, 2>(
+            qr_cell.NumPoints());
+        auto grad_vals = mesh::utils::ThreadLocalBuffer<
+            mesh::utils::MeshFunctionReturnType<mf_grad_uh_t>, BufferTag, 3>(
+            nq);
+        auto alpha_vals = mesh::utils::ThreadLocalBuffer<
+            mesh::utils::MeshFunctionReturnType<MF_ALPHA>, BufferTag, 4>(nq);
+        for (std::size_t c = begin; c < end; ++c) {
+          const mesh::Entity &cell{*mesh.EntityByIndex(0, c)};
+          LF_VERIFY_MSG(cell.RefEl() == base::RefEl::kTria(),
+                        "Only implemented for triangular meshes");
+          const geometry::Geometry &geo{*cell.Geometry()};
+          mesh::utils::EvaluateMeshFunction(f, cell, qr_cell.Points(), f_vals);
+          mesh::utils::EvaluateMeshFunction(gamma, cell, qr_cell.Points(),
+                                            gamma_vals);
+          mesh::utils::EvaluateMeshFunction(uh, cell, qr_cell.Points(),
+                                            uh_vals);
+          const Eigen::VectorXd weights{qr_cell.Weights().cwiseProduct(
+              geo.IntegrationElement(qr_cell.Points()))};
+          double residual = 0.0;
+          for (size_type q = 0; q < qr_cell.NumPoints(); ++q) {
+            const double r = f_vals[q] - gamma_vals[q] * uh_vals[q];
+            residual += weights[q] * r * r;
+          }
+          const Eigen::MatrixXd corners{geometry::Corners(geo)};
+          double h = 0.0;
+          for (Eigen::Index i = 0; i < corners.cols(); ++i) {
+            for (Eigen::Index k = i + 1; k < corners.cols(); ++k) {
+              h = std::max(h, (corners.col(i) - corners.col(k)).norm());
+            }
+          }
+          eta_squared[c] = h * h * residual;
+
+          const auto orientations = cell.RelativeOrientations();
+          for (Eigen::Index j = 0; j < orientations.size(); ++j) {
+            const Eigen::MatrixXd &pts{
+                edge_points[j][orientations[j] == mesh::Orientation::negative]};
+            mesh::utils::EvaluateMeshFunction(grad_uh, cell, pts, grad_vals);
+            mesh::utils::EvaluateMeshFunction(alpha, cell, pts, alpha_vals);
+            for (size_type q = 0; q < nq; ++q) {
+              flux[(3 * c + j) * nq + q] = alpha_vals[q] * grad_vals[q];
+            }
+          }
+        }
+      });
+
+  // Slots of the two cells adjacent to every edge, idx_nil for boundary edges
+  std::vector<std::array<size_type, 2>> edge_slots(
+      no_of_edges, {base::kIdxNil, base::kIdxNil});
+  for (const mesh::Entity *cell : mesh.Entities(0)) {
+    const size_type c = mesh.Index(*cell);
+    const auto edges = cell->SubEntities(1);
+    for (Eigen::Index j = 0; j < edges.size(); ++j) {
+      std::array<size_type, 2> &slots{edge_slots[mesh.Index(*edges[j])]};
+      slots[(slots[0] == base::kIdxNil) ? 0 : 1] = 3 * c + j;
+    }
+  }
+
+  // Phase II: jumps of the normal fluxes across the interior edges
+  std::vector<double> jump_squared(no_of_edges, 0.0);
+  base::ParallelForChunks(
+      no_of_edges, num_chunks(no_of_edges),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t e = begin; e < end; ++e) {
+          const std::array<size_type, 2> &slots{edge_slots[e]};
+          if (slots[1] == base::kIdxNil) {
+            continue;
+          }
+          const geometry::Geometry &geo{*mesh.EntityByIndex(1, e)->Geometry()};
+          const Eigen::MatrixXd jac{geo.Jacobian(qr_edge.Points())};
+          const Eigen::VectorXd weights{qr_edge.Weights().cwiseProduct(
+              geo.IntegrationElement(qr_edge.Points()))};
+          double jump = 0.0;
+          for (size_type q = 0; q < nq; ++q) {
+            // The sign of the normal does not matter for the squared jump
+            const Eigen::Vector2d normal =
+                Eigen::Vector2d(jac(1, q), -jac(0, q)).normalized();
+            const double flux_jump =
+                (flux[slots[0] * nq + q] - flux[slots[1] * nq + q]).dot(normal);
+            jump += weights[q] * flux_jump * flux_jump;
+          }
+          jump_squared[e] = weights.sum() * jump;
+        }
+      });
+
+  // Phase III: add half of the jump terms of its edges to every cell
+  base::ParallelForChunks(
+      no_of_cells, num_chunks(no_of_cells),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+          for (const mesh::Entity *edge :
+               mesh.EntityByIndex(0, c)->SubEntities(1)) {
+            eta_squared[c] += 0.5 * jump_squared[mesh.Index(*edge)];
+          }
+        }
+      });
+  return eta_squared;
+}
+
+/**
+ * @brief Driver for the adaptive loop ESTIMATE -> MARK -> REFINE acting on the
+ * finest mesh of a MeshHierarchy
+ *
+ * In every step of an adaptive algorithm the caller solves the discrete
+ * problem on the finest mesh and passes the solution to Estimate(). Then
+ * MarkAndRefine() selects cells by DoerflerMarking(), marks all of their edges
+ * and calls MeshHierarchy::RefineMarked().
+ *
+ * The wall-clock time spent in each phase is accumulated and can be queried
+ * with Timings().
+ */
+class AdaptiveRefinementDriver {
+ public:
+  /** @brief Cumulative wall-clock times in seconds of the phases */
+  struct PhaseTimings {
+    /** @brief computation of the error indicators */
+    double estimate = 0.0;
+    /** @brief selection of the cells and marking of their edges */
+    double mark = 0.0;
+    /** @brief local refinement by MeshHierarchy::RefineMarked() */
+    double refine = 0.0;
+    /** @brief number of refinement steps */
+    unsigned int steps = 0;
+  };
+
+  /**
+   * @brief Set up the driver
+   * @param mh the mesh hierarchy whose finest mesh is to be refined
+   * @param theta bulk parameter for DoerflerMarking()
+   * @param num_threads maximal number of threads for Estimate()
+   */
+  AdaptiveRefinementDriver(
+      std::shared_ptr<MeshHierarchy> mh, double theta,
+      unsigned int num_threads = base::DefaultNumThreads());
+
+  /**
+   * @brief Compute the error indicators for a solution on the finest mesh
+   *
+   * @param fe_space finite element space on the finest mesh of the hierarchy
+   * @param mu coefficient vector of the finite element solution
+   * @param alpha diffusion coefficient
+   * @param gamma reaction coefficient
+   * @param f source function
+   * @return the global error estimate \f$(\sum_K\eta_K^2)^{1/2}\f$
+   *
+   * @sa ResidualErrorIndicators()
+   */
+  template <class MF_ALPHA, class MF_GAMMA, class MF_F>
+  double Estimate(
+      const std::shared_ptr<const uscalfe::UniformScalarFESpace<double>>
+          &fe_space,
+      const Eigen::VectorXd &mu, MF_ALPHA alpha, MF_GAMMA gamma, MF_F f) {
+    LF_ASSERT_MSG(fe_space->Mesh() == mh_->getMesh(mh_->NumLevels() - 1),
+                  "FE space must live on the finest mesh");
+    const auto start = std::chrono::steady_clock::now();
+    eta_squared_ = ResidualErrorIndicators(fe_space, mu, std::move(alpha),
+                                           std::move(gamma), std::move(f),
+                                           num_threads_);
+    double total = 0.0;
+    for (const double eta_sq : eta_squared_) {
+      total += eta_sq;
+    }
+    timings_.estimate += Seconds(start);
+    return std::sqrt(total);
+  }
+
+  /**
+   * @brief Refine the cells selected by Dörfler marking of the error
+   * indicators computed by the last call of Estimate()
+   *
+   * @return indices of the selected cells of the mesh before refinement
+   */
+  const std::vector<glb_idx_t> &MarkAndRefine();
+
+  /** @brief Squared error indicators computed by the last call of Estimate()
+   */
+  [[nodiscard]] const std::vector<double> &ErrorIndicators() const {
+    return eta_squared_;
+  }
+
+  /** @brief The mesh hierarchy acted upon */
+  [[nodiscard]] const MeshHierarchy &Hierarchy() const { return *mh_; }
+
+  /** @brief Time spent in the phases of the adaptive loop so far */
+  [[nodiscard]] const PhaseTimings &Timings() const { return timings_; }
+
+  /** @brief Reset all timing counters */
+  void ResetTimings() { timings_ = PhaseTimings{}; }
+
+ private:
+  // Seconds elapsed since `start`
+  static double Seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+  }
+
+  std::shared_ptr<MeshHierarchy> mh_;
+  double theta_;
+  unsigned int num_threads_;
+  std::vector<double> eta_squared_;
+  std::vector<glb_idx_t> marked_cells_;
+  PhaseTimings timings_;
+};
+
+}  // namespace lf::refinement
+
+#endif  // LF_REFINEMENT_ADAPTIVE_REFINEMENT_H
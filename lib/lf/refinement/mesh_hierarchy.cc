@@ -4,6 +4,7 @@
  */
 
 #include "mesh_hierarchy.h"
+#include <queue>
 #include "lf/mesh/hybrid2d/hybrid2d.h"
 #include "lf/mesh/utils/utils.h"
 
@@ -108,6 +109,373 @@ void MeshHierarchy::RefineRegular(RefPat ref_pat) {
   initGeometryInParent();
 }
 
+namespace {
+
+// Chunks for distributing n entities onto at most num_threads threads: every
+// chunk should contain enough entities to outweigh the cost of a thread.
+unsigned int NumRefinementChunks(std::size_t n, unsigned int num_threads) {
+  constexpr std::size_t min_chunk_size = 1U << 11U;
+  return static_cast<unsigned int>(
+      std::min<std::size_t>(num_threads, 1 + n / min_chunk_size));
+}
+
+// Connectivity of the children of a cell under uniform refinement, given in
+// terms of a local numbering of the nodes of the refined cell: first the
+// vertices, then the midpoints of the edges, finally the interior point (if
+// any). The order of the children matches that of PerformRefinement().
+struct UniformChildTopology {
+  std::vector<std::vector<sub_idx_t>> cells;
+  std::vector<std::array<sub_idx_t, 2>> edges;
+};
+
+const UniformChildTopology &GetUniformChildTopology(lf::base::RefEl ref_el,
+                                                    RefPat ref_pat) {
+  static const UniformChildTopology tria_regular{
+      {{0, 3, 5}, {1, 3, 4}, {2, 5, 4}, {3, 4, 5}}, {{3, 5}, {3, 4}, {5, 4}}};
+  static const UniformChildTopology tria_barycentric{
+      {{0, 3, 6}, {1, 3, 6}, {1, 4, 6}, {2, 4, 6}, {2, 5, 6}, {0, 5, 6}},
+      {{0, 6}, {1, 6}, {2, 6}, {3, 6}, {4, 6}, {5, 6}}};
+  static const UniformChildTopology quad{
+      {{0, 4, 8, 7}, {1, 5, 8, 4}, {2, 5, 8, 6}, {3, 6, 8, 7}},
+      {{4, 8}, {5, 8}, {6, 8}, {7, 8}}};
+  if (ref_el == lf::base::RefEl::kTria()) {
+    return (ref_pat == RefPat::rp_regular) ? tria_regular : tria_barycentric;
+  }
+  LF_VERIFY_MSG(ref_el == lf::base::RefEl::kQuad(),
+                "Unknown cell type" << ref_el.ToString());
+  return quad;
+}
+
+}  // namespace
+
+void MeshHierarchy::RefineRegularParallel(RefPat ref_pat,
+                                          unsigned int num_threads) {
+  LF_VERIFY_MSG(
+      ref_pat == RefPat::rp_regular || ref_pat == RefPat::rp_barycentric,
+      "Only regular or barycentric uniform refinement possible");
+  LF_VERIFY_MSG(num_threads > 0, "At least one thread required");
+  // Retrieve the finest mesh in the hierarchy
+  const mesh::Mesh &parent_mesh(*meshes_.back());
+  // Arrays containing refinement information for finest mesh
+  std::vector<PointChildInfo> &pt_child_info(point_child_infos_.back());
+  std::vector<EdgeChildInfo> &ed_child_info(edge_child_infos_.back());
+  std::vector<CellChildInfo> &cell_child_info(cell_child_infos_.back());
+
+  LF_VERIFY_MSG(pt_child_info.size() == parent_mesh.NumEntities(2),
+                "length mismatch PointChildInfo vector");
+  LF_VERIFY_MSG(ed_child_info.size() == parent_mesh.NumEntities(1),
+                "length mismatch EdgeChildInfo vector");
+  LF_VERIFY_MSG(cell_child_info.size() == parent_mesh.NumEntities(0),
+                "length mismatch CellChildInfo vector");
+
+  const auto nodes = parent_mesh.Entities(2);
+  const auto edges = parent_mesh.Entities(1);
+  const auto cells = parent_mesh.Entities(0);
+  const size_type num_nodes = nodes.size();
+  const size_type num_edges = edges.size();
+  const size_type num_cells = cells.size();
+
+  // Uniform refinement patterns for all cell types
+  const Hybrid2DRefinementPattern rp_point(lf::base::RefEl::kPoint(),
+                                           RefPat::rp_copy);
+  const Hybrid2DRefinementPattern rp_segment(lf::base::RefEl::kSegment(),
+                                             RefPat::rp_split);
+  const Hybrid2DRefinementPattern rp_tria(lf::base::RefEl::kTria(), ref_pat);
+  const Hybrid2DRefinementPattern rp_quad(lf::base::RefEl::kQuad(), ref_pat);
+  auto cell_pattern = [&](const mesh::Entity &cell)
+      -> const Hybrid2DRefinementPattern & {
+    return (cell.RefEl() == lf::base::RefEl::kTria()) ? rp_tria : rp_quad;
+  };
+
+  // The new entities are numbered in the same order as in
+  // PerformRefinement(): child points of nodes, midpoints of edges, interior
+  // points of cells; the two children of every edge, interior edges of
+  // cells; child cells. The first index of the interior children of co-
+  // dimension d of the k-th cell is stored in cell_offsets[k][d].
+  std::vector<std::array<glb_idx_t, 3>> cell_offsets(num_cells + 1);
+  cell_offsets[0] = {0, 2 * num_edges, num_nodes + num_edges};
+  for (size_type k = 0; k < num_cells; ++k) {
+    const Hybrid2DRefinementPattern &rp(cell_pattern(*cells[k]));
+    for (dim_t codim = 0; codim <= 2; ++codim) {
+      cell_offsets[k + 1][codim] =
+          cell_offsets[k][codim] + rp.NumChildren(codim);
+    }
+  }
+  const size_type num_new_cells = cell_offsets[num_cells][0];
+  const size_type num_new_edges = cell_offsets[num_cells][1];
+  const size_type num_new_points = cell_offsets[num_cells][2];
+
+  // Geometries and vertex indices of the new entities, ordered by their index
+  std::vector<std::unique_ptr<geometry::Geometry>> point_geo(num_new_points);
+  std::vector<std::unique_ptr<geometry::Geometry>> edge_geo(num_new_edges);
+  std::vector<std::unique_ptr<geometry::Geometry>> cell_geo(num_new_cells);
+  std::vector<std::array<glb_idx_t, 2>> edge_nodes(num_new_edges);
+  std::vector<std::vector<glb_idx_t>> cell_nodes(num_new_cells);
+
+  // Every node is copied
+  lf::base::ParallelForChunks(
+      num_nodes, NumRefinementChunks(num_nodes, num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          PointChildInfo &pt_ci(pt_child_info[parent_mesh.Index(*nodes[k])]);
+          pt_ci.ref_pat = RefPat::rp_copy;
+          pt_ci.child_point_idx = k;
+          std::vector<std::unique_ptr<geometry::Geometry>> pt_child_geo_ptrs(
+              nodes[k]->Geometry()->ChildGeometry(rp_point, 0));
+          LF_VERIFY_MSG(pt_child_geo_ptrs.size() == 1,
+                        "A point can only have one child");
+          point_geo[k] = std::move(pt_child_geo_ptrs[0]);
+        }
+      });
+
+  // Every edge is split into two edges
+  lf::base::ParallelForChunks(
+      num_edges, NumRefinementChunks(num_edges, num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          const mesh::Entity &edge(*edges[k]);
+          EdgeChildInfo &ed_ci(ed_child_info[parent_mesh.Index(edge)]);
+          auto ed_nodes(edge.SubEntities(1));
+          const glb_idx_t first_node_idx =
+              pt_child_info[parent_mesh.Index(*ed_nodes[0])].child_point_idx;
+          const glb_idx_t second_node_idx =
+              pt_child_info[parent_mesh.Index(*ed_nodes[1])].child_point_idx;
+          const glb_idx_t midpoint_idx = num_nodes + k;
+          ed_ci.ref_pat_ = RefPat::rp_split;
+          ed_ci.child_point_idx = {midpoint_idx};
+          ed_ci.child_edge_idx = {static_cast<glb_idx_t>(2 * k),
+                                  static_cast<glb_idx_t>(2 * k + 1)};
+
+          std::vector<std::unique_ptr<geometry::Geometry>> ed_pt_ptrs(
+              edge.Geometry()->ChildGeometry(rp_segment, 1));
+          std::vector<std::unique_ptr<geometry::Geometry>> ed_child_ptrs(
+              edge.Geometry()->ChildGeometry(rp_segment, 0));
+          LF_VERIFY_MSG(ed_pt_ptrs.size() == 1 && ed_child_ptrs.size() == 2,
+                        "Wrong number of children of a split edge");
+          point_geo[midpoint_idx] = std::move(ed_pt_ptrs[0]);
+          edge_nodes[2 * k] = {first_node_idx, midpoint_idx};
+          edge_geo[2 * k] = std::move(ed_child_ptrs[0]);
+          edge_nodes[2 * k + 1] = {midpoint_idx, second_node_idx};
+          edge_geo[2 * k + 1] = std::move(ed_child_ptrs[1]);
+        }
+      });
+
+  // Every cell is refined according to ref_pat
+  lf::base::ParallelForChunks(
+      num_cells, NumRefinementChunks(num_cells, num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          const mesh::Entity &cell(*cells[k]);
+          const lf::base::RefEl ref_el = cell.RefEl();
+          const Hybrid2DRefinementPattern &rp(cell_pattern(cell));
+          const UniformChildTopology &topology(
+              GetUniformChildTopology(ref_el, ref_pat));
+          CellChildInfo &cell_ci(cell_child_info[parent_mesh.Index(cell)]);
+          cell_ci.ref_pat_ = ref_pat;
+          cell_ci.child_cell_idx.clear();
+          cell_ci.child_edge_idx.clear();
+          cell_ci.child_point_idx.clear();
+
+          // Indices of the nodes of the refined cell in the fine mesh, in the
+          // local numbering of UniformChildTopology
+          const size_type num_vertices = ref_el.NumNodes();
+          std::vector<glb_idx_t> local_nodes(2 * num_vertices + 1, idx_nil);
+          auto cell_nodes_parent(cell.SubEntities(2));
+          auto cell_edges_parent(cell.SubEntities(1));
+          for (size_type l = 0; l < num_vertices; ++l) {
+            local_nodes[l] =
+                pt_child_info[parent_mesh.Index(*cell_nodes_parent[l])]
+                    .child_point_idx;
+            local_nodes[num_vertices + l] =
+                ed_child_info[parent_mesh.Index(*cell_edges_parent[l])]
+                    .child_point_idx[0];
+          }
+
+          // Interior point
+          {
+            std::vector<std::unique_ptr<geometry::Geometry>> cell_pt_ptrs(
+                cell.Geometry()->ChildGeometry(rp, 2));
+            LF_VERIFY_MSG(cell_pt_ptrs.size() == rp.NumChildren(2),
+                          "Wrong number of interior points");
+            for (size_type l = 0; l < cell_pt_ptrs.size(); ++l) {
+              const glb_idx_t point_idx = cell_offsets[k][2] + l;
+              point_geo[point_idx] = std::move(cell_pt_ptrs[l]);
+              cell_ci.child_point_idx.push_back(point_idx);
+              local_nodes[2 * num_vertices] = point_idx;
+            }
+          }
+          // Interior edges
+          {
+            std::vector<std::unique_ptr<geometry::Geometry>> cell_edge_ptrs(
+                cell.Geometry()->ChildGeometry(rp, 1));
+            LF_VERIFY_MSG(cell_edge_ptrs.size() == topology.edges.size(),
+                          "num_new_edges = " << cell_edge_ptrs.size()
+                                             << " <-> "
+                                             << topology.edges.size());
+            for (size_type l = 0; l < cell_edge_ptrs.size(); ++l) {
+              const glb_idx_t edge_idx = cell_offsets[k][1] + l;
+              edge_nodes[edge_idx] = {local_nodes[topology.edges[l][0]],
+                                      local_nodes[topology.edges[l][1]]};
+              edge_geo[edge_idx] = std::move(cell_edge_ptrs[l]);
+              cell_ci.child_edge_idx.push_back(edge_idx);
+            }
+          }
+          // Child cells
+          {
+            std::vector<std::unique_ptr<geometry::Geometry>> cell_child_ptrs(
+                cell.Geometry()->ChildGeometry(rp, 0));
+            LF_VERIFY_MSG(cell_child_ptrs.size() == topology.cells.size(),
+                          "num_new_cells = " << cell_child_ptrs.size()
+                                             << " <-> "
+                                             << topology.cells.size());
+            for (size_type l = 0; l < cell_child_ptrs.size(); ++l) {
+              const glb_idx_t child_idx = cell_offsets[k][0] + l;
+              std::vector<glb_idx_t> &ccn(cell_nodes[child_idx]);
+              for (const sub_idx_t local_idx : topology.cells[l]) {
+                ccn.push_back(local_nodes[local_idx]);
+              }
+              cell_geo[child_idx] = std::move(cell_child_ptrs[l]);
+              cell_ci.child_cell_idx.push_back(child_idx);
+            }
+          }
+        }
+      });
+
+  // Register the new entities with the mesh factory in the order of their
+  // indices
+  for (size_type k = 0; k < num_new_points; ++k) {
+    const glb_idx_t new_node_index =
+        mesh_factory_->AddPoint(std::move(point_geo[k]));
+    LF_VERIFY_MSG(new_node_index == k, "Unexpected index of a new point");
+  }
+  for (size_type k = 0; k < num_new_edges; ++k) {
+    const glb_idx_t new_edge_index = mesh_factory_->AddEntity(
+        lf::base::RefEl::kSegment(), edge_nodes[k], std::move(edge_geo[k]));
+    LF_VERIFY_MSG(new_edge_index == k, "Unexpected index of a new edge");
+  }
+  for (size_type k = 0; k < num_new_cells; ++k) {
+    const std::vector<glb_idx_t> &ccn(cell_nodes[k]);
+    const glb_idx_t new_cell_index = mesh_factory_->AddEntity(
+        (ccn.size() == 3) ? lf::base::RefEl::kTria() : lf::base::RefEl::kQuad(),
+        ccn, std::move(cell_geo[k]));
+    LF_VERIFY_MSG(new_cell_index == k, "Unexpected index of a new cell");
+  }
+  meshes_.push_back(mesh_factory_->Build());  // MESH CONSTRUCTION
+  const mesh::Mesh &child_mesh(*meshes_.back());
+  LF_VERIFY_MSG(child_mesh.NumEntities(2) == num_new_points &&
+                    child_mesh.NumEntities(1) == num_new_edges &&
+                    child_mesh.NumEntities(0) == num_new_cells,
+                "Unexpected size of the refined mesh");
+
+  // Create space for data pertaining to the new mesh, references to the
+  // vectors for the parent mesh become invalid
+  AppendLevelData(child_mesh);
+  const size_type n_levels = meshes_.size();
+  const std::vector<PointChildInfo> &parent_pt_ci(
+      point_child_infos_.at(n_levels - 2));
+  const std::vector<EdgeChildInfo> &parent_ed_ci(
+      edge_child_infos_.at(n_levels - 2));
+  const std::vector<CellChildInfo> &parent_cell_ci(
+      cell_child_infos_.at(n_levels - 2));
+  std::vector<ParentInfo> &fine_node_parent_info(parent_infos_.back()[2]);
+  std::vector<ParentInfo> &fine_edge_parent_info(parent_infos_.back()[1]);
+  std::vector<ParentInfo> &fine_cell_parent_info(parent_infos_.back()[0]);
+
+  // Parent information of the new entities: every new entity has exactly one
+  // parent, so that the entries are written independently
+  auto set_parent = [](ParentInfo &pi, const mesh::Entity *parent,
+                       glb_idx_t parent_index, sub_idx_t child_number) {
+    pi.child_number = child_number;
+    pi.parent_ptr = parent;
+    pi.parent_index = parent_index;
+  };
+  lf::base::ParallelForChunks(
+      num_nodes, NumRefinementChunks(num_nodes, num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          const glb_idx_t node_index = parent_mesh.Index(*nodes[k]);
+          set_parent(
+              fine_node_parent_info[parent_pt_ci[node_index].child_point_idx],
+              nodes[k], node_index, 0);
+        }
+      });
+  lf::base::ParallelForChunks(
+      num_edges, NumRefinementChunks(num_edges, num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          const glb_idx_t edge_index = parent_mesh.Index(*edges[k]);
+          const EdgeChildInfo &ed_ci(parent_ed_ci[edge_index]);
+          for (sub_idx_t l = 0; l < ed_ci.child_edge_idx.size(); ++l) {
+            set_parent(fine_edge_parent_info[ed_ci.child_edge_idx[l]],
+                       edges[k], edge_index, l);
+          }
+          for (sub_idx_t l = 0; l < ed_ci.child_point_idx.size(); ++l) {
+            set_parent(fine_node_parent_info[ed_ci.child_point_idx[l]],
+                       edges[k], edge_index, l);
+          }
+        }
+      });
+  lf::base::ParallelForChunks(
+      num_cells, NumRefinementChunks(num_cells, num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          const glb_idx_t cell_index = parent_mesh.Index(*cells[k]);
+          const CellChildInfo &cell_ci(parent_cell_ci[cell_index]);
+          for (sub_idx_t l = 0; l < cell_ci.child_cell_idx.size(); ++l) {
+            set_parent(fine_cell_parent_info[cell_ci.child_cell_idx[l]],
+                       cells[k], cell_index, l);
+          }
+          for (sub_idx_t l = 0; l < cell_ci.child_edge_idx.size(); ++l) {
+            set_parent(fine_edge_parent_info[cell_ci.child_edge_idx[l]],
+                       cells[k], cell_index, l);
+          }
+          for (sub_idx_t l = 0; l < cell_ci.child_point_idx.size(); ++l) {
+            set_parent(fine_node_parent_info[cell_ci.child_point_idx[l]],
+                       cells[k], cell_index, l);
+          }
+        }
+      });
+
+  // Refinement edges of the new triangles, chosen as in PerformRefinement()
+  const std::vector<sub_idx_t> &parent_ref_edges(
+      refinement_edges_.at(n_levels - 2));
+  std::vector<sub_idx_t> &child_ref_edges(refinement_edges_.back());
+  // Refinement edges of the children of a regularly refined triangle, indexed
+  // by the refinement edge of the parent and the child number
+  static const std::array<std::array<sub_idx_t, 4>, 3> regular_ref_edges{
+      {{0, 0, 1, 1}, {1, 2, 2, 2}, {2, 1, 0, 0}}};
+  const auto fine_cells = child_mesh.Entities(0);
+  lf::base::ParallelForChunks(
+      fine_cells.size(), NumRefinementChunks(fine_cells.size(), num_threads),
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+          const mesh::Entity &fine_cell(*fine_cells[k]);
+          if (fine_cell.RefEl() != lf::base::RefEl::kTria()) {
+            continue;
+          }
+          const glb_idx_t cell_index = child_mesh.Index(fine_cell);
+          const ParentInfo &fine_cell_pi(fine_cell_parent_info[cell_index]);
+          LF_VERIFY_MSG(fine_cell_pi.parent_ptr != nullptr,
+                        "Cell " << cell_index << " has no parent");
+          if (fine_cell_pi.parent_ptr->RefEl() == lf::base::RefEl::kTria() &&
+              ref_pat == RefPat::rp_regular) {
+            const sub_idx_t parent_ref_edge =
+                parent_ref_edges[fine_cell_pi.parent_index];
+            LF_VERIFY_MSG(parent_ref_edge < 3, "invalid parent_ref_edge_idx");
+            child_ref_edges[cell_index] =
+                regular_ref_edges[parent_ref_edge][fine_cell_pi.child_number];
+          } else {
+            // Children of barycentrically refined triangles and of
+            // quadrilaterals get their longest edge as refinement edge
+            child_ref_edges[cell_index] = LongestEdge(fine_cell);
+          }
+        }
+      });
+
+  // Finish initialization
+  initGeometryInParent(num_threads);
+}
+
 void MeshHierarchy::RefineMarked() {
   // Target the finest mesh
   const lf::mesh::Mesh &finest_mesh(*meshes_.back());
@@ -149,203 +517,229 @@ void MeshHierarchy::RefineMarked() {
   }
   // Now all edges are initially marked to be split or copied
 
-  // To keep the mesh conforming refinement might have to propagate
-  // This is achieved in the following REPEAT ... UNTIL loop.
-  bool refinement_complete;
-  do {
-    refinement_complete = true;
-    // Visit all cells and update their refinement patterns
-    for (const lf::mesh::Entity *cell : finest_mesh.Entities(0)) {
-      // Obtain unique index of current cell
-      const glb_idx_t cell_index = finest_mesh.Index(*cell);
-      // Detailed description of refinement status
-      CellChildInfo &cell_child_info(finest_cell_ci[cell_index]);
-
-      // Global indices of edges
-      std::array<glb_idx_t, 4> cell_edge_indices{};
-
-      // Find edges which are marked as split
-      std::array<bool, 4> edge_split{{false, false, false, false}};
-      // Local indices of edges marked as split
-      std::array<sub_idx_t, 4> split_edge_idx{};
-      // Array of references to edge sub-entities of current cell
-      nonstd::span<const lf::mesh::Entity *const> sub_edges =
-          cell->SubEntities(1);
-      const size_type num_edges = cell->RefEl().NumSubEntities(1);
-      LF_VERIFY_MSG(num_edges <= 4, "Too many edges = " << num_edges);
-      // Obtain information about current splitting pattern of
-      // the edges of the cell. Count edges that will be split.
-      size_type split_edge_cnt = 0;
-      for (int k = 0; k < num_edges; k++) {
-        const glb_idx_t edge_index = finest_mesh.Index(*sub_edges[k]);
-        cell_edge_indices[k] = edge_index;
-        edge_split[k] =
-            (finest_edge_ci[edge_index].ref_pat_ == RefPat::rp_split);
-        if (edge_split[k]) {
-          split_edge_idx[split_edge_cnt] = k;
-          split_edge_cnt++;
-        }
+  // Global indices of the edges of every cell and of the (at most two) cells
+  // adjacent to every edge. They are computed once, because cells may have to
+  // be visited repeatedly below.
+  const size_type num_cells = finest_mesh.NumEntities(0);
+  std::vector<const lf::mesh::Entity *> cell_ptrs(num_cells, nullptr);
+  std::vector<std::array<glb_idx_t, 4>> cell_edges(num_cells);
+  std::vector<std::array<glb_idx_t, 2>> edge_cells(
+      finest_mesh.NumEntities(1), std::array<glb_idx_t, 2>{idx_nil, idx_nil});
+  for (const lf::mesh::Entity *cell : finest_mesh.Entities(0)) {
+    const glb_idx_t cell_index = finest_mesh.Index(*cell);
+    cell_ptrs[cell_index] = cell;
+    nonstd::span<const lf::mesh::Entity *const> sub_edges =
+        cell->SubEntities(1);
+    const size_type num_edges = cell->RefEl().NumSubEntities(1);
+    LF_VERIFY_MSG(num_edges <= 4, "Too many edges = " << num_edges);
+    for (int k = 0; k < num_edges; k++) {
+      const glb_idx_t edge_index = finest_mesh.Index(*sub_edges[k]);
+      cell_edges[cell_index][k] = edge_index;
+      std::array<glb_idx_t, 2> &adj_cells(edge_cells[edge_index]);
+      LF_VERIFY_MSG(adj_cells[1] == idx_nil,
+                    "Edge " << edge_index << " adjacent to more than 2 cells");
+      adj_cells[(adj_cells[0] == idx_nil) ? 0 : 1] = cell_index;
+    }
+  }
+
+  // To keep the mesh conforming refinement might have to propagate: whenever
+  // the refinement edge of a triangle has to be split in addition, the
+  // refinement patterns of the cells adjacent to that edge must be updated.
+  // This is achieved by a worklist of cells, which initially contains all
+  // cells, so that only cells next to newly split edges are visited again.
+  std::queue<glb_idx_t> cell_queue;
+  std::vector<bool> cell_queued(num_cells, true);
+  for (glb_idx_t cell_index = 0; cell_index < num_cells; ++cell_index) {
+    cell_queue.push(cell_index);
+  }
+  // Flag an edge as split and schedule its adjacent cells for an update
+  auto split_edge = [&](glb_idx_t edge_index) {
+    finest_edge_ci[edge_index].ref_pat_ = RefPat::rp_split;
+    for (const glb_idx_t adj_cell : edge_cells[edge_index]) {
+      if (adj_cell != idx_nil && !cell_queued[adj_cell]) {
+        cell_queued[adj_cell] = true;
+        cell_queue.push(adj_cell);
       }
-      switch (cell->RefEl()) {
-        case lf::base::RefEl::kTria(): {
-          // Case of a triangular cell: In this case bisection refinement
-          // is performed starting with the refinement edge.
-          // Local index of refinement edge for the current triangle, also
-          // called the "anchor edge" in the case of repeated  bisection
-          const sub_idx_t anchor = refinement_edges_.back()[cell_index];
-          LF_VERIFY_MSG(anchor < 3, "Illegal anchor = " << anchor);
-
-          // Refinement edge will always be the anchor edge
-          finest_cell_ci[cell_index].anchor_ = anchor;
-          const sub_idx_t mod_0 = anchor;
-          const sub_idx_t mod_1 = (anchor + 1) % 3;
-          const sub_idx_t mod_2 = (anchor + 2) % 3;
-          // Flag tuple indicating splitting status of an edge: true <-> split
-          std::tuple<bool, bool, bool> split_status(
-              {edge_split[mod_0], edge_split[mod_1], edge_split[mod_2]});
-
-          // Determine updated refinement pattern for triangle depending on the
-          // splitting status of its edges. If the triangle is subdivided, the
-          // refinement must always be split in a first bisection step, even if
-          // it may not have been marked as split. In this case refinement may
-          // spread to neighboring cells and we have to iterative once more.
-          // Therefore the refinement_complete flag has to be set to 'false'.
-
-          if (split_status ==
-              std::tuple<bool, bool, bool>({false, false, false})) {
-            // No edge to be split: just copy triangle
-            LF_VERIFY_MSG(split_edge_cnt == 0, "Wrong number of split edges");
+    }
+  };
+  while (!cell_queue.empty()) {
+    // Obtain unique index of current cell
+    const glb_idx_t cell_index = cell_queue.front();
+    cell_queue.pop();
+    const lf::mesh::Entity *cell = cell_ptrs[cell_index];
+    // Global indices of edges
+    const std::array<glb_idx_t, 4> &cell_edge_indices(cell_edges[cell_index]);
+
+    // Find edges which are marked as split
+    std::array<bool, 4> edge_split{{false, false, false, false}};
+    // Local indices of edges marked as split
+    std::array<sub_idx_t, 4> split_edge_idx{};
+    const size_type num_edges = cell->RefEl().NumSubEntities(1);
+    // Obtain information about current splitting pattern of
+    // the edges of the cell. Count edges that will be split.
+    size_type split_edge_cnt = 0;
+    for (int k = 0; k < num_edges; k++) {
+      edge_split[k] = (finest_edge_ci[cell_edge_indices[k]].ref_pat_ ==
+                       RefPat::rp_split);
+      if (edge_split[k]) {
+        split_edge_idx[split_edge_cnt] = k;
+        split_edge_cnt++;
+      }
+    }
+    switch (cell->RefEl()) {
+      case lf::base::RefEl::kTria(): {
+        // Case of a triangular cell: In this case bisection refinement
+        // is performed starting with the refinement edge.
+        // Local index of refinement edge for the current triangle, also
+        // called the "anchor edge" in the case of repeated  bisection
+        const sub_idx_t anchor = refinement_edges_.back()[cell_index];
+        LF_VERIFY_MSG(anchor < 3, "Illegal anchor = " << anchor);
+
+        // Refinement edge will always be the anchor edge
+        finest_cell_ci[cell_index].anchor_ = anchor;
+        const sub_idx_t mod_0 = anchor;
+        const sub_idx_t mod_1 = (anchor + 1) % 3;
+        const sub_idx_t mod_2 = (anchor + 2) % 3;
+        // Flag tuple indicating splitting status of an edge: true <-> split
+        std::tuple<bool, bool, bool> split_status(
+            {edge_split[mod_0], edge_split[mod_1], edge_split[mod_2]});
+
+        // Determine updated refinement pattern for triangle depending on the
+        // splitting status of its edges. If the triangle is subdivided, the
+        // refinement must always be split in a first bisection step, even if
+        // it may not have been marked as split. In this case refinement may
+        // spread to neighboring cells, which have to be visited once more.
+
+        if (split_status ==
+            std::tuple<bool, bool, bool>({false, false, false})) {
+          // No edge to be split: just copy triangle
+          LF_VERIFY_MSG(split_edge_cnt == 0, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_copy;
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({true, false, false})) {
+          // Only refinement edge has to be split by a single bisection
+          // No additional edge will be split
+          LF_VERIFY_MSG(split_edge_cnt == 1, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_bisect;
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({true, true, false})) {
+          // Trisection refinement, no extra splitting of edges
+          LF_VERIFY_MSG(split_edge_cnt == 2, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect;
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({false, true, false})) {
+          // Trisection refinement, triggering splitting of refinement edge
+          LF_VERIFY_MSG(split_edge_cnt == 1, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect;
+          split_edge(cell_edge_indices[anchor]);
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({true, false, true})) {
+          // Trisection refinement (other side), no extra splitting of edges
+          LF_VERIFY_MSG(split_edge_cnt == 2, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect_left;
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({false, false, true})) {
+          // Trisection refinement (other side), triggering splitting of
+          // refinement edge
+          LF_VERIFY_MSG(split_edge_cnt == 1, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect_left;
+          split_edge(cell_edge_indices[anchor]);
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({true, true, true})) {
+          // Quadsection refinement, no extra splitting of edges
+          LF_VERIFY_MSG(split_edge_cnt == 3, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_quadsect;
+        } else if (split_status ==
+                   std::tuple<bool, bool, bool>({false, true, true})) {
+          // Quadsection refinement requiring splitting of refinement edge
+          LF_VERIFY_MSG(split_edge_cnt == 2, "Wrong number of split edges");
+          finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_quadsect;
+          split_edge(cell_edge_indices[anchor]);
+        } else {
+          LF_VERIFY_MSG(false, "Impossible case");
+        }
+        break;
+      }  // end case of a triangle
+      case lf::base::RefEl::kQuad(): {
+        // There is no refinement edge for quadrilaterals and so no extra edge
+        // splitting will be necessary. The refinement pattern for a
+        // quadrilateral will be determined from the number of edges split and
+        // their location to each other.
+        switch (split_edge_cnt) {
+          case 0: {
+            // No edge split: quadrilateral has to be copied
             finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_copy;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({true, false, false})) {
-            // Only refinement edge has to be split by a single bisection
-            // No additional edge will be split
-            LF_VERIFY_MSG(split_edge_cnt == 1, "Wrong number of split edges");
-            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_bisect;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({true, true, false})) {
-            // Trisection refinement, no extra splitting of edges
-            LF_VERIFY_MSG(split_edge_cnt == 2, "Wrong number of split edges");
-            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({false, true, false})) {
-            // Trisection refinement, triggering splitting of refinement edge
-            LF_VERIFY_MSG(split_edge_cnt == 1, "Wrong number of split edges");
+            break;
+          }
+          case 1: {
+            // One edge split: trisection refinement of the quadrilateral
+            // Anchor edge is the split edge
             finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect;
-            finest_edge_ci[cell_edge_indices[anchor]].ref_pat_ =
-                RefPat::rp_split;
-            refinement_complete = false;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({true, false, true})) {
-            // Trisection refinement (other side), no extra splitting of edges
-            LF_VERIFY_MSG(split_edge_cnt == 2, "Wrong number of split edges");
-            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect_left;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({false, false, true})) {
-            // Trisection refinement (other side), triggering splitting of
-            // refinement edge
-            LF_VERIFY_MSG(split_edge_cnt == 1, "Wrong number of split edges");
-            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect_left;
-            finest_edge_ci[cell_edge_indices[anchor]].ref_pat_ =
-                RefPat::rp_split;
-            refinement_complete = false;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({true, true, true})) {
-            // Quadsection refinement, no extra splitting of edges
-            LF_VERIFY_MSG(split_edge_cnt == 3, "Wrong number of split edges");
-            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_quadsect;
-          } else if (split_status ==
-                     std::tuple<bool, bool, bool>({false, true, true})) {
-            // Quadsection refinement requiring splitting of refinement edge
-            LF_VERIFY_MSG(split_edge_cnt == 2, "Wrong number of split edges");
-            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_quadsect;
-            finest_edge_ci[cell_edge_indices[anchor]].ref_pat_ =
-                RefPat::rp_split;
-            refinement_complete = false;
-          } else {
-            LF_VERIFY_MSG(false, "Impossible case");
+            finest_cell_ci[cell_index].anchor_ = split_edge_idx[0];
+            break;
           }
-          break;
-        }  // end case of a triangle
-        case lf::base::RefEl::kQuad(): {
-          // There is no refinement edge for quadrilaterals and so no extra edge
-          // splitting will be necessary. The refinement pattern for a
-          // quadrilateral will be determined from the number of edges split and
-          // their location to each other.
-          switch (split_edge_cnt) {
-            case 0: {
-              // No edge split: quadrilateral has to be copied
-              finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_copy;
-              break;
-            }
-            case 1: {
-              // One edge split: trisection refinement of the quadrilateral
-              // Anchor edge is the split edge
-              finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_trisect;
+          case 2: {
+            if ((split_edge_idx[1] - split_edge_idx[0]) == 2) {
+              // If the two split edges are opposite to each other, then
+              // bisection of the quadrilateral is the right refinement
+              // pattern.
+              finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_bisect;
               finest_cell_ci[cell_index].anchor_ = split_edge_idx[0];
-              break;
-            }
-            case 2: {
-              if ((split_edge_idx[1] - split_edge_idx[0]) == 2) {
-                // If the two split edges are opposite to each other, then
-                // bisection of the quadrilateral is the right refinement
-                // pattern.
-                finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_bisect;
+            } else {
+              // Tthe two split edges are adjacent, this case can be
+              // accommodated by quadsection refinement. Anchor is the split
+              // edge with the lower index (modulo 4).
+              finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_quadsect;
+              if (((split_edge_idx[0] + 1) % 4) == split_edge_idx[1]) {
                 finest_cell_ci[cell_index].anchor_ = split_edge_idx[0];
+              } else if (((split_edge_idx[1] + 1) % 4) == split_edge_idx[0]) {
+                finest_cell_ci[cell_index].anchor_ = split_edge_idx[1];
               } else {
-                // Tthe two split edges are adjacent, this case can be
-                // accommodated by quadsection refinement. Anchor is the split
-                // edge with the lower index (modulo 4).
-                finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_quadsect;
-                if (((split_edge_idx[0] + 1) % 4) == split_edge_idx[1]) {
-                  finest_cell_ci[cell_index].anchor_ = split_edge_idx[0];
-                } else if (((split_edge_idx[1] + 1) % 4) == split_edge_idx[0]) {
-                  finest_cell_ci[cell_index].anchor_ = split_edge_idx[1];
-                } else {
-                  LF_VERIFY_MSG(false,
-                                "Quad: impossible situation for 2 split edges");
-                }
+                LF_VERIFY_MSG(false,
+                              "Quad: impossible situation for 2 split edges");
               }
-              break;
-            }
-            case 3: {
-              // Three edges of the quadrilateral are split, which can be
-              // accommodated only by the rp_threeedge refinement pattern
-              // anchor is the edge with the middle index
-              finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_threeedge;
-              if (!edge_split[0]) {  // Split edges 1,2,3, middle edge 2
-                finest_cell_ci[cell_index].anchor_ = 2;
-              } else if (!edge_split[1]) {  // Split edges 0,2,3, middle edge 3
-                finest_cell_ci[cell_index].anchor_ = 3;
-              } else if (!edge_split[2]) {  // Split edges 0,1,3, middle edge 0
-                finest_cell_ci[cell_index].anchor_ = 0;
-              } else if (!edge_split[3]) {  // Split edges 0,1,2, middle edge 1
-                finest_cell_ci[cell_index].anchor_ = 1;
-              } else {
-                LF_VERIFY_MSG(false, "Inconsistent split pattern");
-              }
-              break;
-            }
-            case 4: {
-              // All edges are split => regular refinement
-              finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_regular;
-              break;
             }
-            default: {
-              LF_VERIFY_MSG(false, "Illegal number " << split_edge_cnt
-                                                     << " of split edges");
-              break;
+            break;
+          }
+          case 3: {
+            // Three edges of the quadrilateral are split, which can be
+            // accommodated only by the rp_threeedge refinement pattern
+            // anchor is the edge with the middle index
+            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_threeedge;
+            if (!edge_split[0]) {  // Split edges 1,2,3, middle edge 2
+              finest_cell_ci[cell_index].anchor_ = 2;
+            } else if (!edge_split[1]) {  // Split edges 0,2,3, middle edge 3
+              finest_cell_ci[cell_index].anchor_ = 3;
+            } else if (!edge_split[2]) {  // Split edges 0,1,3, middle edge 0
+              finest_cell_ci[cell_index].anchor_ = 0;
+            } else if (!edge_split[3]) {  // Split edges 0,1,2, middle edge 1
+              finest_cell_ci[cell_index].anchor_ = 1;
+            } else {
+              LF_VERIFY_MSG(false, "Inconsistent split pattern");
             }
-          }  // end switch split_edge_cnt
-          break;
-        }  // end case of a quadrilateral
-        default: {
-          LF_VERIFY_MSG(false, "Illegal cell type");
-          break;
-        }
-      }  // end switch cell type
-    }    // end loop over cells
-  } while (!refinement_complete);
+            break;
+          }
+          case 4: {
+            // All edges are split => regular refinement
+            finest_cell_ci[cell_index].ref_pat_ = RefPat::rp_regular;
+            break;
+          }
+          default: {
+            LF_VERIFY_MSG(false, "Illegal number " << split_edge_cnt
+                                                   << " of split edges");
+            break;
+          }
+        }  // end switch split_edge_cnt
+        break;
+      }  // end case of a quadrilateral
+      default: {
+        LF_VERIFY_MSG(false, "Illegal cell type");
+        break;
+      }
+    }  // end switch cell type
+    // The current cell need not be revisited because of its own anchor edge
+    cell_queued[cell_index] = false;
+  }  // end loop over cells in worklist
 
   // Create finer mesh according to set refinment edges
   PerformRefinement();
@@ -367,6 +761,13 @@ void MeshHierarchy::PerformRefinement() {
 
   // Retrieve the finest mesh in the hierarchy = parent mesh
   const mesh::Mesh &parent_mesh(*meshes_.back());
+  // In incremental mode copied entities are retained instead of being built
+  // from copies of their geometries
+  const std::shared_ptr<const mesh::Mesh> parent_mesh_ptr(meshes_.back());
+  auto *retaining_factory =
+      incremental_refinement_
+          ? dynamic_cast<mesh::hybrid2d::MeshFactory *>(mesh_factory_.get())
+          : nullptr;
 
   {
     // Partly intialized vectors of child information
@@ -385,7 +786,12 @@ void MeshHierarchy::PerformRefinement() {
                     "Node index " << node_index << " out of range");
       // Find position of node in physical coordinates
       const lf::geometry::Geometry &pt_geo(*node->Geometry());
-      if (pt_child_info[node_index].ref_pat != RefPat::rp_nil) {
+      if (pt_child_info[node_index].ref_pat != RefPat::rp_nil &&
+          retaining_factory != nullptr) {
+        pt_child_info[node_index].child_point_idx =
+            retaining_factory->RetainEntity(parent_mesh_ptr, *node);
+        new_node_cnt++;
+      } else if (pt_child_info[node_index].ref_pat != RefPat::rp_nil) {
         // Generate a node for the fine mesh at the same position
         std::vector<std::unique_ptr<geometry::Geometry>> pt_child_geo_ptrs(
             pt_geo.ChildGeometry(rp_copy_node, 0));
@@ -433,6 +839,11 @@ void MeshHierarchy::PerformRefinement() {
       // Distinguish between different local refinement patterns
       switch (edge_refpat) {
         case RefPat::rp_copy: {
+          if (retaining_factory != nullptr) {
+            edge_ci.child_edge_idx.push_back(
+                retaining_factory->RetainEntity(parent_mesh_ptr, *edge));
+            break;
+          }
           // Edge has to be duplicated
           std::vector<std::unique_ptr<lf::geometry::Geometry>> ed_copy(
               edge->Geometry()->ChildGeometry(rp, 0));
@@ -535,6 +946,12 @@ void MeshHierarchy::PerformRefinement() {
                     << ", refpat = " << static_cast<int>(cell_refpat)
                     << ", anchor = " << anchor << std::endl;)
 
+      if (cell_refpat == RefPat::rp_copy && retaining_factory != nullptr) {
+        cell_ci.child_cell_idx.push_back(
+            retaining_factory->RetainEntity(parent_mesh_ptr, *cell));
+        continue;
+      }
+
       Hybrid2DRefinementPattern rp(cell->RefEl(), cell_refpat, anchor);
 
       // Index offsets for refinement patterns requiring an ancchor edge
@@ -1258,30 +1675,7 @@ void MeshHierarchy::PerformRefinement() {
 
   // Create space for data pertaining to the new mesh
   // Note that references to vectors may become invalid
-  {
-    // Arrays containing parent information
-    parent_infos_.push_back(
-        {std::move(std::vector<ParentInfo>(child_mesh.NumEntities(0))),
-         std::move(std::vector<ParentInfo>(child_mesh.NumEntities(1))),
-         std::move(std::vector<ParentInfo>(child_mesh.NumEntities(2)))});
-
-    // Initialize (empty) refinement information for newly created fine mesh
-    // Same code as in the constructor of MeshHierarchy
-    std::vector<CellChildInfo> fine_cell_child_info(child_mesh.NumEntities(0));
-    std::vector<EdgeChildInfo> fine_edge_child_info(child_mesh.NumEntities(1));
-    std::vector<PointChildInfo> fine_point_child_info(
-        child_mesh.NumEntities(2));
-    cell_child_infos_.push_back(std::move(fine_cell_child_info));
-    edge_child_infos_.push_back(std::move(fine_edge_child_info));
-    point_child_infos_.push_back(std::move(fine_point_child_info));
-
-    // Array containing information about refinement edges
-    refinement_edges_.push_back(
-        std::move(std::vector<sub_idx_t>(child_mesh.NumEntities(0), idx_nil)));
-
-    // Finally set up vector for edge flags
-    edge_marked_.emplace_back(child_mesh.NumEntities(1), false);
-  }
+  AppendLevelData(child_mesh);
 
   // Finally, we have to initialize the parent pointers for the entities of the
   // newly created finest mesh.
@@ -1665,10 +2059,34 @@ void MeshHierarchy::PerformRefinement() {
   }
 }  // end Perform Refinement
 
+void MeshHierarchy::AppendLevelData(const mesh::Mesh &child_mesh) {
+  // Arrays containing parent information
+  parent_infos_.push_back(
+      {std::move(std::vector<ParentInfo>(child_mesh.NumEntities(0))),
+       std::move(std::vector<ParentInfo>(child_mesh.NumEntities(1))),
+       std::move(std::vector<ParentInfo>(child_mesh.NumEntities(2)))});
+
+  // Initialize (empty) refinement information for newly created fine mesh
+  // Same code as in the constructor of MeshHierarchy
+  std::vector<CellChildInfo> fine_cell_child_info(child_mesh.NumEntities(0));
+  std::vector<EdgeChildInfo> fine_edge_child_info(child_mesh.NumEntities(1));
+  std::vector<PointChildInfo> fine_point_child_info(child_mesh.NumEntities(2));
+  cell_child_infos_.push_back(std::move(fine_cell_child_info));
+  edge_child_infos_.push_back(std::move(fine_edge_child_info));
+  point_child_infos_.push_back(std::move(fine_point_child_info));
+
+  // Array containing information about refinement edges
+  refinement_edges_.push_back(
+      std::move(std::vector<sub_idx_t>(child_mesh.NumEntities(0), idx_nil)));
+
+  // Finally set up vector for edge flags
+  edge_marked_.emplace_back(child_mesh.NumEntities(1), false);
+}
+
 // **********************************************************************
 // Initialization of rel_ref_geo fields of ParentInfo structures
 // **********************************************************************
-void MeshHierarchy::initGeometryInParent() {
+void MeshHierarchy::initGeometryInParent(unsigned int num_threads) {
   // number of meshes contained in the hierarchy
   const size_type num_levels = NumLevels();
   CONTROLLEDSTATEMENT(output_ctrl_, 10,
@@ -1698,8 +2116,9 @@ void MeshHierarchy::initGeometryInParent() {
     // of the new mesh
     std::vector<ParentInfo> &child_entities_parent_info(
         parent_infos_.back()[codim]);
-    // Loop over all nodes of the new mesh (co-dimension = 2)
-    for (const lf::mesh::Entity *child_entity : child_mesh.Entities(codim)) {
+    // Initialization for a single entity of the new mesh; entities are
+    // independent of each other
+    auto init_entity = [&](const lf::mesh::Entity *child_entity) {
       // Obtain index of the child entity
       const glb_idx_t child_idx = child_mesh.Index(*child_entity);
       // Obtain ParentInfo for the current child entity
@@ -1906,8 +2325,18 @@ void MeshHierarchy::initGeometryInParent() {
           break;
         }
       }  // end switch(parent_codim)
-    }    // end loop over entities of the fine mesh
-  }      // end loop over codims
+    };
+    // Loop over all entities of the new mesh of co-dimension codim
+    const auto child_entities = child_mesh.Entities(codim);
+    lf::base::ParallelForChunks(
+        child_entities.size(),
+        NumRefinementChunks(child_entities.size(), num_threads),
+        [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+          for (std::size_t k = begin; k < end; ++k) {
+            init_entity(child_entities[k]);
+          }
+        });
+  }  // end loop over codims
 }  // end initGeometryInParent
 
 sub_idx_t MeshHierarchy::LongestEdge(const lf::mesh::Entity &T) const {
@@ -7,6 +7,7 @@
  *
  */
 
+#include <lf/base/parallel.h>
 #include <iostream>
 #include "hybrid2d_refinement_pattern.h"
 
@@ -261,6 +262,30 @@ class MeshHierarchy {
    * pattern. Then it calls PerformRefinement().
    */
   void RefineRegular(RefPat ref_pat = RefPat::rp_regular);
+  /**
+   * @brief Multi-threaded variant of RefineRegular()
+   *
+   * @param ref_pat selector for type of uniform refinement, rp_regular or
+   * rp_barycentric, see RefineRegular().
+   * @param num_threads maximal number of threads to use.
+   *
+   * For uniform refinement the number of child entities of every entity only
+   * depends on its type. Hence the indices of all new points, edges and cells
+   * are known in advance and their geometries, the child information of the
+   * coarse entities and the parent information of the fine entities can be
+   * computed concurrently for all entities. Only the final registration with
+   * the mesh factory is sequential.
+   *
+   * The resulting mesh, including its numbering, and all parent/child
+   * information are the same as those produced by RefineRegular().
+   *
+   * @note Small meshes are refined on the calling thread only.
+   * @note The debugging output controlled by `output_ctrl_` is not available
+   * for this method.
+   */
+  void RefineRegularParallel(
+      RefPat ref_pat = RefPat::rp_regular,
+      unsigned int num_threads = lf::base::DefaultNumThreads());
   /**
    * @brief Mark the edges of a mesh based on a predicate
    *
@@ -288,12 +313,11 @@ class MeshHierarchy {
    * ### Algorithm
    *
    * - First all marked edges are labelled as "to be split".
-   * - REPEAT
-   *   + Set refinement pattern of all cells to accommodate edges to be split
-   *   + Add "to be split" tag to edges according to local refinement pattern
-   * for cells
-   *
-   *   UNTIL no _extra_ edges had to be tagged as "to be split"
+   * - Put all cells into a worklist. WHILE the worklist is not empty
+   *   + Take a cell from the worklist and set its refinement pattern to
+   * accommodate its edges to be split
+   *   + If this requires to tag another edge as "to be split", add the cells
+   * adjacent to that edge to the worklist
    *
    * For details please consult the comments in mesh_hierarchy.cc
    *
@@ -302,6 +326,29 @@ class MeshHierarchy {
    * hanging nodes are avoided.
    */
   void RefineMarked();
+  /**
+   * @brief Switch incremental construction of refined meshes on or off
+   *
+   * @param incremental if true, nodes, edges and cells that are merely copied
+   * during refinement share their geometry objects with the parent entities
+   * instead of receiving copies of them (default: off).
+   *
+   * For local refinement by RefineMarked() most entities of the finest mesh
+   * are just copied. In incremental mode they are passed to
+   * lf::mesh::hybrid2d::MeshFactory::RetainEntity(), so that only the refined
+   * patch of the mesh has to be built from scratch. The new mesh, its
+   * numbering and all parent/child information are the same as without
+   * incremental construction.
+   *
+   * @note A mesh built incrementally keeps its parent mesh alive, and thus the
+   * whole hierarchy above it.
+   * @note Incremental construction requires the mesh factory to be a
+   * lf::mesh::hybrid2d::MeshFactory; for other factories this setting has no
+   * effect.
+   */
+  void SetIncrementalRefinement(bool incremental) {
+    incremental_refinement_ = incremental;
+  }
   /**
    * @brief _Destroy_ the mesh on the finest level unless it is the base mesh
    *
@@ -413,8 +460,11 @@ class MeshHierarchy {
    * @note This method assumes that the parent-child connections of the mesh
    * hierarchy have been initialized completely already. Therefore this method
    * is invoked at the end of @ref PerformRefinement().
+   *
+   * @param num_threads number of threads among which the entities of the
+   * finest mesh are distributed.
    */
-  void initGeometryInParent();
+  void initGeometryInParent(unsigned int num_threads = 1);
 
  private:
   /** @brief the meshes managed by the MeshHierarchy object */
@@ -433,6 +483,18 @@ class MeshHierarchy {
   std::vector<std::vector<bool>> edge_marked_;
   /** @brief Information about local refinement edges of triangles */
   std::vector<std::vector<sub_idx_t>> refinement_edges_;
+  /** @brief Share geometry of copied entities, see SetIncrementalRefinement()
+   */
+  bool incremental_refinement_{false};
+
+  /**
+   * @brief Allocates empty parent/child information, refinement edges and edge
+   * flags for a mesh that has just been appended to the hierarchy
+   *
+   * Called by PerformRefinement() and RefineRegularParallel() right after the
+   * construction of the new finest mesh.
+   */
+  void AppendLevelData(const mesh::Mesh &child_mesh);
 
   /**
    * @brief Finds the index of the longest edge of a triangle
@@ -0,0 +1,160 @@
+/**
+ * @file
+ * @brief Tests for Dörfler marking, residual error indicators and the
+ *        adaptive refinement driver
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+#include <lf/mesh/hybrid2d/hybrid2d.h>
+#include <lf/refinement/adaptive_refinement.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace lf::refinement::test {
+
+// Triangular tensor product mesh of the unit square
+static std::shared_ptr<mesh::Mesh> unitSquareTriagMesh(size_type n) {
+  mesh::hybrid2d::TPTriagMeshBuilder builder(
+      std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(n)
+      .setNumYCells(n);
+  return builder.Build();
+}
+
+// Minimal number of cells needed to satisfy the bulk criterion, obtained by
+// sorting the indicators
+static std::size_t minimalDoerflerSetSize(std::vector<double> eta_squared,
+                                          double theta) {
+  const double needed =
+      theta * std::accumulate(eta_squared.begin(), eta_squared.end(), 0.0);
+  std::sort(eta_squared.begin(), eta_squared.end(), std::greater<>());
+  double taken = 0.0;
+  std::size_t k = 0;
+  while (taken < needed && k < eta_squared.size()) {
+    taken += eta_squared[k++];
+  }
+  return k;
+}
+
+TEST(lf_refinement, DoerflerMarking) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  for (const std::size_t n : {1, 2, 7, 100, 1001}) {
+    std::vector<double> eta_squared(n);
+    for (double &eta_sq : eta_squared) {
+      eta_sq = std::pow(dist(gen), 4);
+    }
+    const double total =
+        std::accumulate(eta_squared.begin(), eta_squared.end(), 0.0);
+    for (const double theta : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+      const std::vector<glb_idx_t> marked =
+          DoerflerMarking(eta_squared, theta);
+      EXPECT_EQ(marked.size(), minimalDoerflerSetSize(eta_squared, theta))
+          << "n = " << n << ", theta = " << theta;
+      // The selected cells are distinct and satisfy the bulk criterion
+      std::vector<bool> selected(n, false);
+      double sum = 0.0;
+      for (const glb_idx_t idx : marked) {
+        ASSERT_LT(idx, n);
+        EXPECT_FALSE(selected[idx]);
+        selected[idx] = true;
+        sum += eta_squared[idx];
+      }
+      EXPECT_GE(sum, theta * total - 1.0E-12 * total);
+      // No unselected cell has a larger indicator than a selected one
+      double smallest_selected = std::numeric_limits<double>::infinity();
+      double largest_unselected = 0.0;
+      for (std::size_t k = 0; k < n; ++k) {
+        if (selected[k]) {
+          smallest_selected = std::min(smallest_selected, eta_squared[k]);
+        } else {
+          largest_unselected = std::max(largest_unselected, eta_squared[k]);
+        }
+      }
+      if (!marked.empty()) {
+        EXPECT_GE(smallest_selected, largest_unselected);
+      }
+    }
+  }
+  EXPECT_TRUE(DoerflerMarking(std::vector<double>(5, 0.0), 0.5).empty());
+}
+
+TEST(lf_refinement, ResidualIndicatorsLinear) {
+  // A linear function is contained in the finite element space and solves
+  // -Laplace u = 0
+  auto mesh_p = unitSquareTriagMesh(4);
+  auto fe_space =
+      std::make_shared<uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+  const Eigen::VectorXd mu = uscalfe::NodalProjection(
+      *fe_space, mesh::utils::MeshFunctionGlobal(
+                     [](const Eigen::Vector2d &x) { return 2 * x[0] - x[1]; }));
+  const mesh::utils::MeshFunctionConstant<double> one(1.0);
+  const mesh::utils::MeshFunctionConstant<double> zero(0.0);
+  const std::vector<double> eta_squared =
+      ResidualErrorIndicators(fe_space, mu, one, zero, zero);
+  ASSERT_EQ(eta_squared.size(), mesh_p->NumEntities(0));
+  for (const double eta_sq : eta_squared) {
+    EXPECT_NEAR(eta_sq, 0.0, 1.0E-20);
+  }
+}
+
+TEST(lf_refinement, ResidualIndicatorsParallel) {
+  auto fe_space = std::make_shared<uscalfe::FeSpaceLagrangeO1<double>>(
+      unitSquareTriagMesh(50));
+  const Eigen::VectorXd mu = uscalfe::NodalProjection(
+      *fe_space,
+      mesh::utils::MeshFunctionGlobal([](const Eigen::Vector2d &x) {
+        return std::exp(-20.0 * x.squaredNorm());
+      }));
+  const mesh::utils::MeshFunctionConstant<double> alpha(3.0);
+  const mesh::utils::MeshFunctionConstant<double> gamma(2.0);
+  const mesh::utils::MeshFunctionConstant<double> f(1.0);
+  const std::vector<double> eta_seq =
+      ResidualErrorIndicators(fe_space, mu, alpha, gamma, f, 1);
+  const std::vector<double> eta_par =
+      ResidualErrorIndicators(fe_space, mu, alpha, gamma, f, 4);
+  EXPECT_EQ(eta_seq, eta_par);
+  EXPECT_GT(*std::max_element(eta_seq.begin(), eta_seq.end()), 0.0);
+}
+
+TEST(lf_refinement, AdaptiveRefinementDriver) {
+  auto mh = std::make_shared<MeshHierarchy>(
+      unitSquareTriagMesh(4),
+      std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  AdaptiveRefinementDriver driver(mh, 0.5);
+  const mesh::utils::MeshFunctionGlobal peak([](const Eigen::Vector2d &x) {
+    return std::exp(-10.0 * (x - Eigen::Vector2d(1.0, 1.0)).squaredNorm());
+  });
+  const mesh::utils::MeshFunctionConstant<double> one(1.0);
+  const mesh::utils::MeshFunctionConstant<double> zero(0.0);
+
+  for (int step = 0; step < 3; ++step) {
+    const size_type level = mh->NumLevels() - 1;
+    auto mesh_p = mh->getMesh(level);
+    auto fe_space =
+        std::make_shared<uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+    const Eigen::VectorXd mu = uscalfe::NodalProjection(*fe_space, peak);
+    const double estimate = driver.Estimate(fe_space, mu, one, zero, zero);
+    EXPECT_GT(estimate, 0.0);
+    ASSERT_EQ(driver.ErrorIndicators().size(), mesh_p->NumEntities(0));
+
+    const std::vector<glb_idx_t> &marked = driver.MarkAndRefine();
+    ASSERT_FALSE(marked.empty());
+    ASSERT_EQ(mh->NumLevels(), level + 2);
+    EXPECT_GT(mh->getMesh(level + 1)->NumEntities(0), mesh_p->NumEntities(0));
+    const std::vector<CellChildInfo> &cell_ci{mh->CellChildInfos(level)};
+    for (const glb_idx_t idx : marked) {
+      EXPECT_NE(cell_ci[idx].ref_pat_, RefPat::rp_copy);
+    }
+  }
+  EXPECT_EQ(driver.Timings().steps, 3);
+  EXPECT_GT(driver.Timings().estimate, 0.0);
+  driver.ResetTimings();
+  EXPECT_EQ(driver.Timings().steps, 0);
+}
+
+}  // namespace lf::refinement::test
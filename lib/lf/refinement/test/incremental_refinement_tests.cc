@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @brief Check that local refinement with incremental construction of the
+ *        refined meshes yields the same mesh hierarchy as without.
+ * @copyright MIT License
+ */
+
+#include <lf/mesh/test_utils/check_entity_indexing.h>
+#include <lf/mesh/test_utils/check_mesh_completeness.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include "refinement_test_utils.h"
+
+namespace lf::refinement::test {
+
+// Refine a mesh three times towards one of its nodes, with and without
+// incremental construction of the refined meshes
+static void checkIncrementalRefinement(
+    const std::shared_ptr<mesh::Mesh> &base_mesh) {
+  MeshHierarchy mh(base_mesh, std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  MeshHierarchy mh_inc(base_mesh,
+                       std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  mh_inc.SetIncrementalRefinement(true);
+
+  // Mark the edges adjacent to node 0 of the base mesh
+  const Eigen::Vector2d corner{
+      base_mesh->EntityByIndex(2, 0)->Geometry()->Global(
+          Eigen::Matrix<double, 0, 1>())};
+  auto marker = [&corner](const mesh::Mesh & /*mesh*/,
+                          const mesh::Entity &edge) {
+    const Eigen::MatrixXd ends{
+        edge.Geometry()->Global(edge.RefEl().NodeCoords())};
+    return (ends.col(0) - corner).norm() < 1.0E-10 ||
+           (ends.col(1) - corner).norm() < 1.0E-10;
+  };
+  for (int step = 0; step < 3; ++step) {
+    mh.MarkEdges(marker);
+    mh.RefineMarked();
+    mh_inc.MarkEdges(marker);
+    mh_inc.RefineMarked();
+  }
+  checkSameHierarchy(mh, mh_inc);
+
+  size_type no_copied_cells = 0;
+  for (size_type level = 0; level + 1 < mh_inc.NumLevels(); ++level) {
+    checkFatherChildRelations(mh_inc, level);
+    checkGeometryInParent(mh_inc, level);
+    const mesh::Mesh &child_mesh{*mh_inc.getMesh(level + 1)};
+    mesh::test_utils::checkEntityIndexing(child_mesh);
+    mesh::test_utils::checkMeshCompleteness(child_mesh);
+
+    // Copied cells share the geometry of their parents only in incremental
+    // mode
+    const std::vector<CellChildInfo> &cell_ci{mh_inc.CellChildInfos(level)};
+    for (const mesh::Entity *cell : mh_inc.getMesh(level)->Entities(0)) {
+      const CellChildInfo &ci{cell_ci[mh_inc.getMesh(level)->Index(*cell)]};
+      if (ci.ref_pat_ == RefPat::rp_copy) {
+        ASSERT_EQ(ci.child_cell_idx.size(), 1);
+        EXPECT_EQ(child_mesh.EntityByIndex(0, ci.child_cell_idx[0])->Geometry(),
+                  cell->Geometry());
+        EXPECT_NE(mh.getMesh(level + 1)
+                      ->EntityByIndex(0, ci.child_cell_idx[0])
+                      ->Geometry(),
+                  mh.getMesh(level)
+                      ->EntityByIndex(0, mh_inc.getMesh(level)->Index(*cell))
+                      ->Geometry());
+        no_copied_cells++;
+      }
+    }
+  }
+  EXPECT_GT(no_copied_cells, 0);
+}
+
+TEST(lf_refinement, IncrementalLocalRefinement) {
+  for (size_type selector = 0;
+       selector <= mesh::test_utils::GenerateHybrid2DTestMesh_maxsel;
+       ++selector) {
+    checkIncrementalRefinement(
+        mesh::test_utils::GenerateHybrid2DTestMesh(selector));
+  }
+}
+
+}  // namespace lf::refinement::test
@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @brief Check that multi-threaded uniform refinement yields the same mesh
+ *        hierarchy as sequential uniform refinement.
+ * @copyright MIT License
+ */
+
+#include <lf/mesh/test_utils/test_meshes.h>
+#include "refinement_test_utils.h"
+
+namespace lf::refinement::test {
+
+// Refine a mesh twice, sequentially and with several threads
+static void checkParallelRefinement(
+    const std::shared_ptr<mesh::Mesh> &base_mesh, RefPat ref_pat) {
+  MeshHierarchy mh_seq(base_mesh,
+                       std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  MeshHierarchy mh_par(base_mesh,
+                       std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  for (int step = 0; step < 2; ++step) {
+    mh_seq.RefineRegular(ref_pat);
+    mh_par.RefineRegularParallel(ref_pat, 4);
+  }
+  checkSameHierarchy(mh_seq, mh_par);
+  checkFatherChildRelations(mh_par, 0);
+  checkGeometryInParent(mh_par, 1);
+}
+
+TEST(lf_refinement, ParallelRegularRefinementHybrid) {
+  for (size_type selector = 0;
+       selector <= mesh::test_utils::GenerateHybrid2DTestMesh_maxsel;
+       ++selector) {
+    auto base_mesh = mesh::test_utils::GenerateHybrid2DTestMesh(selector);
+    checkParallelRefinement(base_mesh, RefPat::rp_regular);
+    checkParallelRefinement(base_mesh, RefPat::rp_barycentric);
+  }
+}
+
+TEST(lf_refinement, ParallelRegularRefinementLarge) {
+  // Meshes large enough to be distributed onto several threads
+  mesh::hybrid2d::TPTriagMeshBuilder tria_builder(
+      std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  tria_builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(40)
+      .setNumYCells(40);
+  const std::shared_ptr<mesh::Mesh> tria_mesh = tria_builder.Build();
+  checkParallelRefinement(tria_mesh, RefPat::rp_regular);
+  checkParallelRefinement(tria_mesh, RefPat::rp_barycentric);
+
+  mesh::hybrid2d::TPQuadMeshBuilder quad_builder(
+      std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  quad_builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(50)
+      .setNumYCells(50);
+  checkParallelRefinement(quad_builder.Build(), RefPat::rp_regular);
+}
+
+}  // namespace lf::refinement::test
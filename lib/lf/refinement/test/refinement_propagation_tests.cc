@@ -0,0 +1,108 @@
+/**
+ * @file
+ * @brief Check that the propagation of refinement in
+ *        MeshHierarchy::RefineMarked() splits the same edges as repeated
+ *        sweeps over all cells of the mesh.
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+#include <lf/mesh/hybrid2d/hybrid2d.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <algorithm>
+#include <random>
+#include "refinement_test_utils.h"
+
+namespace lf::refinement::test {
+
+// Closure of a set of split edges: the refinement edge of every triangle with
+// a split edge has to be split, too. The cells are swept in the order of
+// their indices until no further edge is split.
+static std::vector<bool> sweepSplitEdges(
+    const mesh::Mesh &mesh, const std::vector<sub_idx_t> &refinement_edges,
+    std::vector<bool> split) {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const mesh::Entity *cell : mesh.Entities(0)) {
+      if (cell->RefEl() != base::RefEl::kTria()) {
+        continue;
+      }
+      const auto edges = cell->SubEntities(1);
+      const glb_idx_t anchor =
+          mesh.Index(*edges[refinement_edges[mesh.Index(*cell)]]);
+      if (split[anchor]) {
+        continue;
+      }
+      if (std::any_of(edges.begin(), edges.end(), [&](const mesh::Entity *e) {
+            return split[mesh.Index(*e)];
+          })) {
+        split[anchor] = true;
+        changed = true;
+      }
+    }
+  }
+  return split;
+}
+
+// Refine the finest mesh of a hierarchy with randomly marked edges and
+// compare the split edges with those obtained by sweeps. Returns the number
+// of edges that are split without being marked.
+static size_type checkRandomMarkedRefinement(MeshHierarchy &mh,
+                                             std::mt19937 &gen,
+                                             double probability) {
+  const size_type level = mh.NumLevels() - 1;
+  const mesh::Mesh &mesh{*mh.getMesh(level)};
+  std::bernoulli_distribution coin(probability);
+  std::vector<bool> marked(mesh.NumEntities(1));
+  for (size_type i = 0; i < marked.size(); ++i) {
+    marked[i] = coin(gen);
+  }
+  mh.MarkEdges([&marked](const mesh::Mesh &m, const mesh::Entity &edge) {
+    return static_cast<bool>(marked[m.Index(edge)]);
+  });
+  const std::vector<bool> expected =
+      sweepSplitEdges(mesh, mh.RefinementEdges(level), marked);
+  mh.RefineMarked();
+
+  const std::vector<EdgeChildInfo> &edge_ci{mh.EdgeChildInfos(level)};
+  size_type no_propagated = 0;
+  for (size_type i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(edge_ci[i].ref_pat_ == RefPat::rp_split, expected[i])
+        << "edge " << i << " on level " << level;
+    no_propagated += static_cast<size_type>(expected[i] && !marked[i]);
+  }
+  checkFatherChildRelations(mh, level);
+  return no_propagated;
+}
+
+TEST(lf_refinement, PropagationLikeSweeps) {
+  std::mt19937 gen(17);
+  size_type no_propagated = 0;
+  for (size_type selector = 0;
+       selector <= mesh::test_utils::GenerateHybrid2DTestMesh_maxsel;
+       ++selector) {
+    MeshHierarchy mh(mesh::test_utils::GenerateHybrid2DTestMesh(selector),
+                     std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+    for (int step = 0; step < 5; ++step) {
+      no_propagated += checkRandomMarkedRefinement(mh, gen, 0.2);
+    }
+  }
+
+  // Few marked edges on a finer triangular mesh lead to longer chains of
+  // refinement edges that have to be split
+  mesh::hybrid2d::TPTriagMeshBuilder builder(
+      std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  builder.setBottomLeftCorner(Eigen::Vector2d{0.0, 0.0})
+      .setTopRightCorner(Eigen::Vector2d{1.0, 1.0})
+      .setNumXCells(8)
+      .setNumYCells(8);
+  MeshHierarchy mh(builder.Build(),
+                   std::make_unique<mesh::hybrid2d::MeshFactory>(2));
+  for (int step = 0; step < 6; ++step) {
+    no_propagated += checkRandomMarkedRefinement(mh, gen, 0.02);
+  }
+  EXPECT_GT(no_propagated, 0U);
+}
+
+}  // namespace lf::refinement::test
@@ -289,4 +289,58 @@ void checkFatherChildRelations(const MeshHierarchy &mh,
   }    // end loop over codimensions
 }
 
+// Corner coordinates of an entity
+static Eigen::MatrixXd Corners(const mesh::Entity &e) {
+  return e.Geometry()->Global(e.RefEl().NodeCoords());
+}
+
+void checkSameHierarchy(const MeshHierarchy &mh1, const MeshHierarchy &mh2) {
+  ASSERT_EQ(mh1.NumLevels(), mh2.NumLevels());
+  for (base::size_type level = 0; level < mh1.NumLevels(); ++level) {
+    const mesh::Mesh &mesh1{*mh1.getMesh(level)};
+    const mesh::Mesh &mesh2{*mh2.getMesh(level)};
+    for (base::dim_t codim = 0; codim <= 2; ++codim) {
+      ASSERT_EQ(mesh1.NumEntities(codim), mesh2.NumEntities(codim))
+          << "level " << level << ", codim " << codim;
+      const std::vector<ParentInfo> &pi1{mh1.ParentInfos(level, codim)};
+      const std::vector<ParentInfo> &pi2{mh2.ParentInfos(level, codim)};
+      for (base::size_type k = 0; k < mesh1.NumEntities(codim); ++k) {
+        const mesh::Entity &e1{*mesh1.Entities(codim)[k]};
+        const mesh::Entity &e2{*mesh2.Entities(codim)[k]};
+        const base::glb_idx_t idx = mesh1.Index(e1);
+        ASSERT_EQ(idx, mesh2.Index(e2));
+        ASSERT_EQ(e1.RefEl(), e2.RefEl());
+        EXPECT_TRUE(Corners(e1).isApprox(Corners(e2)));
+        if (codim < 2) {
+          for (base::size_type l = 0; l < e1.RefEl().NumNodes(); ++l) {
+            EXPECT_EQ(mesh1.Index(*e1.SubEntities(2 - codim)[l]),
+                      mesh2.Index(*e2.SubEntities(2 - codim)[l]));
+          }
+        }
+        if (level > 0) {
+          EXPECT_EQ(pi1[idx].parent_index, pi2[idx].parent_index);
+          EXPECT_EQ(pi1[idx].child_number, pi2[idx].child_number);
+          ASSERT_NE(pi2[idx].parent_ptr, nullptr);
+          EXPECT_EQ(pi1[idx].parent_ptr->Codim(), pi2[idx].parent_ptr->Codim());
+          const geometry::Geometry *geo1{mh1.GeometryInParent(level, e1)};
+          const geometry::Geometry *geo2{mh2.GeometryInParent(level, e2)};
+          ASSERT_NE(geo2, nullptr);
+          EXPECT_TRUE(geo1->Global(e1.RefEl().NodeCoords())
+                          .isApprox(geo2->Global(e2.RefEl().NodeCoords())));
+        }
+      }
+    }
+    EXPECT_EQ(mh1.RefinementEdges(level), mh2.RefinementEdges(level));
+    if (level + 1 < mh1.NumLevels()) {
+      const std::vector<CellChildInfo> &ci1{mh1.CellChildInfos(level)};
+      const std::vector<CellChildInfo> &ci2{mh2.CellChildInfos(level)};
+      for (base::size_type k = 0; k < ci1.size(); ++k) {
+        EXPECT_EQ(ci1[k].child_cell_idx, ci2[k].child_cell_idx);
+        EXPECT_EQ(ci1[k].child_edge_idx, ci2[k].child_edge_idx);
+        EXPECT_EQ(ci1[k].child_point_idx, ci2[k].child_point_idx);
+      }
+    }
+  }
+}
+
 }  // namespace lf::refinement::test
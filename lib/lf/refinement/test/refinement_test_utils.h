@@ -24,6 +24,9 @@ void checkFatherChildRelations(const MeshHierarchy &mh,
 void checkGeometryInParent(const MeshHierarchy &mh,
                            base::size_type father_level);
 
+// Compare all levels of two mesh hierarchies entity by entity
+void checkSameHierarchy(const MeshHierarchy &mh1, const MeshHierarchy &mh2);
+
 }  // namespace lf::refinement::test
 
 #endif
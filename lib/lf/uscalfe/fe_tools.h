@@ -18,6 +18,7 @@
 #include <lf/assemble/assemble.h>
 #include <lf/mesh/utils/utils.h>
 #include <lf/quad/quad.h>
+#include "quad_point_geometry_cache.h"
 #include "uniform_scalar_fe_space.h"
 
 namespace lf::uscalfe {
@@ -33,12 +34,15 @@ namespace internal {
 // is resolved.
 template <class MF, class QR_SELECTOR>
 auto LocalIntegral(const mesh::Entity &e, const QR_SELECTOR &qr_selector,
-                   const MF &mf) -> mesh::utils::MeshFunctionReturnType<MF> {
+                   const MF &mf,
+                   const QuadPointGeometryCache *geo_cache = nullptr)
+    -> mesh::utils::MeshFunctionReturnType<MF> {
   using MfType = mesh::utils::MeshFunctionReturnType<MF>;
-  auto qr = qr_selector(e);
+  const auto &qr = qr_selector(e);
   auto values = mf(e, qr.Points());
   auto weights_ie =
-      (qr.Weights().cwiseProduct(e.Geometry()->IntegrationElement(qr.Points())))
+      (qr.Weights().cwiseProduct(
+           CellQuadPointGeometry(geo_cache, e, qr).IntegrationElement()))
           .eval();
   LF_ASSERT_MSG(values.size() == qr.NumPoints(),
                 "mf returns vector with wrong size.");
@@ -69,6 +73,25 @@ auto LocalIntegral(const mesh::Entity &e, const QR_SELECTOR &qr_selector,
   }
   return temp;
 }
+
+// Zero of the type of the values of mf. The value of mf at the first point
+// determines the size of dynamic Eigen matrices.
+template <class MF>
+auto ZeroValue(const mesh::Entity &e, const Eigen::MatrixXd &local,
+               const MF &mf) -> mesh::utils::MeshFunctionReturnType<MF> {
+  using MfType = mesh::utils::MeshFunctionReturnType<MF>;
+  if constexpr (base::is_eigen_matrix<MfType> ||  // NOLINT
+                base::is_eigen_array<MfType>) {
+    if constexpr (MfType::SizeAtCompileTime != Eigen::Dynamic) {  // NOLINT
+      return MfType::Zero();
+    } else {  // NOLINT
+      const MfType value = mf(e, local.leftCols(1))[0];
+      return MfType::Zero(value.rows(), value.cols());
+    }
+  } else {  // NOLINT
+    return MfType(0);
+  }
+}
 };  // namespace internal
 
 /**
@@ -111,15 +134,16 @@ auto IntegrateMeshFunction(const lf::mesh::Mesh &mesh, const MF &mf,
                            int codim = 0)
     -> mesh::utils::MeshFunctionReturnType<MF> {
   static_assert(mesh::utils::isMeshFunction<MF>);
-  using MfType = mesh::utils::MeshFunctionReturnType<MF>;
 
   auto entities = mesh.Entities(codim);
-  auto result = internal::LocalIntegral(**entities.begin(), qr_selector, mf);
-  for (auto i = entities.begin() + 1; i != entities.end(); ++i) {
-    if (!ep(**i)) {
+  LF_VERIFY_MSG(!entities.empty(), "No entities of codim " << codim);
+  const mesh::Entity &first{**entities.begin()};
+  auto result = internal::ZeroValue(first, qr_selector(first).Points(), mf);
+  for (const mesh::Entity *e : entities) {
+    if (!ep(*e)) {
       continue;
     }
-    result = result + internal::LocalIntegral(**i, qr_selector, mf);
+    result = result + internal::LocalIntegral(*e, qr_selector, mf);
   }
   return result;
 }
@@ -165,6 +189,50 @@ auto IntegrateMeshFunction(const lf::mesh::Mesh &mesh, const MF &mf,
       codim);
 }
 
+/**
+ * @brief Integrate a \ref mesh_function over the cells of a mesh using the
+ * quadrature rules and the geometric quantities of a QuadPointGeometryCache
+ * @tparam MF The type of the \ref mesh_function "mesh function".
+ * @tparam ENTITY_PREDICATE The type of the entity predicate
+ * @param geo_cache provides the mesh, the quadrature rules for all cell types
+ * and the integration elements at the quadrature points
+ * @param mf The mesh function to integrate
+ * @param ep Selects the cells over which `mf` is integrated (default: all
+ * cells)
+ * @return The integrated value
+ *
+ * Equivalent to IntegrateMeshFunction() with a quadrature rule selector that
+ * returns `geo_cache.QuadRule(e.RefEl())`, but the integration elements are
+ * not computed again.
+ */
+template <class MF, class ENTITY_PREDICATE = base::PredicateTrue>
+auto IntegrateMeshFunction(const QuadPointGeometryCache &geo_cache,
+                           const MF &mf,
+                           const ENTITY_PREDICATE &ep = base::PredicateTrue{})
+    -> mesh::utils::MeshFunctionReturnType<MF> {
+  static_assert(mesh::utils::isMeshFunction<MF>);
+  auto qr_selector = [&geo_cache](const mesh::Entity &e)
+      -> const quad::QuadRule & {
+    const quad::QuadRule &qr{geo_cache.QuadRule(e.RefEl())};
+    LF_VERIFY_MSG(qr.NumPoints() > 0, "The cache does not cover cells of type "
+                                          << e.RefEl());
+    return qr;
+  };
+
+  auto entities = geo_cache.Mesh()->Entities(0);
+  LF_VERIFY_MSG(!entities.empty(), "Mesh without cells");
+  const mesh::Entity &first{**entities.begin()};
+  auto result = internal::ZeroValue(first, qr_selector(first).Points(), mf);
+  for (const mesh::Entity *cell : entities) {
+    if (!ep(*cell)) {
+      continue;
+    }
+    result =
+        result + internal::LocalIntegral(*cell, qr_selector, mf, &geo_cache);
+  }
+  return result;
+}
+
 // ******************************************************************************
 
 // Output control for nodal projection
@@ -20,6 +20,8 @@
 #include <lf/quad/quad.h>
 #include <iostream>
 #include "precomputed_scalar_reference_finite_element.h"
+#include "quad_point_geometry_cache.h"
+#include "tensor_product_quad_kernel.h"
 #include "uscalfe.h"
 
 namespace lf::uscalfe {
@@ -162,6 +164,18 @@ class ReactionDiffusionElementMatrixProvider {
    */
   ElemMat Eval(const lf::mesh::Entity &cell);
 
+  /**
+   * @brief Take integration elements and inverse Gramians from a cache
+   *
+   * @param geo_cache cache for the mesh of the cells passed to Eval(). It is
+   *        used for all cells whose quadrature rule it covers, see
+   *        QuadPointGeometryCache::Covers(). `nullptr` switches caching off.
+   */
+  void SetGeometryCache(
+      std::shared_ptr<const QuadPointGeometryCache> geo_cache) {
+    geo_cache_ = std::move(geo_cache);
+  }
+
   /** Virtual destructor */
   virtual ~ReactionDiffusionElementMatrixProvider() = default;
 
@@ -176,6 +190,45 @@ class ReactionDiffusionElementMatrixProvider {
 
   // fe_precomp_[i] contains precomputed reference finite element for ref_el i.
   std::array<PrecomputedScalarReferenceFiniteElement<SCALAR>, 5> fe_precomp_;
+  // optional precomputed geometric quantities, see SetGeometryCache()
+  std::shared_ptr<const QuadPointGeometryCache> geo_cache_;
+  // sum factorization for quadrilaterals, if the finite element and the
+  // quadrature rule have tensor-product structure
+  std::optional<TensorProductQuadKernel<SCALAR>> quad_kernel_;
+
+  /**
+   * @brief Element matrix on a quadrilateral in 2D world through
+   * TensorProductQuadKernel
+   *
+   * The coefficients, quadrature weights and geometric factors are merged
+   * into one 2x2 matrix and one number per quadrature point, see
+   * TensorProductQuadKernel::ElementMatrix().
+   */
+  template <typename ALPHAVEC, typename GAMMAVEC>
+  ElemMat EvalTensorProduct(
+      const PrecomputedScalarReferenceFiniteElement<SCALAR> &pfe,
+      const Eigen::Ref<const Eigen::VectorXd> &determinants,
+      const Eigen::Ref<const Eigen::MatrixXd> &JinvT, const ALPHAVEC &alphaval,
+      const GAMMAVEC &gammaval) const;
+
+  /**
+   * @brief Quadrature loop for a fixed number `NSF` of local shape functions
+   * on a cell in 2D world.
+   *
+   * All quantities living at a single quadrature point are fixed-size Eigen
+   * objects on the stack. This avoids the dynamic temporaries of the generic
+   * loop in Eval(), which would be allocated for every quadrature point.
+   *
+   * @note The loop itself does not allocate, but the fixed-size element matrix
+   * is converted into the dynamic ElemMat returned by Eval(). This costs one
+   * heap allocation per call.
+   */
+  template <int NSF, typename ALPHAVEC, typename GAMMAVEC>
+  static ElemMat EvalFixedSize(
+      const PrecomputedScalarReferenceFiniteElement<SCALAR> &pfe,
+      const Eigen::Ref<const Eigen::VectorXd> &determinants,
+      const Eigen::Ref<const Eigen::MatrixXd> &JinvT, const ALPHAVEC &alphaval,
+      const GAMMAVEC &gammaval);
 
  public:
   /** @brief output control variable */
@@ -222,6 +275,11 @@ ReactionDiffusionElementMatrixProvider<SCALAR, DIFF_COEFF, REACTION_COEFF>::
           fe, quad::make_QuadRule(ref_el, 2 * fe->Degree()));
     }
   }
+  const auto &pfe_quad{fe_precomp_[base::RefEl::kQuad().Id()]};
+  if (pfe_quad.isInitialized()) {
+    quad_kernel_ =
+        TensorProductQuadKernel<SCALAR>::Make(pfe_quad, pfe_quad.Qr());
+  }
 }
 
 // Second constructor (quadrature rules passed as arguments)
@@ -253,6 +311,11 @@ ReactionDiffusionElementMatrixProvider<SCALAR, DIFF_COEFF, REACTION_COEFF>::
       }
     }
   }
+  const auto &pfe_quad{fe_precomp_[base::RefEl::kQuad().Id()]};
+  if (pfe_quad.isInitialized()) {
+    quad_kernel_ =
+        TensorProductQuadKernel<SCALAR>::Make(pfe_quad, pfe_quad.Qr());
+  }
 }
 
 // Main method for the computation of the element matrix
@@ -289,24 +352,58 @@ ReactionDiffusionElementMatrixProvider<
                               << std::endl);
   // Physical dimension of the cell
   const dim_t world_dim = geo_ptr->DimGlobal();
+  // Geometric quantities at quadrature points, possibly precomputed
+  CellQuadPointGeometry cell_geo(geo_cache_.get(), cell, pfe.Qr());
   // Gram determinant at quadrature points
-  const Eigen::VectorXd determinants(
-      geo_ptr->IntegrationElement(pfe.Qr().Points()));
+  const Eigen::Map<const Eigen::VectorXd> determinants{
+      cell_geo.IntegrationElement()};
   LF_ASSERT_MSG(
       determinants.size() == pfe.Qr().NumPoints(),
       "Mismatch " << determinants.size() << " <-> " << pfe.Qr().NumPoints());
   // Fetch the transformation matrices for the gradients
-  const Eigen::MatrixXd JinvT(
-      geo_ptr->JacobianInverseGramian(pfe.Qr().Points()));
+  const Eigen::Map<const Eigen::MatrixXd> JinvT{
+      cell_geo.JacobianInverseGramian()};
   LF_ASSERT_MSG(
       JinvT.cols() == 2 * pfe.Qr().NumPoints(),
       "Mismatch " << JinvT.cols() << " <-> " << 2 * pfe.Qr().NumPoints());
   LF_ASSERT_MSG(JinvT.rows() == world_dim,
                 "Mismatch " << JinvT.rows() << " <-> " << world_dim);
 
-  // compute values of coefficients alpha, gamma at quadrature points:
-  auto alphaval = alpha_(cell, pfe.Qr().Points());
-  auto gammaval = gamma_(cell, pfe.Qr().Points());
+  // compute values of coefficients alpha, gamma at quadrature points. They are
+  // stored in thread-local buffers, which are reused for all cells.
+  auto alphaval = lf::mesh::utils::ThreadLocalBuffer<
+      lf::mesh::utils::MeshFunctionReturnType<DIFF_COEFF>,
+      ReactionDiffusionElementMatrixProvider, 0>(pfe.Qr().NumPoints());
+  auto gammaval = lf::mesh::utils::ThreadLocalBuffer<
+      lf::mesh::utils::MeshFunctionReturnType<REACTION_COEFF>,
+      ReactionDiffusionElementMatrixProvider, 1>(pfe.Qr().NumPoints());
+  lf::mesh::utils::EvaluateMeshFunction(alpha_, cell, pfe.Qr().Points(),
+                                        alphaval);
+  lf::mesh::utils::EvaluateMeshFunction(gamma_, cell, pfe.Qr().Points(),
+                                        gammaval);
+
+  // Fixed-size computations for linear and quadratic Lagrangian finite
+  // elements on flat cells
+  if (world_dim == 2) {
+    switch (pfe.NumRefShapeFunctions()) {
+      case 3:  // linear triangle
+        return EvalFixedSize<3>(pfe, determinants, JinvT, alphaval, gammaval);
+      case 4:  // bilinear quadrilateral
+        return EvalFixedSize<4>(pfe, determinants, JinvT, alphaval, gammaval);
+      case 6:  // quadratic triangle
+        return EvalFixedSize<6>(pfe, determinants, JinvT, alphaval, gammaval);
+      case 9:  // biquadratic quadrilateral
+        return EvalFixedSize<9>(pfe, determinants, JinvT, alphaval, gammaval);
+      default:
+        break;
+    }
+  }
+
+  // Sum factorization for tensor-product elements of higher degree on flat
+  // quadrilaterals. For degree <= 2 the fixed-size loops above are faster.
+  if (world_dim == 2 && quad_kernel_ && ref_el == base::RefEl::kQuad()) {
+    return EvalTensorProduct(pfe, determinants, JinvT, alphaval, gammaval);
+  }
 
   // Element matrix
   ElemMat mat(pfe.NumRefShapeFunctions(), pfe.NumRefShapeFunctions());
@@ -329,6 +426,67 @@ ReactionDiffusionElementMatrixProvider<
   return mat;
 }
 
+template <typename SCALAR, typename DIFF_COEFF, typename REACTION_COEFF>
+template <typename ALPHAVEC, typename GAMMAVEC>
+typename lf::uscalfe::ReactionDiffusionElementMatrixProvider<
+    SCALAR, DIFF_COEFF, REACTION_COEFF>::ElemMat
+ReactionDiffusionElementMatrixProvider<SCALAR, DIFF_COEFF, REACTION_COEFF>::
+    EvalTensorProduct(
+        const PrecomputedScalarReferenceFiniteElement<SCALAR> &pfe,
+        const Eigen::Ref<const Eigen::VectorXd> &determinants,
+        const Eigen::Ref<const Eigen::MatrixXd> &JinvT,
+        const ALPHAVEC &alphaval, const GAMMAVEC &gammaval) const {
+  const base::size_type nq = pfe.Qr().NumPoints();
+  Eigen::Matrix<SCALAR, 2, Eigen::Dynamic> diff(2, 2 * nq);
+  Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> reac(nq);
+  for (base::size_type k = 0; k < nq; ++k) {
+    const double w = pfe.Qr().Weights()[k] * determinants[k];
+    const Eigen::Matrix2d jac_inv_t{JinvT.template block<2, 2>(0, 2 * k)};
+    // Pull back of the diffusion coefficient to the reference square
+    diff.template block<2, 2>(0, 2 * k) =
+        w * (alphaval[k] * jac_inv_t).transpose() * jac_inv_t;
+    reac[k] = w * gammaval[k];
+  }
+  return quad_kernel_->ElementMatrix(diff, reac);
+}
+
+template <typename SCALAR, typename DIFF_COEFF, typename REACTION_COEFF>
+template <int NSF, typename ALPHAVEC, typename GAMMAVEC>
+typename lf::uscalfe::ReactionDiffusionElementMatrixProvider<
+    SCALAR, DIFF_COEFF, REACTION_COEFF>::ElemMat
+ReactionDiffusionElementMatrixProvider<SCALAR, DIFF_COEFF, REACTION_COEFF>::
+    EvalFixedSize(const PrecomputedScalarReferenceFiniteElement<SCALAR> &pfe,
+                  const Eigen::Ref<const Eigen::VectorXd> &determinants,
+                  const Eigen::Ref<const Eigen::MatrixXd> &JinvT,
+                  const ALPHAVEC &alphaval, const GAMMAVEC &gammaval) {
+  LF_ASSERT_MSG(pfe.NumRefShapeFunctions() == NSF,
+                "Mismatch " << pfe.NumRefShapeFunctions() << " <-> " << NSF);
+  const Eigen::MatrixXd &ref_grads{
+      pfe.PrecompGradientsReferenceShapeFunctions()};
+  const Eigen::MatrixXd &ref_vals{pfe.PrecompReferenceShapeFunctions()};
+
+  // Element matrix
+  Eigen::Matrix<SCALAR, NSF, NSF> mat;
+  mat.setZero();
+
+  // Loop over quadrature points
+  for (base::size_type k = 0; k < pfe.Qr().NumPoints(); ++k) {
+    const double w = pfe.Qr().Weights()[k] * determinants[k];
+    // Transformed gradients
+    const Eigen::Matrix<double, 2, NSF> trf_grad(
+        JinvT.template block<2, 2>(0, 2 * k) *
+        ref_grads.template block<NSF, 2>(0, 2 * k).transpose());
+    // Values of reference shape functions
+    const Eigen::Matrix<double, NSF, 1> shap_val(
+        ref_vals.template block<NSF, 1>(0, k));
+    // Transformed gradients multiplied with coefficient
+    const auto alpha_trf_grad((alphaval[k] * trf_grad).eval());
+    mat += w * (alpha_trf_grad.transpose() * trf_grad +
+                (gammaval[k] * shap_val) * shap_val.transpose());
+  }
+  return mat;
+}
+
 /**
  * @ingroup entity_matrix_provider
  * @headerfile lf/uscalfe/uscalfe.h
@@ -582,6 +740,18 @@ class ScalarLoadElementVectorProvider {
    */
   ElemVec Eval(const lf::mesh::Entity &cell);
 
+  /**
+   * @brief Take integration elements from a cache
+   *
+   * @param geo_cache cache for the mesh of the cells passed to Eval(). It is
+   *        used for all cells whose quadrature rule it covers, see
+   *        QuadPointGeometryCache::Covers(). `nullptr` switches caching off.
+   */
+  void SetGeometryCache(
+      std::shared_ptr<const QuadPointGeometryCache> geo_cache) {
+    geo_cache_ = std::move(geo_cache);
+  }
+
   virtual ~ScalarLoadElementVectorProvider() = default;
 
  private:
@@ -589,6 +759,8 @@ class ScalarLoadElementVectorProvider {
   MESH_FUNCTION f_;
 
   std::array<PrecomputedScalarReferenceFiniteElement<SCALAR>, 5> fe_precomp_;
+  /** @brief optional precomputed geometric quantities */
+  std::shared_ptr<const QuadPointGeometryCache> geo_cache_;
 
  public:
   /*
@@ -691,8 +863,9 @@ ScalarLoadElementVectorProvider<SCALAR, MESH_FUNCTION>::Eval(
                               << std::endl);
 
   // Obtain the metric factors for the quadrature points
-  const Eigen::VectorXd determinants(
-      geo_ptr->IntegrationElement(pfe.Qr().Points()));
+  CellQuadPointGeometry cell_geo(geo_cache_.get(), cell, pfe.Qr());
+  const Eigen::Map<const Eigen::VectorXd> determinants{
+      cell_geo.IntegrationElement()};
   LF_ASSERT_MSG(
       determinants.size() == pfe.Qr().NumPoints(),
       "Mismatch " << determinants.size() << " <-> " << pfe.Qr().NumPoints());
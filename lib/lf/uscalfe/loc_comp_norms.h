@@ -106,6 +106,18 @@ class MeshFunctionL2NormDifference {
   template <typename DOFVECTOR>
   double operator()(const lf::mesh::Entity &cell, const DOFVECTOR &dofs);
 
+  /**
+   * @brief Take geometric quantities at quadrature points from a cache
+   *
+   * @param geo_cache cache for the mesh of the cells passed to `operator()`.
+   *        It is used for all cells whose quadrature rule it covers, see
+   *        QuadPointGeometryCache::Covers(). `nullptr` switches caching off.
+   */
+  void SetGeometryCache(
+      std::shared_ptr<const QuadPointGeometryCache> geo_cache) {
+    geo_cache_ = std::move(geo_cache);
+  }
+
   /** Virtual destructor */
   virtual ~MeshFunctionL2NormDifference() = default;
 
@@ -116,6 +128,8 @@ class MeshFunctionL2NormDifference {
 
   /** @brief cell-type dependent but cell-independent information */
   std::array<PrecomputedScalarReferenceFiniteElement<double>, 5> fe_precomp_;
+  /** @brief optional precomputed geometric quantities */
+  std::shared_ptr<const QuadPointGeometryCache> geo_cache_;
 
  public:
   /** @brief output control variable */
@@ -158,10 +172,11 @@ double MeshFunctionL2NormDifference<FUNCTOR>::operator()(
                               << geo_ptr->Global(ref_el.NodeCoords())
                               << std::endl);
 
-  // World coordinates of quadrature points
-  const Eigen::MatrixXd mapped_qpts(geo_ptr->Global(qr_Points));
+  // Geometric quantities at quadrature points, possibly precomputed
+  CellQuadPointGeometry cell_geo(geo_cache_.get(), cell, fe.Qr());
   // Obtain the metric factors for the quadrature points
-  const Eigen::VectorXd determinants(geo_ptr->IntegrationElement(qr_Points));
+  const Eigen::Map<const Eigen::VectorXd> determinants{
+      cell_geo.IntegrationElement()};
   SWITCHEDSTATEMENT(
       ctrl_, kout_comp, std::cout << "\t dofs = "; for (auto x
                                                         : dofs) {
@@ -187,7 +202,9 @@ double MeshFunctionL2NormDifference<FUNCTOR>::operator()(
     // sum the quared modulus weighted with quadrature weight and metric factor
     sum += qr_Weights[k] * determinants[k] * std::fabs(uh_val * uh_val);
     SWITCHEDSTATEMENT(ctrl_, kout_comp,
-                      std::cout << "\t @ " << (mapped_qpts.col(k)).transpose()
+                      std::cout << "\t @ "
+                                << geo_ptr->Global(qr_Points.col(k))
+                                       .transpose()
                                 << ": uh = " << uh_val << ", u = " << uvals[k]
                                 << std::endl);
   }
@@ -288,6 +305,18 @@ class MeshFunctionL2GradientDifference {
   template <typename DOFVECTOR>
   double operator()(const lf::mesh::Entity &cell, const DOFVECTOR &dofs);
 
+  /**
+   * @brief Take geometric quantities at quadrature points from a cache
+   *
+   * @param geo_cache cache for the mesh of the cells passed to `operator()`.
+   *        It is used for all cells whose quadrature rule it covers, see
+   *        QuadPointGeometryCache::Covers(). `nullptr` switches caching off.
+   */
+  void SetGeometryCache(
+      std::shared_ptr<const QuadPointGeometryCache> geo_cache) {
+    geo_cache_ = std::move(geo_cache);
+  }
+
   virtual ~MeshFunctionL2GradientDifference() = default;
 
  private:
@@ -297,6 +326,8 @@ class MeshFunctionL2GradientDifference {
   VEC_FUNC vecfield_;
 
   std::array<PrecomputedScalarReferenceFiniteElement<double>, 5> fe_precomp_;
+  /** @brief optional precomputed geometric quantities */
+  std::shared_ptr<const QuadPointGeometryCache> geo_cache_;
 
  public:
   /** @brief output control variable */
@@ -342,12 +373,14 @@ double MeshFunctionL2GradientDifference<VEC_FUNC>::operator()(
                               << geo_ptr->Global(ref_el.NodeCoords())
                               << std::endl);
 
-  // World coordinates of quadrature points
-  const Eigen::MatrixXd mapped_qpts(geo_ptr->Global(qr_Points));
+  // Geometric quantities at quadrature points, possibly precomputed
+  CellQuadPointGeometry cell_geo(geo_cache_.get(), cell, pfe.Qr());
   // Obtain the metric factors for the quadrature points
-  const Eigen::VectorXd determinants(geo_ptr->IntegrationElement(qr_Points));
+  const Eigen::Map<const Eigen::VectorXd> determinants{
+      cell_geo.IntegrationElement()};
   // Fetch the transformation matrices for gradients
-  const Eigen::MatrixXd JinvT(geo_ptr->JacobianInverseGramian(qr_Points));
+  const Eigen::Map<const Eigen::MatrixXd> JinvT{
+      cell_geo.JacobianInverseGramian()};
 
   SWITCHEDSTATEMENT(
       ctrl_, kout_comp, std::cout << "\t dofs = "; for (auto x
@@ -382,7 +415,9 @@ double MeshFunctionL2GradientDifference<VEC_FUNC>::operator()(
     sum += qr_Weights[k] * determinants[k] * grad_uh_val.squaredNorm();
     // clang-format on
     SWITCHEDSTATEMENT(ctrl_, kout_comp,
-                      std::cout << "\t @ " << (mapped_qpts.col(k)).transpose()
+                      std::cout << "\t @ "
+                                << geo_ptr->Global(qr_Points.col(k))
+                                       .transpose()
                                 << ": grad uh = [" << grad_uh_val.transpose()
                                 << "[, vf = [" << vfval[k][0] << ' '
                                 << vfval[k][1] << "]" << std::endl);
@@ -0,0 +1,322 @@
+/**
+ * @file
+ * @brief Matrix-free application of the Galerkin matrix of a
+ *        reaction-diffusion operator
+ * @copyright MIT License
+ */
+
+#ifndef __9a4e2c71d05b4f38b6e3d8f1c27a5e04
+#define __9a4e2c71d05b4f38b6e3d8f1c27a5e04
+
+#include <lf/mesh/utils/utils.h>
+#include <lf/quad/quad.h>
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "precomputed_scalar_reference_finite_element.h"
+#include "tensor_product_quad_kernel.h"
+#include "uniform_scalar_fe_space.h"
+
+namespace lf::uscalfe {
+template <class SCALAR, class DIFF_COEFF, class REACTION_COEFF>
+class MatrixFreeReactionDiffusionOperator;
+}  // namespace lf::uscalfe
+
+namespace Eigen::internal {
+// An operator of the type below behaves like a sparse matrix in Eigen
+// expressions, in particular in the iterative solvers of Eigen
+template <class SCALAR, class DIFF_COEFF, class REACTION_COEFF>
+struct traits<lf::uscalfe::MatrixFreeReactionDiffusionOperator<
+    SCALAR, DIFF_COEFF, REACTION_COEFF>>
+    : public Eigen::internal::traits<Eigen::SparseMatrix<SCALAR>> {};
+}  // namespace Eigen::internal
+
+namespace lf::uscalfe {
+
+/**
+ * @headerfile lf/uscalfe/uscalfe.h
+ * @brief Galerkin matrix of the bilinear form of
+ *        ReactionDiffusionElementMatrixProvider as an operator that is applied
+ *        without assembling it
+ *
+ * @tparam SCALAR type for the entries of the matrix
+ * @tparam DIFF_COEFF a \ref mesh_function "MeshFunction" that defines the
+ *         diffusion coefficient \f$ \mathbf{\alpha} \f$, scalar or matrix
+ *         valued
+ * @tparam REACTION_COEFF a \ref mesh_function "MeshFunction" that defines the
+ *         scalar valued reaction coefficient \f$ \gamma \f$
+ *
+ * The operator represents the matrix that lf::assemble::AssembleMatrixLocally()
+ * would build with a ReactionDiffusionElementMatrixProvider for the same
+ * finite element space and coefficients. Its product with a vector is computed
+ * cell by cell:
+ * -# the coefficient vector of the cell is gathered,
+ * -# the finite element function and its gradient are evaluated at the
+ *    quadrature points,
+ * -# they are multiplied with the coefficients and geometric factors, and
+ * -# integrated against all local shape functions, the results are scattered.
+ *
+ * The coefficients, quadrature weights and geometric factors are computed once
+ * by the constructor: they are merged into one 2x2 matrix and one number per
+ * quadrature point, see TensorProductQuadKernel::ElementMatrix(). For
+ * tensor-product elements on quadrilaterals the evaluation and integration use
+ * TensorProductQuadKernel and cost \f$O(p^3)\f$ per cell, otherwise they cost
+ * \f$O(p^4)\f$. Neither element matrices nor the global matrix are stored.
+ * The local vectors and intermediate results are kept in thread-local scratch
+ * memory, which is reused for all cells and all products.
+ *
+ * The class derives from `Eigen::EigenBase`, so that `A * x` is a valid Eigen
+ * expression for a vector `x` and an object can be passed to the iterative
+ * solvers of Eigen, see the example below. Only the identity preconditioner is
+ * supported, since the entries of the matrix are not available.
+ *
+ * @note Only planar meshes are supported. The coefficients are evaluated when
+ * the operator is built and later changes of them are not seen.
+ *
+ * #### Example
+ * ~~~
+ * lf::uscalfe::MatrixFreeReactionDiffusionOperator A(fe_space, alpha, gamma);
+ * Eigen::ConjugateGradient<decltype(A), Eigen::Lower | Eigen::Upper,
+ *                          Eigen::IdentityPreconditioner>
+ *     cg;
+ * cg.compute(A);
+ * Eigen::VectorXd x = cg.solve(rhs);
+ * ~~~
+ */
+template <class SCALAR, class DIFF_COEFF, class REACTION_COEFF>
+class MatrixFreeReactionDiffusionOperator
+    : public Eigen::EigenBase<MatrixFreeReactionDiffusionOperator<
+          SCALAR, DIFF_COEFF, REACTION_COEFF>> {
+  static_assert(mesh::utils::isMeshFunction<DIFF_COEFF>);
+  static_assert(mesh::utils::isMeshFunction<REACTION_COEFF>);
+
+ public:
+  /** @name Type definitions required by Eigen
+   * @{ */
+  using Scalar = SCALAR;
+  using RealScalar = typename Eigen::NumTraits<SCALAR>::Real;
+  using StorageIndex = int;
+  enum {
+    ColsAtCompileTime = Eigen::Dynamic,
+    MaxColsAtCompileTime = Eigen::Dynamic,
+    IsRowMajor = false
+  };
+  /** @} */
+
+  using size_type = lf::base::size_type;
+  using Vec = Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>;
+
+  /**
+   * @brief Precompute the coefficients and geometric factors at the quadrature
+   *        points of all cells
+   *
+   * @param fe_space collection of specifications for scalar-valued parametric
+   * reference elements
+   * @param alpha mesh function for the (possibly matrix-valued) diffusion
+   * coefficient
+   * @param gamma mesh function for the scalar-valued reaction coefficient
+   *
+   * As in ReactionDiffusionElementMatrixProvider, the quadrature rules are
+   * exact for polynomials of twice the degree of the finite element space.
+   */
+  MatrixFreeReactionDiffusionOperator(
+      std::shared_ptr<const UniformScalarFESpace<SCALAR>> fe_space,
+      DIFF_COEFF alpha, REACTION_COEFF gamma);
+
+  /** @brief number of rows, equal to the number of global shape functions */
+  [[nodiscard]] Eigen::Index rows() const {
+    return fe_space_->LocGlobMap().NumDofs();
+  }
+  /** @brief number of columns, equal to the number of global shape functions */
+  [[nodiscard]] Eigen::Index cols() const { return rows(); }
+
+  /** @brief Lazy product with a vector, evaluated by AddTo() */
+  template <class RHS>
+  Eigen::Product<MatrixFreeReactionDiffusionOperator, RHS,
+                 Eigen::AliasFreeProduct>
+  operator*(const Eigen::MatrixBase<RHS> &x) const {
+    return {*this, x.derived()};
+  }
+
+  /**
+   * @brief Computes `y += scale * A * x`
+   * @param x vector of length cols()
+   * @param y vector of length rows()
+   * @param scale factor for the product
+   */
+  template <class VEC_X, class VEC_Y>
+  void AddTo(const VEC_X &x, VEC_Y &y, SCALAR scale = 1) const;
+
+ private:
+  std::shared_ptr<const UniformScalarFESpace<SCALAR>> fe_space_;
+  // fe_precomp_[i] contains precomputed reference finite element for ref_el i.
+  std::array<PrecomputedScalarReferenceFiniteElement<SCALAR>, 5> fe_precomp_;
+  // sum factorization for quadrilaterals, if available
+  std::optional<TensorProductQuadKernel<SCALAR>> quad_kernel_;
+  // the quadrature points of cell i have the numbers
+  // point_offset_[i], ..., point_offset_[i+1]-1
+  std::vector<size_type> point_offset_;
+  // local vectors and scratch memory of the sum factorization, see AddTo()
+  struct Scratch {
+    Vec x_loc;
+    Vec y_loc;
+    typename TensorProductQuadKernel<SCALAR>::Workspace kernel;
+  };
+  // 2x2 blocks of the pulled back diffusion coefficient, column by column
+  Eigen::Matrix<SCALAR, 2, Eigen::Dynamic> diff_;
+  // pulled back reaction coefficient
+  Vec reac_;
+};
+
+template <class PTR, class DIFF_COEFF, class REACTION_COEFF>
+MatrixFreeReactionDiffusionOperator(PTR fe_space, DIFF_COEFF alpha,
+                                    REACTION_COEFF gamma)
+    ->MatrixFreeReactionDiffusionOperator<typename PTR::element_type::Scalar,
+                                          DIFF_COEFF, REACTION_COEFF>;
+
+template <class SCALAR, class DIFF_COEFF, class REACTION_COEFF>
+MatrixFreeReactionDiffusionOperator<SCALAR, DIFF_COEFF, REACTION_COEFF>::
+    MatrixFreeReactionDiffusionOperator(
+        std::shared_ptr<const UniformScalarFESpace<SCALAR>> fe_space,
+        DIFF_COEFF alpha, REACTION_COEFF gamma)
+    : fe_space_(std::move(fe_space)) {
+  const lf::mesh::Mesh &mesh{*fe_space_->Mesh()};
+  LF_VERIFY_MSG(mesh.DimMesh() == 2 && mesh.DimWorld() == 2,
+                "Only implemented for planar meshes");
+  for (auto ref_el : {base::RefEl::kTria(), base::RefEl::kQuad()}) {
+    auto fe = fe_space_->ShapeFunctionLayout(ref_el);
+    if (fe != nullptr) {
+      fe_precomp_[ref_el.Id()] = PrecomputedScalarReferenceFiniteElement(
+          fe, quad::make_QuadRule(ref_el, 2 * fe->Degree()));
+    }
+  }
+  const auto &pfe_quad{fe_precomp_[base::RefEl::kQuad().Id()]};
+  if (pfe_quad.isInitialized()) {
+    quad_kernel_ =
+        TensorProductQuadKernel<SCALAR>::Make(pfe_quad, pfe_quad.Qr());
+  }
+
+  // Numbering of the quadrature points of all cells
+  const size_type num_cells = mesh.NumEntities(0);
+  point_offset_.resize(num_cells + 1);
+  point_offset_[0] = 0;
+  for (size_type i = 0; i < num_cells; ++i) {
+    const base::RefEl ref_el{mesh.EntityByIndex(0, i)->RefEl()};
+    LF_VERIFY_MSG(fe_precomp_[ref_el.Id()].isInitialized(),
+                  "No local shape function information for " << ref_el);
+    point_offset_[i + 1] =
+        point_offset_[i] + fe_precomp_[ref_el.Id()].Qr().NumPoints();
+  }
+  diff_.resize(2, 2 * point_offset_[num_cells]);
+  reac_.resize(point_offset_[num_cells]);
+
+  // Pull back of the coefficients to the reference cells, combined with the
+  // quadrature weights, as in ReactionDiffusionElementMatrixProvider
+  for (size_type i = 0; i < num_cells; ++i) {
+    const mesh::Entity &cell{*mesh.EntityByIndex(0, i)};
+    const quad::QuadRule &qr{fe_precomp_[cell.RefEl().Id()].Qr()};
+    const geometry::Geometry &geo{*cell.Geometry()};
+    const Eigen::VectorXd determinants{geo.IntegrationElement(qr.Points())};
+    const Eigen::MatrixXd JinvT{geo.JacobianInverseGramian(qr.Points())};
+    const auto alphaval = alpha(cell, qr.Points());
+    const auto gammaval = gamma(cell, qr.Points());
+    for (base::size_type k = 0; k < qr.NumPoints(); ++k) {
+      const double w = qr.Weights()[k] * determinants[k];
+      const Eigen::Matrix2d jac_inv_t{JinvT.block<2, 2>(0, 2 * k)};
+      const size_type q = point_offset_[i] + k;
+      diff_.template block<2, 2>(0, 2 * q) =
+          w * (alphaval[k] * jac_inv_t).transpose() * jac_inv_t;
+      reac_[q] = w * gammaval[k];
+    }
+  }
+}
+
+template <class SCALAR, class DIFF_COEFF, class REACTION_COEFF>
+template <class VEC_X, class VEC_Y>
+void MatrixFreeReactionDiffusionOperator<SCALAR, DIFF_COEFF, REACTION_COEFF>::
+    AddTo(const VEC_X &x, VEC_Y &y, SCALAR scale) const {
+  const lf::mesh::Mesh &mesh{*fe_space_->Mesh()};
+  const lf::assemble::DofHandler &dofh{fe_space_->LocGlobMap()};
+  LF_ASSERT_MSG(x.size() == cols(), "Mismatch " << x.size() << " <-> "
+                                                << cols());
+  LF_ASSERT_MSG(y.size() == rows(), "Mismatch " << y.size() << " <-> "
+                                                << rows());
+  // The local vectors are kept by every thread for all cells and products
+  Scratch &scratch{mesh::utils::ThreadLocalBuffer<Scratch, Scratch>(1)[0]};
+  Vec &x_loc{scratch.x_loc};
+  Vec &y_loc{scratch.y_loc};
+  for (const mesh::Entity *cell : mesh.Entities(0)) {
+    const size_type i = mesh.Index(*cell);
+    const size_type offset = point_offset_[i];
+    const auto nq = static_cast<Eigen::Index>(point_offset_[i + 1] - offset);
+    const auto dofs{dofh.GlobalDofIndices(*cell)};
+    const auto n = static_cast<Eigen::Index>(dofs.size());
+    // gather
+    x_loc.resize(n);
+    for (Eigen::Index l = 0; l < n; ++l) {
+      x_loc[l] = x(dofs[l]);
+    }
+    const auto diff = diff_.middleCols(2 * offset, 2 * nq);
+    const auto reac = reac_.segment(offset, nq);
+    if (quad_kernel_ && cell->RefEl() == base::RefEl::kQuad()) {
+      // sum factorization
+      y_loc.resize(n);
+      quad_kernel_->ApplyElementMatrix(diff, reac, x_loc, y_loc,
+                                       scratch.kernel);
+    } else {
+      // dense products with the values of the reference shape functions
+      const PrecomputedScalarReferenceFiniteElement<SCALAR> &pfe{
+          fe_precomp_[cell->RefEl().Id()]};
+      const auto &ref_vals{pfe.PrecompReferenceShapeFunctions()};
+      const auto &ref_grads{pfe.PrecompGradientsReferenceShapeFunctions()};
+      y_loc.setZero(n);
+      for (Eigen::Index k = 0; k < nq; ++k) {
+        const auto grad_k = ref_grads.block(0, 2 * k, n, 2);
+        const Eigen::Matrix<SCALAR, 2, 1> grad{grad_k.transpose() * x_loc};
+        const SCALAR val = ref_vals.col(k).dot(x_loc);
+        const Eigen::Matrix<SCALAR, 2, 1> flux{
+            diff.template block<2, 2>(0, 2 * k) * grad};
+        y_loc.noalias() += grad_k * flux;
+        y_loc += (reac[k] * val) * ref_vals.col(k);
+      }
+    }
+    // scatter
+    for (Eigen::Index l = 0; l < n; ++l) {
+      y(dofs[l]) += scale * y_loc[l];
+    }
+  }
+}
+
+}  // namespace lf::uscalfe
+
+namespace Eigen::internal {
+// Evaluation of the products of a MatrixFreeReactionDiffusionOperator with
+// vectors through AddTo()
+template <class SCALAR, class DIFF_COEFF, class REACTION_COEFF, class RHS>
+struct generic_product_impl<lf::uscalfe::MatrixFreeReactionDiffusionOperator<
+                                SCALAR, DIFF_COEFF, REACTION_COEFF>,
+                            RHS, SparseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<
+          lf::uscalfe::MatrixFreeReactionDiffusionOperator<SCALAR, DIFF_COEFF,
+                                                           REACTION_COEFF>,
+          RHS,
+          generic_product_impl<
+              lf::uscalfe::MatrixFreeReactionDiffusionOperator<
+                  SCALAR, DIFF_COEFF, REACTION_COEFF>,
+              RHS>> {
+  using Op = lf::uscalfe::MatrixFreeReactionDiffusionOperator<
+      SCALAR, DIFF_COEFF, REACTION_COEFF>;
+  using Scalar = typename Product<Op, RHS>::Scalar;
+
+  template <typename DEST>
+  static void scaleAndAddTo(DEST &dst, const Op &lhs, const RHS &rhs,
+                            const Scalar &alpha) {
+    lhs.AddTo(rhs, dst, alpha);
+  }
+};
+}  // namespace Eigen::internal
+
+#endif  // __9a4e2c71d05b4f38b6e3d8f1c27a5e04
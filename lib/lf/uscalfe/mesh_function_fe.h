@@ -10,12 +10,56 @@
 #ifndef __4ee2d6e8004446558bc6d2186596e392
 #define __4ee2d6e8004446558bc6d2186596e392
 
+#include <lf/mesh/utils/utils.h>
+#include <algorithm>
+#include <array>
 #include <memory>
 
 #include "uniform_scalar_fe_space.h"
 
 namespace lf::uscalfe {
 
+namespace internal {
+
+/**
+ * @brief Values (`GRADIENTS == false`) or gradients (`GRADIENTS == true`) of
+ * the reference shape functions at the points `local`, cached per thread
+ *
+ * Mesh functions are usually evaluated at the same quadrature points on all
+ * cells of a mesh. For every type of reference element the result of the last
+ * call is kept, it is recomputed only if the finite element or the points
+ * differ. The returned matrix stays valid until the next call with the same
+ * template arguments and reference element from the same thread.
+ */
+template <class SCALAR, bool GRADIENTS>
+const Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic>&
+CachedReferenceShapeFunctions(
+    const std::shared_ptr<const ScalarReferenceFiniteElement<SCALAR>>& fe,
+    const Eigen::MatrixXd& local) {
+  struct Entry {
+    // An expired finite element never matches, even if a new one is created
+    // at the same address
+    std::weak_ptr<const ScalarReferenceFiniteElement<SCALAR>> fe;
+    Eigen::MatrixXd points;
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> values;
+  };
+  thread_local std::array<Entry, 5> cache;  // NOLINT
+  Entry& entry{cache[fe->RefEl().Id()]};
+  if (entry.fe.lock() != fe || entry.points.rows() != local.rows() ||
+      entry.points.cols() != local.cols() || entry.points != local) {
+    entry.fe = fe;
+    entry.points = local;
+    if constexpr (GRADIENTS) {
+      entry.values = fe->GradientsReferenceShapeFunctions(local);
+    } else {
+      entry.values = fe->EvalReferenceShapeFunctions(local);
+    }
+  }
+  return entry.values;
+}
+
+}  // namespace internal
+
 /**
  * @headerfile lf/uscalfe/uscalfe.h
  * @ingroup mesh_function
@@ -81,6 +125,29 @@ class MeshFunctionFE {
     return result;
   }
 
+  /**
+   * @brief Evaluation into a buffer provided by the caller, see
+   * lf::mesh::utils::EvaluateMeshFunction()
+   *
+   * The values of the reference shape functions are cached per thread, see
+   * internal::CachedReferenceShapeFunctions(). Repeated evaluations at the
+   * same points do not allocate memory.
+   */
+  void EvalInto(const lf::mesh::Entity& e, const Eigen::MatrixXd& local,
+                nonstd::span<Scalar> result) const {
+    const auto& sf_eval{
+        internal::CachedReferenceShapeFunctions<SCALAR_FE, false>(
+            fe_[e.RefEl().Id()], local)};
+    auto global_dofs = fe_space_->LocGlobMap().GlobalDofIndices(e);
+    std::fill(result.begin(), result.end(), Scalar(0));
+    for (Eigen::Index i = 0; i < sf_eval.rows(); ++i) {
+      const SCALAR_COEFF coeff = dof_vector_(global_dofs[i]);
+      for (Eigen::Index j = 0; j < local.cols(); ++j) {
+        result[j] += coeff * sf_eval(i, j);
+      }
+    }
+  }
+
   /**
    * @brief Convenience method to retrieve the underlying mesh
    * @returns The mesh on which this mesh function is defined.
@@ -8,6 +8,8 @@
 
 #ifndef __b6997524e2834b5b8e4bba019fb35cc6
 #define __b6997524e2834b5b8e4bba019fb35cc6
+#include <lf/mesh/utils/utils.h>
+#include "mesh_function_fe.h"
 #include "uniform_scalar_fe_space.h"
 
 namespace lf::uscalfe {
@@ -122,7 +124,52 @@ class MeshFunctionGradFE {
     return result;
   }
 
+  /**
+   * @brief Evaluation into a buffer provided by the caller, see
+   * lf::mesh::utils::EvaluateMeshFunction()
+   *
+   * The gradients of the reference shape functions are cached per thread, see
+   * internal::CachedReferenceShapeFunctions(), and the transformation
+   * matrices are written into a thread-local matrix per reference element
+   * type by geometry::Geometry::JacobianInverseGramianInto(). The gradient with
+   * respect to reference coordinates is accumulated in a vector on the stack.
+   * Elements of `result` that already have the right size are not
+   * reallocated. Hence, repeated evaluations at the same points on
+   * first-order planar cells do not allocate memory.
+   */
+  void EvalInto(const lf::mesh::Entity& e, const Eigen::MatrixXd& local,
+                nonstd::span<Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> result)
+      const {
+    const unsigned int type_id = e.RefEl().Id();
+    LF_ASSERT_MSG(fe_[type_id] != nullptr, "Missing LSF information for " << e);
+    const auto& grad_sf_eval{
+        internal::CachedReferenceShapeFunctions<SCALAR_FE, true>(fe_[type_id],
+                                                                 local)};
+    auto global_dofs = fe_space_->LocGlobMap().GlobalDofIndices(e);
+    // one matrix per reference element type, so that alternating cell types
+    // do not change its size
+    Eigen::MatrixXd& jac_t{
+        mesh::utils::ThreadLocalBuffer<Eigen::MatrixXd, ScratchTag>(
+            5)[type_id]};
+    e.Geometry()->JacobianInverseGramianInto(local, jac_t);
+    const Eigen::Index dim_local = e.RefEl().Dimension();
+    // gradient w.r.t. reference element coordinates at a single point
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1, 0, 3, 1> local_grad(dim_local);
+    for (Eigen::Index i = 0; i < result.size(); ++i) {
+      local_grad.setZero();
+      for (Eigen::Index k = 0; k < grad_sf_eval.rows(); ++k) {
+        local_grad += dof_vector_(global_dofs[k]) *
+                      grad_sf_eval.block(k, i * dim_local, 1, dim_local)
+                          .transpose();
+      }
+      result[i].noalias() =
+          jac_t.block(0, dim_local * i, jac_t.rows(), dim_local) * local_grad;
+    }
+  }
+
  private:
+  /** @brief Tag of the thread-local scratch memory of EvalInto() */
+  struct ScratchTag {};
   /** @brief Pointer to underlying Lagrangian finite element space */
   std::shared_ptr<const UniformScalarFESpace<SCALAR_FE>> fe_space_;
   /** @brief Basis expansion coefficient vector for finite-element function */
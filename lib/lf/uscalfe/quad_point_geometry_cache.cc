@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Computation of the geometric quantities stored in a
+ *        QuadPointGeometryCache
+ * @copyright MIT License
+ */
+
+#include "quad_point_geometry_cache.h"
+#include <lf/geometry/geometry.h>
+
+namespace lf::uscalfe {
+
+QuadPointGeometryCache::QuadPointGeometryCache(
+    std::shared_ptr<const mesh::Mesh> mesh_p,
+    std::map<base::RefEl, quad::QuadRule> qr_collection)
+    : mesh_p_(std::move(mesh_p)),
+      dim_world_(mesh_p_->DimWorld()),
+      dim_mesh_(mesh_p_->DimMesh()) {
+  for (auto& [ref_el, qr] : qr_collection) {
+    LF_ASSERT_MSG(qr.RefEl() == ref_el,
+                  "qr.RefEl() = " << qr.RefEl() << " <-> " << ref_el);
+    LF_ASSERT_MSG(ref_el.Dimension() == dim_mesh_,
+                  "Quadrature rule for " << ref_el << " does not fit cells");
+    qr_[ref_el.Id()] = std::move(qr);
+  }
+
+  // Step I: numbering of the quadrature points of all cells
+  const size_type num_cells = mesh_p_->NumEntities(0);
+  point_offset_.resize(num_cells + 1);
+  point_offset_[0] = 0;
+  for (size_type i = 0; i < num_cells; ++i) {
+    const mesh::Entity& cell{*mesh_p_->EntityByIndex(0, i)};
+    point_offset_[i + 1] = point_offset_[i] + qr_[cell.RefEl().Id()].NumPoints();
+  }
+  const size_type num_points = point_offset_[num_cells];
+  integration_element_.resize(num_points);
+  jac_inv_gram_.resize(dim_world_ * dim_mesh_ * num_points);
+
+  // Step II: planar meshes, all cells of one type in a single GeometryBatch
+  if (dim_world_ == 2 && dim_mesh_ == 2) {
+    for (const auto& qr : qr_) {
+      if (qr.NumPoints() == 0) {
+        continue;
+      }
+      std::vector<const mesh::Entity*> cells;
+      for (const mesh::Entity* cell : mesh_p_->Entities(0)) {
+        if (cell->RefEl() == qr.RefEl()) {
+          cells.push_back(cell);
+        }
+      }
+      if (cells.empty()) {
+        continue;
+      }
+      const auto batch =
+          geometry::GeometryBatch::FromEntities(cells, qr.Points());
+      for (size_type j = 0; j < cells.size(); ++j) {
+        const size_type offset = point_offset_[mesh_p_->Index(*cells[j])];
+        for (size_type q = 0; q < qr.NumPoints(); ++q) {
+          integration_element_[offset + q] = batch.IntegrationElement(j, q);
+          Eigen::Map<Eigen::Matrix2d>(jac_inv_gram_.data() +
+                                      4 * (offset + q)) =
+              batch.JacobianInverseGramian(j, q);
+        }
+      }
+    }
+    return;
+  }
+
+  // Step III: other meshes, evaluation through the Geometry interface
+  for (size_type i = 0; i < num_cells; ++i) {
+    const mesh::Entity& cell{*mesh_p_->EntityByIndex(0, i)};
+    const quad::QuadRule& qr{qr_[cell.RefEl().Id()]};
+    if (qr.NumPoints() == 0) {
+      continue;
+    }
+    const geometry::Geometry& geo{*cell.Geometry()};
+    const Eigen::Index n = qr.NumPoints();
+    const size_type offset = point_offset_[i];
+    Eigen::Map<Eigen::VectorXd>(integration_element_.data() + offset, n) =
+        geo.IntegrationElement(qr.Points());
+    Eigen::Map<Eigen::MatrixXd>(
+        jac_inv_gram_.data() + dim_world_ * dim_mesh_ * offset, dim_world_,
+        dim_mesh_ * n) = geo.JacobianInverseGramian(qr.Points());
+  }
+}
+
+bool QuadPointGeometryCache::Covers(const quad::QuadRule& qr) const {
+  const quad::QuadRule& cached{qr_[qr.RefEl().Id()]};
+  return cached.NumPoints() > 0 && cached.RefEl() == qr.RefEl() &&
+         cached.NumPoints() == qr.NumPoints() &&
+         cached.Points() == qr.Points();
+}
+
+}  // namespace lf::uscalfe
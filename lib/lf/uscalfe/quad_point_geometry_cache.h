@@ -0,0 +1,212 @@
+/**
+ * @file
+ * @brief Geometric quantities at quadrature points of all cells of a mesh,
+ *        shared by local computations
+ * @copyright MIT License
+ */
+
+#ifndef __6f0c2d8e41a94b7e9f3c5a1d2e8b7c40
+#define __6f0c2d8e41a94b7e9f3c5a1d2e8b7c40
+
+#include <lf/mesh/mesh.h>
+#include <lf/quad/quad.h>
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace lf::uscalfe {
+
+/**
+ * @headerfile lf/uscalfe/uscalfe.h
+ * @brief Integration elements and inverse Gramians at the quadrature points
+ *        of all cells of a mesh
+ *
+ * Element matrix/vector providers and the local computations of norms
+ * evaluate the same geometric quantities at the same quadrature points on every
+ * cell. When several of them are used on the same mesh, e.g. within a step of a
+ * Newton method, an object of this class computes these quantities only once.
+ * It is keyed by the mesh and by one quadrature rule per type of cell. The
+ * following classes accept it through a method `SetGeometryCache()`
+ * - ReactionDiffusionElementMatrixProvider
+ * - ScalarLoadElementVectorProvider
+ * - MeshFunctionL2NormDifference
+ * - MeshFunctionL2GradientDifference
+ *
+ * and IntegrateMeshFunction() has an overload taking a cache. The cached values
+ * are used for all cells whose quadrature points coincide with those of the
+ * cache, see Covers(). All other cells are treated as before.
+ *
+ * For planar meshes the quantities are computed with
+ * lf::geometry::GeometryBatch.
+ *
+ * @note The cache refers to the geometry of the mesh at the time of its
+ * construction and must be rebuilt if the mesh changes.
+ *
+ * #### Example
+ * ~~~
+ * // quadrature rules used by default for a FE space of polynomial degree p
+ * auto cache = std::make_shared<lf::uscalfe::QuadPointGeometryCache>(
+ *     mesh_p, std::map<lf::base::RefEl, lf::quad::QuadRule>{
+ *         {lf::base::RefEl::kTria(),
+ *          lf::quad::make_QuadRule(lf::base::RefEl::kTria(), 2 * p)},
+ *         {lf::base::RefEl::kQuad(),
+ *          lf::quad::make_QuadRule(lf::base::RefEl::kQuad(), 2 * p)}});
+ * lf::uscalfe::ReactionDiffusionElementMatrixProvider elmat_builder(
+ *     fe_space, alpha, gamma);
+ * elmat_builder.SetGeometryCache(cache);
+ * lf::uscalfe::ScalarLoadElementVectorProvider elvec_builder(fe_space, f);
+ * elvec_builder.SetGeometryCache(cache);
+ * ~~~
+ */
+class QuadPointGeometryCache {
+ public:
+  using size_type = lf::base::size_type;
+
+  /**
+   * @brief Compute the geometric quantities for all cells of a mesh
+   * @param mesh_p the mesh
+   * @param qr_collection quadrature rule for every type of cell that should be
+   *        covered by the cache
+   */
+  QuadPointGeometryCache(std::shared_ptr<const mesh::Mesh> mesh_p,
+                         std::map<base::RefEl, quad::QuadRule> qr_collection);
+
+  QuadPointGeometryCache(const QuadPointGeometryCache&) = delete;
+  QuadPointGeometryCache(QuadPointGeometryCache&&) noexcept = default;
+  QuadPointGeometryCache& operator=(const QuadPointGeometryCache&) = delete;
+  QuadPointGeometryCache& operator=(QuadPointGeometryCache&&) noexcept =
+      default;
+  ~QuadPointGeometryCache() = default;
+
+  /** @brief The mesh for which the quantities have been computed */
+  [[nodiscard]] std::shared_ptr<const mesh::Mesh> Mesh() const {
+    return mesh_p_;
+  }
+
+  /**
+   * @brief The quadrature rule used for cells of type `ref_el`
+   * @note Invalid quadrature rule, if cells of this type are not covered.
+   */
+  [[nodiscard]] const quad::QuadRule& QuadRule(base::RefEl ref_el) const {
+    return qr_[ref_el.Id()];
+  }
+
+  /**
+   * @brief Tells whether the cache holds the geometric quantities at the points
+   *        of a quadrature rule
+   * @param qr a quadrature rule for some type of cell
+   * @return true, if the cache was built with a quadrature rule for cells of
+   *         type `qr.RefEl()` that has the same points as `qr`
+   */
+  [[nodiscard]] bool Covers(const quad::QuadRule& qr) const;
+
+  /**
+   * @brief Integration elements at the quadrature points of a cell, cf.
+   *        lf::geometry::Geometry::IntegrationElement()
+   * @param cell a cell of Mesh() whose type is covered by the cache
+   * @return vector with `QuadRule(cell.RefEl()).NumPoints()` entries
+   */
+  [[nodiscard]] Eigen::Map<const Eigen::VectorXd> IntegrationElement(
+      const mesh::Entity& cell) const {
+    const size_type i = CheckedIndex(cell);
+    return {integration_element_.data() + point_offset_[i],
+            static_cast<Eigen::Index>(NumPoints(i))};
+  }
+
+  /**
+   * @brief Transposed inverse Jacobians at the quadrature points of a cell, cf.
+   *        lf::geometry::Geometry::JacobianInverseGramian()
+   * @param cell a cell of Mesh() whose type is covered by the cache
+   * @return matrix of size `DimWorld() x (DimMesh() * NumPoints)`
+   */
+  [[nodiscard]] Eigen::Map<const Eigen::MatrixXd> JacobianInverseGramian(
+      const mesh::Entity& cell) const {
+    const size_type i = CheckedIndex(cell);
+    return {jac_inv_gram_.data() + dim_world_ * dim_mesh_ * point_offset_[i],
+            dim_world_, static_cast<Eigen::Index>(dim_mesh_ * NumPoints(i))};
+  }
+
+ private:
+  [[nodiscard]] size_type NumPoints(size_type i) const {
+    return point_offset_[i + 1] - point_offset_[i];
+  }
+  [[nodiscard]] size_type CheckedIndex(const mesh::Entity& cell) const {
+    LF_VERIFY_MSG(cell.Codim() == 0, "Only cells are cached");
+    LF_VERIFY_MSG(mesh_p_->Contains(cell), "Cell does not belong to the mesh");
+    LF_VERIFY_MSG(qr_[cell.RefEl().Id()].NumPoints() > 0,
+                  "Cells of type " << cell.RefEl() << " are not cached");
+    return mesh_p_->Index(cell);
+  }
+
+  std::shared_ptr<const mesh::Mesh> mesh_p_;
+  std::array<quad::QuadRule, 5> qr_;
+  Eigen::Index dim_world_;
+  Eigen::Index dim_mesh_;
+  // the quadrature points of cell i have the numbers
+  // point_offset_[i], ..., point_offset_[i+1]-1
+  std::vector<size_type> point_offset_;
+  std::vector<double> integration_element_;
+  // column-major blocks of size dim_world_ x dim_mesh_ per point
+  std::vector<double> jac_inv_gram_;
+};
+
+/**
+ * @brief Geometric quantities of a single cell at the points of a quadrature
+ *        rule, taken from a QuadPointGeometryCache whenever possible
+ *
+ * Used by local computations that accept a QuadPointGeometryCache: if no
+ * cache is given or the cache does not cover the quadrature rule, the
+ * quantities are computed through the lf::geometry::Geometry of the cell when
+ * they are requested for the first time.
+ */
+class CellQuadPointGeometry {
+ public:
+  /**
+   * @param cache the cache, may be `nullptr`
+   * @param cell the cell, must outlive this object and belong to the mesh of
+   *        the cache
+   * @param qr the quadrature rule, must outlive this object
+   */
+  CellQuadPointGeometry(const QuadPointGeometryCache* cache,
+                        const mesh::Entity& cell, const quad::QuadRule& qr)
+      : cache_((cache != nullptr && cache->Covers(qr)) ? cache : nullptr),
+        cell_(cell),
+        qr_(qr) {
+    LF_VERIFY_MSG(cache == nullptr || cache->Mesh()->Contains(cell),
+                  "Cell does not belong to the mesh of the cache");
+  }
+
+  /** @brief integration elements at the quadrature points */
+  Eigen::Map<const Eigen::VectorXd> IntegrationElement() {
+    if (cache_ != nullptr) {
+      return cache_->IntegrationElement(cell_);
+    }
+    if (integration_element_.size() == 0) {
+      integration_element_ = cell_.Geometry()->IntegrationElement(qr_.Points());
+    }
+    return {integration_element_.data(), integration_element_.size()};
+  }
+
+  /** @brief transposed inverse Jacobians at the quadrature points */
+  Eigen::Map<const Eigen::MatrixXd> JacobianInverseGramian() {
+    if (cache_ != nullptr) {
+      return cache_->JacobianInverseGramian(cell_);
+    }
+    if (jac_inv_gram_.size() == 0) {
+      jac_inv_gram_ = cell_.Geometry()->JacobianInverseGramian(qr_.Points());
+    }
+    return {jac_inv_gram_.data(), jac_inv_gram_.rows(), jac_inv_gram_.cols()};
+  }
+
+ private:
+  const QuadPointGeometryCache* cache_;
+  const mesh::Entity& cell_;
+  const quad::QuadRule& qr_;
+  Eigen::VectorXd integration_element_;
+  Eigen::MatrixXd jac_inv_gram_;
+};
+
+}  // namespace lf::uscalfe
+
+#endif  // __6f0c2d8e41a94b7e9f3c5a1d2e8b7c40
@@ -0,0 +1,485 @@
+/**
+ * @file
+ * @brief Sum-factorized local computations for tensor-product finite elements
+ *        on quadrilaterals
+ * @copyright MIT License
+ */
+
+#ifndef __3b7d51e08c2a4f6d9e1a7c5b40f2d9e6
+#define __3b7d51e08c2a4f6d9e1a7c5b40f2d9e6
+
+#include <lf/quad/quad.h>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "lagr_fe.h"
+
+namespace lf::uscalfe {
+
+/**
+ * @headerfile lf/uscalfe/uscalfe.h
+ * @brief Sum-factorized evaluation and element matrices for tensor-product
+ *        Lagrangian finite elements and tensor-product quadrature rules on
+ *        the reference square
+ *
+ * @tparam SCALAR The scalar type of the shape functions, e.g. `double`
+ *
+ * The local shape functions of the Lagrangian finite elements
+ * FeLagrangeO1Quad, FeLagrangeO2Quad and FeLagrangeO3Quad are products
+ * @f$\hat{b}^i(\hat{x}) = \hat{s}^{j(i)}(\hat{x}_1)\hat{s}^{l(i)}(\hat{x}_2)@f$
+ * of the shape functions of the Lagrangian finite elements of the same degree
+ * on a segment, and lf::quad::make_QuadRule() returns tensor-product Gauss
+ * rules for quadrilaterals. Then all sums over shape functions and quadrature
+ * points can be carried out one direction at a time. With @f$n=p+1@f$ shape
+ * functions per direction and @f$m=O(p)@f$ quadrature points per direction
+ * - evaluation of a finite element function or of its gradient at all
+ *   quadrature points costs @f$O(p^3)@f$ instead of @f$O(p^4)@f$ operations,
+ * - the same holds for the transposed operations, which integrate against all
+ *   shape functions,
+ * - an element matrix of a second-order operator costs @f$O(p^5)@f$ instead of
+ *   @f$O(p^6)@f$ operations.
+ *
+ * The one-dimensional factors are determined once when an object is built by
+ * Make(), which also checks that the finite element and the quadrature rule
+ * actually have the required tensor-product structure.
+ *
+ * All quantities refer to the reference square: geometric factors and
+ * coefficients have to be folded into the arguments of the member functions.
+ * This is done by ReactionDiffusionElementMatrixProvider, which uses this
+ * class automatically for cubic Lagrangian finite elements on quadrilaterals
+ * whenever Make() succeeds. For lower degrees its fixed-size quadrature loops
+ * are faster.
+ */
+template <class SCALAR>
+class TensorProductQuadKernel {
+ public:
+  using size_type = lf::base::size_type;
+  using Vec = Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>;
+  using Mat = Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic>;
+
+  /**
+   * @brief Build the one-dimensional factors of a finite element and a
+   *        quadrature rule on the reference square
+   *
+   * @param fe finite element on the reference square
+   * @param qr quadrature rule for the reference square
+   * @return the kernel, or `std::nullopt` if
+   *   - `fe` is not the tensor product of the Lagrangian finite element of
+   *     degree 1, 2 or 3 on a segment, or
+   *   - the points of `qr` are not a tensor-product grid numbered like those of
+   *     lf::quad::make_QuadRule(), i.e. with the second coordinate running
+   *     fastest.
+   */
+  static std::optional<TensorProductQuadKernel> Make(
+      const ScalarReferenceFiniteElement<SCALAR>& fe, const quad::QuadRule& qr);
+
+  /** @brief Number of local shape functions */
+  [[nodiscard]] size_type NumRefShapeFunctions() const {
+    return tensor_index_.size();
+  }
+
+  /** @brief Number of quadrature points */
+  [[nodiscard]] size_type NumPoints() const { return bx_.cols() * by_.cols(); }
+
+  /**
+   * @brief Values of a linear combination of the local shape functions at the
+   *        quadrature points
+   * @param coeffs coefficients of the local shape functions
+   * @return vector of length NumPoints()
+   */
+  [[nodiscard]] Vec Interpolate(const Eigen::Ref<const Vec>& coeffs) const;
+
+  /**
+   * @brief Reference gradients of a linear combination of the local shape
+   *        functions at the quadrature points
+   * @param coeffs coefficients of the local shape functions
+   * @return matrix of size `2 x NumPoints()`
+   */
+  [[nodiscard]] Eigen::Matrix<SCALAR, 2, Eigen::Dynamic> InterpolateGradients(
+      const Eigen::Ref<const Vec>& coeffs) const;
+
+  /**
+   * @brief Transpose of Interpolate()
+   * @param values one value for every quadrature point
+   * @return the vector @f$\left(\sum_k \hat{b}^i(\hat{x}_k)v_k\right)_i@f$
+   */
+  [[nodiscard]] Vec IntegrateValues(const Eigen::Ref<const Vec>& values) const;
+
+  /**
+   * @brief Transpose of InterpolateGradients()
+   * @param grads matrix of size `2 x NumPoints()`, one vector per quadrature
+   *        point
+   * @return the vector
+   *         @f$\left(\sum_k \mathbf{grad}\,\hat{b}^i(\hat{x}_k)\cdot
+   *         \mathbf{g}_k\right)_i@f$
+   */
+  [[nodiscard]] Vec IntegrateGradients(
+      const Eigen::Ref<const Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>>& grads)
+      const;
+
+  /**
+   * @brief Element matrix of a second-order operator in reference coordinates
+   *
+   * @param diff matrix of size `2 x (2*NumPoints())`, a 2x2 block
+   *        @f$\mathbf{K}_k@f$ for every quadrature point
+   * @param reac vector of length NumPoints(), a value @f$c_k@f$ for every
+   *        quadrature point
+   * @return the matrix with entries
+   * @f[
+   *   \sum_k \mathbf{grad}\,\hat{b}^i(\hat{x}_k)\cdot\mathbf{K}_k\,
+   *   \mathbf{grad}\,\hat{b}^j(\hat{x}_k) +
+   *   c_k\,\hat{b}^i(\hat{x}_k)\hat{b}^j(\hat{x}_k)\;.
+   * @f]
+   *
+   * Quadrature weights, integration elements, transformation of gradients and
+   * coefficients are all contained in @f$\mathbf{K}_k@f$ and @f$c_k@f$.
+   */
+  [[nodiscard]] Mat ElementMatrix(
+      const Eigen::Ref<const Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>>& diff,
+      const Eigen::Ref<const Vec>& reac) const;
+
+  /** @brief Scratch memory of ApplyElementMatrix(), can be reused for all cells
+   */
+  struct Workspace {
+    Mat c, t, v, gx, gy, s1, s2, r;
+  };
+
+  /**
+   * @brief Product of ElementMatrix() with a vector, without forming the matrix
+   *
+   * @param diff see ElementMatrix()
+   * @param reac see ElementMatrix()
+   * @param coeffs vector of length NumRefShapeFunctions()
+   * @param result receives `ElementMatrix(diff, reac) * coeffs`
+   * @param ws scratch memory
+   *
+   * The gradients and values at the quadrature points are computed and
+   * integrated by products of the one-dimensional factors as in
+   * InterpolateGradients() and IntegrateGradients(). All intermediate results
+   * are stored in `ws`, so that no memory is allocated if `ws` has been used
+   * with the same kernel before.
+   */
+  void ApplyElementMatrix(
+      const Eigen::Ref<const Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>>& diff,
+      const Eigen::Ref<const Vec>& reac, const Eigen::Ref<const Vec>& coeffs,
+      Eigen::Ref<Vec> result, Workspace& ws) const;
+
+ private:
+  TensorProductQuadKernel() = default;
+
+  // one-dimensional factors and coefficients of a term in AddTerms()
+  struct Term {
+    const Mat* yr;
+    const Mat* yc;
+    // the coefficient of point (a,b) is coeff[stride * (a * m_2 + b)]
+    const SCALAR* coeff;
+    Eigen::Index stride;
+  };
+  // Adds sum_a xr(j_i,a) xc(j_i',a) t_a(l_i,l_i') to mat(i,i'), where t_a is
+  // the sum over the given terms of yr * diag(coeff(a,:)) * yc^T
+  void AddTerms(Mat& mat, const Mat& xr, const Mat& xc,
+                std::initializer_list<Term> terms) const;
+
+  // Coefficients of the local shape functions arranged as an n x n matrix
+  [[nodiscard]] Mat ToTensor(const Eigen::Ref<const Vec>& coeffs) const;
+  [[nodiscard]] Vec FromTensor(const Mat& c) const;
+
+  // shape function i is s^j(x_1) s^l(x_2) with tensor_index_[i] = j + n*l
+  std::vector<Eigen::Index> tensor_index_;
+  // values and derivatives of the segment shape functions at the
+  // quadrature points in direction 1 (bx_, dx_) and 2 (by_, dy_),
+  // matrices of size n x m_1 and n x m_2
+  Mat bx_, dx_, by_, dy_;
+};
+
+template <class SCALAR>
+std::optional<TensorProductQuadKernel<SCALAR>>
+TensorProductQuadKernel<SCALAR>::Make(
+    const ScalarReferenceFiniteElement<SCALAR>& fe, const quad::QuadRule& qr) {
+  const double tol = 1.0E-10;
+  if (fe.RefEl() != base::RefEl::kQuad() ||
+      qr.RefEl() != base::RefEl::kQuad() || qr.NumPoints() == 0) {
+    return std::nullopt;
+  }
+  std::unique_ptr<ScalarReferenceFiniteElement<SCALAR>> seg;
+  switch (fe.Degree()) {
+    case 1:
+      seg = std::make_unique<FeLagrangeO1Segment<SCALAR>>();
+      break;
+    case 2:
+      seg = std::make_unique<FeLagrangeO2Segment<SCALAR>>();
+      break;
+    case 3:
+      seg = std::make_unique<FeLagrangeO3Segment<SCALAR>>();
+      break;
+    default:
+      return std::nullopt;
+  }
+  const Eigen::Index n = seg->NumRefShapeFunctions();
+  if (fe.NumRefShapeFunctions() != n * n) {
+    return std::nullopt;
+  }
+
+  // Step I: identify the factors of the shape functions by evaluating them
+  // at the tensor products of the (cardinal) evaluation nodes on the segment
+  const Eigen::MatrixXd seg_nodes{seg->EvaluationNodes()};
+  Eigen::MatrixXd nodes(2, n * n);
+  for (Eigen::Index l = 0; l < n; ++l) {
+    for (Eigen::Index j = 0; j < n; ++j) {
+      nodes(0, j + n * l) = seg_nodes(0, j);
+      nodes(1, j + n * l) = seg_nodes(0, l);
+    }
+  }
+  const Mat node_vals{fe.EvalReferenceShapeFunctions(nodes)};
+  TensorProductQuadKernel kernel;
+  kernel.tensor_index_.resize(n * n);
+  std::vector<bool> taken(n * n, false);
+  for (Eigen::Index i = 0; i < n * n; ++i) {
+    Eigen::Index idx;
+    node_vals.row(i).cwiseAbs().maxCoeff(&idx);
+    if (taken[idx] || std::abs(node_vals(i, idx) - 1.0) > tol ||
+        node_vals.row(i).cwiseAbs().sum() > 1.0 + tol) {
+      return std::nullopt;
+    }
+    taken[idx] = true;
+    kernel.tensor_index_[i] = idx;
+  }
+
+  // Step II: one-dimensional quadrature points
+  const Eigen::MatrixXd& pts{qr.Points()};
+  const Eigen::Index nq = pts.cols();
+  Eigen::Index my = 1;
+  while (my < nq && pts(0, my) == pts(0, 0)) {
+    ++my;
+  }
+  if (nq % my != 0) {
+    return std::nullopt;
+  }
+  const Eigen::Index mx = nq / my;
+  Eigen::MatrixXd x1(1, mx);
+  Eigen::MatrixXd y1(1, my);
+  for (Eigen::Index a = 0; a < mx; ++a) {
+    x1(0, a) = pts(0, a * my);
+  }
+  y1 = pts.block(1, 0, 1, my);
+  for (Eigen::Index k = 0; k < nq; ++k) {
+    if (std::abs(pts(0, k) - x1(0, k / my)) > tol ||
+        std::abs(pts(1, k) - y1(0, k % my)) > tol) {
+      return std::nullopt;
+    }
+  }
+  kernel.bx_ = seg->EvalReferenceShapeFunctions(x1);
+  kernel.dx_ = seg->GradientsReferenceShapeFunctions(x1);
+  kernel.by_ = seg->EvalReferenceShapeFunctions(y1);
+  kernel.dy_ = seg->GradientsReferenceShapeFunctions(y1);
+
+  // Step III: the shape functions must be the products of the factors
+  const Mat vals{fe.EvalReferenceShapeFunctions(pts)};
+  const Mat grads{fe.GradientsReferenceShapeFunctions(pts)};
+  for (Eigen::Index i = 0; i < n * n; ++i) {
+    const Eigen::Index j = kernel.tensor_index_[i] % n;
+    const Eigen::Index l = kernel.tensor_index_[i] / n;
+    for (Eigen::Index k = 0; k < nq; ++k) {
+      const Eigen::Index a = k / my;
+      const Eigen::Index b = k % my;
+      if (std::abs(vals(i, k) - kernel.bx_(j, a) * kernel.by_(l, b)) > tol ||
+          std::abs(grads(i, 2 * k) - kernel.dx_(j, a) * kernel.by_(l, b)) >
+              tol ||
+          std::abs(grads(i, 2 * k + 1) - kernel.bx_(j, a) * kernel.dy_(l, b)) >
+              tol) {
+        return std::nullopt;
+      }
+    }
+  }
+  return kernel;
+}
+
+template <class SCALAR>
+typename TensorProductQuadKernel<SCALAR>::Mat
+TensorProductQuadKernel<SCALAR>::ToTensor(
+    const Eigen::Ref<const Vec>& coeffs) const {
+  LF_ASSERT_MSG(coeffs.size() == NumRefShapeFunctions(),
+                "Mismatch " << coeffs.size() << " <-> "
+                            << NumRefShapeFunctions());
+  const Eigen::Index n = bx_.rows();
+  Mat c(n, n);
+  for (Eigen::Index i = 0; i < coeffs.size(); ++i) {
+    c.data()[tensor_index_[i]] = coeffs[i];
+  }
+  return c;
+}
+
+template <class SCALAR>
+typename TensorProductQuadKernel<SCALAR>::Vec
+TensorProductQuadKernel<SCALAR>::FromTensor(const Mat& c) const {
+  Vec result(NumRefShapeFunctions());
+  for (Eigen::Index i = 0; i < result.size(); ++i) {
+    result[i] = c.data()[tensor_index_[i]];
+  }
+  return result;
+}
+
+// The value at quadrature point k = a*m_2+b is entry (b,a) of an m_2 x m_1
+// matrix, so that column-major storage matches the numbering of the points.
+
+template <class SCALAR>
+typename TensorProductQuadKernel<SCALAR>::Vec
+TensorProductQuadKernel<SCALAR>::Interpolate(
+    const Eigen::Ref<const Vec>& coeffs) const {
+  const Mat v{by_.transpose() * ToTensor(coeffs).transpose() * bx_};
+  return Eigen::Map<const Vec>(v.data(), v.size());
+}
+
+template <class SCALAR>
+Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>
+TensorProductQuadKernel<SCALAR>::InterpolateGradients(
+    const Eigen::Ref<const Vec>& coeffs) const {
+  const Mat ct{ToTensor(coeffs).transpose()};
+  const Mat gx{by_.transpose() * ct * dx_};
+  const Mat gy{dy_.transpose() * ct * bx_};
+  Eigen::Matrix<SCALAR, 2, Eigen::Dynamic> result(2, NumPoints());
+  result.row(0) = Eigen::Map<const Vec>(gx.data(), gx.size()).transpose();
+  result.row(1) = Eigen::Map<const Vec>(gy.data(), gy.size()).transpose();
+  return result;
+}
+
+template <class SCALAR>
+typename TensorProductQuadKernel<SCALAR>::Vec
+TensorProductQuadKernel<SCALAR>::IntegrateValues(
+    const Eigen::Ref<const Vec>& values) const {
+  LF_ASSERT_MSG(values.size() == NumPoints(),
+                "Mismatch " << values.size() << " <-> " << NumPoints());
+  const Eigen::Map<const Mat> v(values.data(), by_.cols(), bx_.cols());
+  return FromTensor(bx_ * v.transpose() * by_.transpose());
+}
+
+template <class SCALAR>
+typename TensorProductQuadKernel<SCALAR>::Vec
+TensorProductQuadKernel<SCALAR>::IntegrateGradients(
+    const Eigen::Ref<const Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>>& grads)
+    const {
+  LF_ASSERT_MSG(grads.cols() == NumPoints(),
+                "Mismatch " << grads.cols() << " <-> " << NumPoints());
+  const Mat gx{Eigen::Map<const Mat, 0, Eigen::InnerStride<>>(
+      grads.data(), by_.cols(), bx_.cols(),
+      Eigen::InnerStride<>(grads.outerStride()))};
+  const Mat gy{Eigen::Map<const Mat, 0, Eigen::InnerStride<>>(
+      grads.data() + grads.innerStride(), by_.cols(), bx_.cols(),
+      Eigen::InnerStride<>(grads.outerStride()))};
+  return FromTensor(dx_ * gx.transpose() * by_.transpose() +
+                    bx_ * gy.transpose() * dy_.transpose());
+}
+
+template <class SCALAR>
+typename TensorProductQuadKernel<SCALAR>::Mat
+TensorProductQuadKernel<SCALAR>::ElementMatrix(
+    const Eigen::Ref<const Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>>& diff,
+    const Eigen::Ref<const Vec>& reac) const {
+  LF_ASSERT_MSG(diff.cols() == 2 * NumPoints(),
+                "Mismatch " << diff.cols() << " <-> " << 2 * NumPoints());
+  LF_ASSERT_MSG(reac.size() == NumPoints(),
+                "Mismatch " << reac.size() << " <-> " << NumPoints());
+  // Copy the entries of the 2x2 blocks into contiguous arrays
+  const Eigen::Index nq = NumPoints();
+  Eigen::Matrix<SCALAR, 4, Eigen::Dynamic> k(4, nq);
+  for (Eigen::Index q = 0; q < nq; ++q) {
+    k.col(q) = Eigen::Map<const Eigen::Matrix<SCALAR, 4, 1>>(
+        diff.template block<2, 2>(0, 2 * q).eval().data());
+  }
+  const SCALAR* k00 = k.data();
+  const SCALAR* k10 = k.data() + 1;
+  const SCALAR* k01 = k.data() + 2;
+  const SCALAR* k11 = k.data() + 3;
+
+  Mat mat = Mat::Zero(NumRefShapeFunctions(), NumRefShapeFunctions());
+  // the partial derivative in direction 1 of a shape function involves dx_
+  // and by_, the one in direction 2 bx_ and dy_
+  AddTerms(mat, dx_, dx_, {{&by_, &by_, k00, 4}});
+  AddTerms(mat, dx_, bx_, {{&by_, &dy_, k01, 4}});
+  AddTerms(mat, bx_, dx_, {{&dy_, &by_, k10, 4}});
+  AddTerms(mat, bx_, bx_, {{&dy_, &dy_, k11, 4}, {&by_, &by_, reac.data(), 1}});
+  return mat;
+}
+
+template <class SCALAR>
+void TensorProductQuadKernel<SCALAR>::ApplyElementMatrix(
+    const Eigen::Ref<const Eigen::Matrix<SCALAR, 2, Eigen::Dynamic>>& diff,
+    const Eigen::Ref<const Vec>& reac, const Eigen::Ref<const Vec>& coeffs,
+    Eigen::Ref<Vec> result, Workspace& ws) const {
+  LF_ASSERT_MSG(diff.cols() == 2 * NumPoints(),
+                "Mismatch " << diff.cols() << " <-> " << 2 * NumPoints());
+  LF_ASSERT_MSG(reac.size() == NumPoints(),
+                "Mismatch " << reac.size() << " <-> " << NumPoints());
+  LF_ASSERT_MSG(coeffs.size() == NumRefShapeFunctions() &&
+                    result.size() == NumRefShapeFunctions(),
+                "Mismatch " << coeffs.size() << ", " << result.size()
+                            << " <-> " << NumRefShapeFunctions());
+  const Eigen::Index n = bx_.rows();
+  ws.c.resize(n, n);
+  for (Eigen::Index i = 0; i < coeffs.size(); ++i) {
+    ws.c.data()[tensor_index_[i]] = coeffs[i];
+  }
+  // Values and gradients at the quadrature points, as in Interpolate() and
+  // InterpolateGradients(), one product at a time
+  ws.t.noalias() = by_.transpose() * ws.c.transpose();
+  ws.v.noalias() = ws.t * bx_;
+  ws.gx.noalias() = ws.t * dx_;
+  ws.t.noalias() = dy_.transpose() * ws.c.transpose();
+  ws.gy.noalias() = ws.t * bx_;
+  // Coefficients, quadrature weights and the geometry
+  for (Eigen::Index k = 0; k < NumPoints(); ++k) {
+    const Eigen::Matrix<SCALAR, 2, 1> g{ws.gx.data()[k], ws.gy.data()[k]};
+    const Eigen::Matrix<SCALAR, 2, 1> kg{
+        diff.template block<2, 2>(0, 2 * k) * g};
+    ws.gx.data()[k] = kg[0];
+    ws.gy.data()[k] = kg[1];
+    ws.v.data()[k] *= reac[k];
+  }
+  // Transposes of the above, as in IntegrateGradients() and IntegrateValues()
+  ws.s1.noalias() = ws.gx.transpose() * by_.transpose();
+  ws.s2.noalias() = ws.gy.transpose() * dy_.transpose();
+  ws.s2.noalias() += ws.v.transpose() * by_.transpose();
+  ws.r.noalias() = dx_ * ws.s1;
+  ws.r.noalias() += bx_ * ws.s2;
+  for (Eigen::Index i = 0; i < result.size(); ++i) {
+    result[i] = ws.r.data()[tensor_index_[i]];
+  }
+}
+
+template <class SCALAR>
+void TensorProductQuadKernel<SCALAR>::AddTerms(
+    Mat& mat, const Mat& xr, const Mat& xc,
+    std::initializer_list<Term> terms) const {
+  const Eigen::Index n = xr.rows();
+  const Eigen::Index mx = xr.cols();
+  const Eigen::Index my = by_.cols();
+  const Eigen::Index nsf = mat.rows();
+  Mat t(n, n);
+  for (Eigen::Index a = 0; a < mx; ++a) {
+    // Sum over the quadrature points in direction 2
+    t.setZero();
+    for (const Term& term : terms) {
+      const Eigen::Map<const Vec, 0, Eigen::InnerStride<>> coeff(
+          term.coeff + term.stride * a * my, my,
+          Eigen::InnerStride<>(term.stride));
+      t.noalias() += *term.yr * coeff.asDiagonal() * term.yc->transpose();
+    }
+    // Sum over the quadrature points in direction 1
+    for (Eigen::Index ic = 0; ic < nsf; ++ic) {
+      const Eigen::Index jc = tensor_index_[ic] % n;
+      const Eigen::Index lc = tensor_index_[ic] / n;
+      const SCALAR xca = xc(jc, a);
+      for (Eigen::Index ir = 0; ir < nsf; ++ir) {
+        const Eigen::Index jr = tensor_index_[ir] % n;
+        const Eigen::Index lr = tensor_index_[ir] / n;
+        mat(ir, ic) += xr(jr, a) * xca * t(lr, lc);
+      }
+    }
+  }
+}
+
+}  // namespace lf::uscalfe
+
+#endif  // __3b7d51e08c2a4f6d9e1a7c5b40f2d9e6
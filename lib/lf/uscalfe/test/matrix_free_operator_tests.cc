@@ -0,0 +1,76 @@
+/**
+ * @file
+ * @brief Tests for the matrix-free reaction-diffusion operator
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <lf/assemble/assemble.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/uscalfe/uscalfe.h>
+#include <Eigen/IterativeLinearSolvers>
+
+namespace lf::uscalfe::test {
+
+// Galerkin matrix assembled with ReactionDiffusionElementMatrixProvider
+template <class FE_SPACE, class ALPHA, class GAMMA>
+static Eigen::SparseMatrix<double> AssembledMatrix(const FE_SPACE &fe_space,
+                                                   ALPHA alpha, GAMMA gamma) {
+  ReactionDiffusionElementMatrixProvider provider(fe_space, alpha, gamma);
+  const assemble::DofHandler &dofh{fe_space->LocGlobMap()};
+  assemble::COOMatrix<double> matrix(dofh.NumDofs(), dofh.NumDofs());
+  assemble::AssembleMatrixLocally(0, dofh, dofh, provider, matrix);
+  return matrix.makeSparse();
+}
+
+TEST(lf_uscalfe_matrix_free, Product) {
+  auto mesh_p = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  auto alpha = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) -> Eigen::Matrix2d {
+        return (Eigen::Matrix2d() << 2.0 + x[0], x[1], 0.0, 1.0).finished();
+      });
+  auto gamma = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) { return x[0] * x[1]; });
+
+  auto check = [&](const auto &fe_space) {
+    const Eigen::SparseMatrix<double> A{
+        AssembledMatrix(fe_space, alpha, gamma)};
+    MatrixFreeReactionDiffusionOperator op(fe_space, alpha, gamma);
+    ASSERT_EQ(op.rows(), A.rows());
+    ASSERT_EQ(op.cols(), A.cols());
+    const Eigen::VectorXd x{Eigen::VectorXd::LinSpaced(A.cols(), -1.0, 2.0)};
+    const Eigen::VectorXd y{op * x};
+    EXPECT_TRUE(y.isApprox(A * x));
+    Eigen::VectorXd z{Eigen::VectorXd::Ones(A.rows())};
+    op.AddTo(x, z, 0.5);
+    EXPECT_TRUE(z.isApprox(Eigen::VectorXd::Ones(A.rows()) + 0.5 * (A * x)));
+  };
+  check(std::make_shared<FeSpaceLagrangeO1<double>>(mesh_p));
+  check(std::make_shared<FeSpaceLagrangeO2<double>>(mesh_p));
+  check(std::make_shared<FeSpaceLagrangeO3<double>>(mesh_p));
+}
+
+TEST(lf_uscalfe_matrix_free, ConjugateGradient) {
+  auto mesh_p = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  auto fe_space = std::make_shared<FeSpaceLagrangeO3<double>>(mesh_p);
+  auto alpha = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) { return 1.0 + x.squaredNorm(); });
+  auto gamma = mesh::utils::MeshFunctionConstant(1.0);
+
+  // Symmetric positive definite, since the reaction coefficient is positive
+  const Eigen::SparseMatrix<double> A{AssembledMatrix(fe_space, alpha, gamma)};
+  MatrixFreeReactionDiffusionOperator op(fe_space, alpha, gamma);
+  const Eigen::VectorXd rhs{Eigen::VectorXd::LinSpaced(A.rows(), 0.0, 1.0)};
+
+  Eigen::ConjugateGradient<decltype(op), Eigen::Lower | Eigen::Upper,
+                           Eigen::IdentityPreconditioner>
+      cg;
+  cg.setTolerance(1.0E-12);
+  cg.compute(op);
+  const Eigen::VectorXd x{cg.solve(rhs)};
+  EXPECT_EQ(cg.info(), Eigen::Success);
+  EXPECT_LT((A * x - rhs).norm(), 1.0E-10 * rhs.norm());
+}
+
+}  // namespace lf::uscalfe::test
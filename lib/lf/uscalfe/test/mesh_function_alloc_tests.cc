@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @brief Check that repeated evaluation of mesh functions with EvalInto() does
+ * not allocate heap memory
+ * @copyright MIT License
+ *
+ * This file replaces `malloc()` in order to count allocations. Therefore it is
+ * compiled into an executable of its own.
+ */
+
+#include <gtest/gtest.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/quad/quad.h>
+#include <lf/uscalfe/uscalfe.h>
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+std::atomic<bool> count_allocations{false};
+std::atomic<std::size_t> num_allocations{0};
+}  // namespace
+
+#if defined(__GLIBC__)
+// Both operator new and Eigen obtain their memory from malloc()
+extern "C" void *__libc_malloc(std::size_t size);  // NOLINT
+extern "C" void *malloc(std::size_t size) {        // NOLINT
+  if (count_allocations.load(std::memory_order_relaxed)) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  return __libc_malloc(size);
+}
+#endif
+
+namespace lf::uscalfe::test {
+
+// Tag of the buffer receiving the values
+struct ValuesTag {};
+
+// Evaluates mf on all cells of the mesh at the points of a quadrature rule and
+// returns the number of heap allocations during the evaluation
+template <class MF>
+std::size_t countAllocations(const lf::mesh::Mesh &mesh, const MF &mf) {
+  const std::array<quad::QuadRule, 2> qr{
+      quad::make_QuadRule(base::RefEl::kTria(), 4),
+      quad::make_QuadRule(base::RefEl::kQuad(), 4)};
+  auto values =
+      mesh::utils::ThreadLocalBuffer<mesh::utils::MeshFunctionReturnType<MF>,
+                                     ValuesTag>(std::max(qr[0].NumPoints(),
+                                                         qr[1].NumPoints()));
+  num_allocations = 0;
+  count_allocations = true;
+  for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+    const Eigen::MatrixXd &points{
+        qr[cell->RefEl() == base::RefEl::kTria() ? 0 : 1].Points()};
+    mesh::utils::EvaluateMeshFunction(mf, *cell, points,
+                                      values.first(points.cols()));
+  }
+  count_allocations = false;
+  return num_allocations;
+}
+
+TEST(meshFunctionEvalInto, NoAllocations) {
+#if !defined(__GLIBC__)
+  GTEST_SKIP() << "Counting allocations requires glibc";
+#endif
+  // Hybrid mesh with affine triangles and bilinear quadrilaterals
+  auto mesh_p = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  auto fe_space = std::make_shared<FeSpaceLagrangeO2<double>>(mesh_p);
+  const Eigen::VectorXd mu = Eigen::VectorXd::LinSpaced(
+      fe_space->LocGlobMap().NumDofs(), -1.0, 1.0);
+  const MeshFunctionFE uh(fe_space, mu);
+  const MeshFunctionGradFE grad_uh(fe_space, mu);
+  const mesh::utils::MeshFunctionGlobal alpha(
+      [](const Eigen::Vector2d &x) { return 1.0 + x[0] * x[1]; });
+  const auto alpha_grad_uh = alpha * grad_uh;
+  const auto reaction = uh * uh + alpha;
+
+  // The first evaluation fills the caches and buffers
+  countAllocations(*mesh_p, uh);
+  countAllocations(*mesh_p, grad_uh);
+  countAllocations(*mesh_p, alpha);
+  countAllocations(*mesh_p, alpha_grad_uh);
+  countAllocations(*mesh_p, reaction);
+
+  EXPECT_EQ(countAllocations(*mesh_p, uh), 0U);
+  EXPECT_EQ(countAllocations(*mesh_p, grad_uh), 0U);
+  EXPECT_EQ(countAllocations(*mesh_p, alpha), 0U);
+  EXPECT_EQ(countAllocations(*mesh_p, alpha_grad_uh), 0U);
+  EXPECT_EQ(countAllocations(*mesh_p, reaction), 0U);
+
+  // The counter is effective
+  count_allocations = true;
+  num_allocations = 0;
+  const std::vector<double> values =
+      uh(*mesh_p->EntityByIndex(0, 0), Eigen::MatrixXd::Zero(2, 3));
+  count_allocations = false;
+  EXPECT_GT(num_allocations.load(), 0U);
+}
+
+}  // namespace lf::uscalfe::test
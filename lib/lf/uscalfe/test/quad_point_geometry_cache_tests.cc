@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @brief Tests for the QuadPointGeometryCache and the local computations
+ *        that consume it
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/uscalfe/uscalfe.h>
+
+namespace lf::uscalfe::test {
+
+// Quadrature rules of the given degree for triangles and quadrilaterals
+static quad_rule_collection_t QuadRules(quad::quadDegree_t degree) {
+  return {{base::RefEl::kTria(),
+           quad::make_QuadRule(base::RefEl::kTria(), degree)},
+          {base::RefEl::kQuad(),
+           quad::make_QuadRule(base::RefEl::kQuad(), degree)}};
+}
+
+TEST(lf_uscalfe_geo_cache, ValuesMatchGeometry) {
+  for (int selector : {0, 8}) {
+    std::shared_ptr<const mesh::Mesh> mesh_p =
+        mesh::test_utils::GenerateHybrid2DTestMesh(selector);
+    const QuadPointGeometryCache cache(mesh_p, QuadRules(4));
+    for (const mesh::Entity *cell : mesh_p->Entities(0)) {
+      const quad::QuadRule &qr{cache.QuadRule(cell->RefEl())};
+      ASSERT_TRUE(cache.Covers(qr));
+      const geometry::Geometry &geo{*cell->Geometry()};
+      EXPECT_TRUE(cache.IntegrationElement(*cell).isApprox(
+          geo.IntegrationElement(qr.Points())));
+      EXPECT_TRUE(cache.JacobianInverseGramian(*cell).isApprox(
+          geo.JacobianInverseGramian(qr.Points())));
+    }
+    EXPECT_FALSE(cache.Covers(quad::make_QuadRule(base::RefEl::kTria(), 2)));
+    EXPECT_FALSE(
+        cache.Covers(quad::make_QuadRule(base::RefEl::kSegment(), 4)));
+  }
+}
+
+TEST(lf_uscalfe_geo_cache, Providers) {
+  auto mesh_p = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  auto fe_space = std::make_shared<FeSpaceLagrangeO2<double>>(mesh_p);
+  // The default quadrature rules of the providers have degree 2p = 4
+  auto cache = std::make_shared<const QuadPointGeometryCache>(mesh_p,
+                                                              QuadRules(4));
+
+  auto alpha = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) { return 1.0 + x[0] * x[1]; });
+  auto gamma = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) { return x[0] - x[1]; });
+  ReactionDiffusionElementMatrixProvider elmat(fe_space, alpha, gamma);
+  ReactionDiffusionElementMatrixProvider elmat_cached(fe_space, alpha, gamma);
+  elmat_cached.SetGeometryCache(cache);
+  ScalarLoadElementVectorProvider elvec(fe_space, alpha);
+  ScalarLoadElementVectorProvider elvec_cached(fe_space, alpha);
+  elvec_cached.SetGeometryCache(cache);
+
+  auto grad = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) { return Eigen::Vector2d(x[1], x[0]); });
+  MeshFunctionL2NormDifference l2(fe_space, alpha, 4);
+  MeshFunctionL2NormDifference l2_cached(fe_space, alpha, 4);
+  l2_cached.SetGeometryCache(cache);
+  MeshFunctionL2GradientDifference h1(fe_space, grad, 4);
+  MeshFunctionL2GradientDifference h1_cached(fe_space, grad, 4);
+  h1_cached.SetGeometryCache(cache);
+
+  for (const mesh::Entity *cell : mesh_p->Entities(0)) {
+    EXPECT_TRUE(elmat_cached.Eval(*cell).isApprox(elmat.Eval(*cell)));
+    EXPECT_TRUE(elvec_cached.Eval(*cell).isApprox(elvec.Eval(*cell)));
+    std::vector<double> dofs(9);
+    for (std::size_t i = 0; i < dofs.size(); ++i) {
+      dofs[i] = 0.5 * i - 1.0;
+    }
+    EXPECT_NEAR(l2_cached(*cell, dofs), l2(*cell, dofs), 1.0E-12);
+    EXPECT_NEAR(h1_cached(*cell, dofs), h1(*cell, dofs), 1.0E-12);
+  }
+
+  EXPECT_NEAR(IntegrateMeshFunction(*cache, alpha),
+              IntegrateMeshFunction(*mesh_p, alpha, 4), 1.0E-12);
+  // The entity predicate also applies to the first cell
+  const mesh::Entity *first = *mesh_p->Entities(0).begin();
+  auto not_first = [first](const mesh::Entity &e) { return &e != first; };
+  EXPECT_NEAR(IntegrateMeshFunction(*cache, alpha, not_first),
+              IntegrateMeshFunction(*mesh_p, alpha, 4, not_first), 1.0E-12);
+  EXPECT_NEAR(IntegrateMeshFunction(*cache, alpha, not_first) +
+                  IntegrateMeshFunction(
+                      *cache, alpha,
+                      [first](const mesh::Entity &e) { return &e == first; }),
+              IntegrateMeshFunction(*cache, alpha), 1.0E-12);
+  EXPECT_EQ(IntegrateMeshFunction(*cache, alpha, [](const mesh::Entity &) {
+              return false;
+            }),
+            0.0);
+}
+
+TEST(lf_uscalfe_geo_cache, UncoveredQuadRule) {
+  auto mesh_p = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  auto fe_space = std::make_shared<FeSpaceLagrangeO1<double>>(mesh_p);
+  // Providers for linear elements use quadrature rules of degree 2, which
+  // are not covered: the geometry must be evaluated on the fly.
+  auto cache = std::make_shared<const QuadPointGeometryCache>(mesh_p,
+                                                              QuadRules(4));
+  auto one = mesh::utils::MeshFunctionConstant(1.0);
+  ReactionDiffusionElementMatrixProvider elmat(fe_space, one, one);
+  ReactionDiffusionElementMatrixProvider elmat_cached(fe_space, one, one);
+  elmat_cached.SetGeometryCache(cache);
+  for (const mesh::Entity *cell : mesh_p->Entities(0)) {
+    EXPECT_TRUE(elmat_cached.Eval(*cell).isApprox(elmat.Eval(*cell)));
+  }
+}
+
+}  // namespace lf::uscalfe::test
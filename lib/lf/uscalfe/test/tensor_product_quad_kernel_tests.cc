@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @brief Tests for the sum-factorized local computations on quadrilaterals
+ * @copyright MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/uscalfe/uscalfe.h>
+
+namespace lf::uscalfe::test {
+
+// The points of a tensor-product rule with the first coordinate running
+// fastest: same integral, but not accepted by TensorProductQuadKernel
+static quad::QuadRule TransposedQuadRule(const quad::QuadRule &qr) {
+  const auto m = static_cast<Eigen::Index>(std::sqrt(qr.NumPoints()) + 0.5);
+  Eigen::MatrixXd points(2, m * m);
+  Eigen::VectorXd weights(m * m);
+  for (Eigen::Index a = 0; a < m; ++a) {
+    for (Eigen::Index b = 0; b < m; ++b) {
+      points.col(a + m * b) = qr.Points().col(a * m + b);
+      weights[a + m * b] = qr.Weights()[a * m + b];
+    }
+  }
+  return quad::QuadRule(base::RefEl::kQuad(), points, weights, qr.Degree());
+}
+
+TEST(lf_uscalfe_tp_kernel, Make) {
+  const auto qr = quad::make_QuadRule(base::RefEl::kQuad(), 4);
+  EXPECT_TRUE(TensorProductQuadKernel<double>::Make(FeLagrangeO1Quad<double>(),
+                                                    qr));
+  EXPECT_TRUE(TensorProductQuadKernel<double>::Make(FeLagrangeO2Quad<double>(),
+                                                    qr));
+  EXPECT_TRUE(TensorProductQuadKernel<double>::Make(FeLagrangeO3Quad<double>(),
+                                                    qr));
+  EXPECT_FALSE(TensorProductQuadKernel<double>::Make(
+      FeLagrangeO2Tria<double>(),
+      quad::make_QuadRule(base::RefEl::kTria(), 4)));
+  EXPECT_FALSE(TensorProductQuadKernel<double>::Make(
+      FeLagrangeO2Quad<double>(), TransposedQuadRule(qr)));
+}
+
+TEST(lf_uscalfe_tp_kernel, Interpolation) {
+  const FeLagrangeO3Quad<double> fe;
+  const auto qr = quad::make_QuadRule(base::RefEl::kQuad(), 5);
+  const auto kernel = TensorProductQuadKernel<double>::Make(fe, qr);
+  ASSERT_TRUE(kernel);
+  ASSERT_EQ(kernel->NumRefShapeFunctions(), 16);
+  ASSERT_EQ(kernel->NumPoints(), qr.NumPoints());
+
+  const Eigen::MatrixXd vals{fe.EvalReferenceShapeFunctions(qr.Points())};
+  const Eigen::MatrixXd grads{fe.GradientsReferenceShapeFunctions(qr.Points())};
+  const Eigen::VectorXd coeffs{Eigen::VectorXd::LinSpaced(16, -1.0, 2.0)};
+  EXPECT_TRUE(kernel->Interpolate(coeffs).isApprox(vals.transpose() * coeffs));
+  const Eigen::MatrixXd ref_grads{
+      Eigen::Map<const Eigen::MatrixXd>((coeffs.transpose() * grads).eval().data(),
+                                        2, qr.NumPoints())};
+  EXPECT_TRUE(kernel->InterpolateGradients(coeffs).isApprox(ref_grads));
+
+  const Eigen::VectorXd v{
+      Eigen::VectorXd::LinSpaced(qr.NumPoints(), 0.5, 3.0)};
+  EXPECT_TRUE(kernel->IntegrateValues(v).isApprox(vals * v));
+  Eigen::MatrixXd g(2, qr.NumPoints());
+  g.row(0) = v.transpose();
+  g.row(1) = v.reverse().transpose();
+  EXPECT_TRUE(kernel->IntegrateGradients(g).isApprox(
+      grads * Eigen::Map<const Eigen::VectorXd>(g.data(), g.size())));
+}
+
+TEST(lf_uscalfe_tp_kernel, ElementMatrix) {
+  const FeLagrangeO2Quad<double> fe;
+  const auto qr = quad::make_QuadRule(base::RefEl::kQuad(), 4);
+  const auto kernel = TensorProductQuadKernel<double>::Make(fe, qr);
+  ASSERT_TRUE(kernel);
+  const Eigen::MatrixXd vals{fe.EvalReferenceShapeFunctions(qr.Points())};
+  const Eigen::MatrixXd grads{fe.GradientsReferenceShapeFunctions(qr.Points())};
+
+  // Non-symmetric coefficients varying over the quadrature points
+  const base::size_type nq = qr.NumPoints();
+  Eigen::MatrixXd diff(2, 2 * nq);
+  Eigen::VectorXd reac(nq);
+  Eigen::MatrixXd ref = Eigen::MatrixXd::Zero(9, 9);
+  for (base::size_type k = 0; k < nq; ++k) {
+    diff.block<2, 2>(0, 2 * k) << 1.0 + k, 0.5 * k, -0.25 * k, 2.0;
+    reac[k] = 0.1 * k - 0.3;
+    const Eigen::MatrixXd g{grads.block(0, 2 * k, 9, 2)};
+    ref += g * diff.block<2, 2>(0, 2 * k) * g.transpose() +
+           reac[k] * vals.col(k) * vals.col(k).transpose();
+  }
+  EXPECT_TRUE(kernel->ElementMatrix(diff, reac).isApprox(ref));
+
+  // Products with vectors, reusing the workspace
+  TensorProductQuadKernel<double>::Workspace ws;
+  Eigen::VectorXd y(9);
+  for (const double s : {1.0, -2.0}) {
+    const Eigen::VectorXd x{s * Eigen::VectorXd::LinSpaced(9, -1.0, 1.5)};
+    kernel->ApplyElementMatrix(diff, reac, x, y, ws);
+    EXPECT_TRUE(y.isApprox(ref * x));
+  }
+}
+
+TEST(lf_uscalfe_tp_kernel, ReactionDiffusionProvider) {
+  auto mesh_p = mesh::test_utils::GenerateHybrid2DTestMesh(0);
+  auto alpha = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) -> Eigen::Matrix2d {
+        return (Eigen::Matrix2d() << 2.0 + x[0], x[1], 0.0, 1.0).finished();
+      });
+  auto gamma = mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d &x) { return x[0] * x[1]; });
+
+  auto check = [&](const auto &fe_space, quad::quadDegree_t degree) {
+    const quad::QuadRule qr = quad::make_QuadRule(base::RefEl::kQuad(), degree);
+    const quad::QuadRule qr_tria =
+        quad::make_QuadRule(base::RefEl::kTria(), degree);
+    // sum factorization
+    ReactionDiffusionElementMatrixProvider elmat_tp(
+        fe_space, alpha, gamma,
+        {{base::RefEl::kQuad(), qr}, {base::RefEl::kTria(), qr_tria}});
+    // dense quadrature loop
+    ReactionDiffusionElementMatrixProvider elmat_dense(
+        fe_space, alpha, gamma,
+        {{base::RefEl::kQuad(), TransposedQuadRule(qr)},
+         {base::RefEl::kTria(), qr_tria}});
+    for (const mesh::Entity *cell : mesh_p->Entities(0)) {
+      EXPECT_TRUE(elmat_tp.Eval(*cell).isApprox(elmat_dense.Eval(*cell)))
+          << "cell " << mesh_p->Index(*cell);
+    }
+  };
+  check(std::make_shared<FeSpaceLagrangeO1<double>>(mesh_p), 2);
+  check(std::make_shared<FeSpaceLagrangeO2<double>>(mesh_p), 4);
+  check(std::make_shared<FeSpaceLagrangeO3<double>>(mesh_p), 6);
+}
+
+}  // namespace lf::uscalfe::test
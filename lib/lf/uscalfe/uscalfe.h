@@ -22,8 +22,11 @@
 #include "lin_fe.h"
 #include "loc_comp_ellbvp.h"
 #include "loc_comp_norms.h"
+#include "matrix_free_operator.h"
 #include "mesh_function_fe.h"
 #include "mesh_function_grad_fe.h"
+#include "quad_point_geometry_cache.h"
+#include "tensor_product_quad_kernel.h"
 #include "uniform_scalar_fe_space.h"
 
 #include <lf/mesh/utils/utils.h>
@@ -19,6 +19,7 @@
 
 #include "../dpg_element_matrix_provider.h"
 #include "../dpg_element_vector_provider.h"
+#include "../dpg_gramian_cache.h"
 #include "../dpg_tools.h"
 #include "../product_element_matrix_provider_builder.h"
 #include "../product_element_vector_provider_builder.h"
@@ -216,13 +217,18 @@ TestConververgenceUltraWeakDPGConvectionDiffusionDirichletBVP(
     rhs_builder.AddLoadElementVectorProvider(v, f_mf);
     auto rhs_provider = rhs_builder.Build();
 
+    // factorize the local Gramians once for both dpg providers:
+    auto gramian_cache =
+        std::make_shared<const GramianFactorizationCache<double>>(
+            gramian_provider, mesh_p);
+
     // initialize the dpg providers:
     auto element_matrix_provider =
         std::make_shared<DpgElementMatrixProvider<double>>(stiffness_provider,
-                                                           gramian_provider);
+                                                           gramian_cache);
     auto element_vector_provider =
         std::make_shared<DpgElementVectorProvider<double>>(
-            rhs_provider, stiffness_provider, gramian_provider);
+            rhs_provider, stiffness_provider, gramian_cache);
 
     // initialize the boundary value problem
     auto h = [](const Eigen::Vector2d & /*x*/) -> double { return 0.0; };
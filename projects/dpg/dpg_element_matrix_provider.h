@@ -11,6 +11,7 @@
 
 #include <lf/mesh/mesh.h>
 
+#include "dpg_gramian_cache.h"
 #include "product_element_matrix_provider.h"
 
 #include "dpg.h"
@@ -78,6 +79,21 @@ class DpgElementMatrixProvider {
             std::move(extendedStiffnessMatrixProvider)),
         gramianProvider_(std::move(gramianProvider)) {}
 
+  /**
+   * @brief constructor using precomputed factorizations of the local Gramians
+   * @param extendedStiffnessMatrixProvider
+   * evaluates the extended element stiffness matrix \f$ B \f$
+   * @param gramianCache factorizations of the local Gramians \f$ G \f$, can be
+   * shared with a DpgElementVectorProvider
+   */
+  DpgElementMatrixProvider(
+      std::shared_ptr<ProductElementMatrixProvider<SCALAR>>
+          extendedStiffnessMatrixProvider,
+      std::shared_ptr<const GramianFactorizationCache<SCALAR>> gramianCache)
+      : extendedStiffnessMatrixProvider_(
+            std::move(extendedStiffnessMatrixProvider)),
+        gramianCache_(std::move(gramianCache)) {}
+
   /**
    * @brief All cells are considered active in the default implementation
    *
@@ -104,6 +120,9 @@ class DpgElementMatrixProvider {
   /** A ProductElementMatrixProvider that evaluates the local Gramian \f$ G \f$
    */
   std::shared_ptr<ProductElementMatrixProvider<SCALAR>> gramianProvider_;
+  /** Factorizations of the local Gramians, used instead of gramianProvider_
+   * if set */
+  std::shared_ptr<const GramianFactorizationCache<SCALAR>> gramianCache_;
 };
 
 // template deduction hint
@@ -117,16 +136,30 @@ typename DpgElementMatrixProvider<SCALAR>::ElemMat
 DpgElementMatrixProvider<SCALAR>::Eval(const lf::mesh::Entity& cell) {
   // check for nullptrs
   LF_ASSERT_MSG(extendedStiffnessMatrixProvider_ != nullptr &&
-                    gramianProvider_ != nullptr,
+                    (gramianProvider_ != nullptr || gramianCache_ != nullptr),
                 "nullptr error for some provider");
   // check that the method is called on an active cell
-  LF_ASSERT_MSG(gramianProvider_->isActive(cell) &&
+  LF_ASSERT_MSG((gramianCache_ != nullptr ? gramianCache_->isActive(cell)
+                                          : gramianProvider_->isActive(cell)) &&
                     extendedStiffnessMatrixProvider_->isActive(cell),
                 "Eval method called on inactive cell. " << cell);
 
-  // evaluate extended stiffness matrix B and local Gramian G
+  // evaluate extended stiffness matrix B
   ElemMat extendedStiffnessMatrix =
       extendedStiffnessMatrixProvider_->Eval(cell);
+
+  if (gramianCache_ != nullptr) {
+    // reuse the factorization of the local Gramian G
+    const auto& gramian_ldlt{(*gramianCache_)(cell)};
+    LF_ASSERT_MSG(
+        extendedStiffnessMatrix.rows() == gramian_ldlt.cols(),
+        "size missmatch between gramian & extended Stiffness matrix on cell "
+            << cell);
+    return extendedStiffnessMatrix.transpose() *
+           gramian_ldlt.solve(extendedStiffnessMatrix);
+  }
+
+  // evaluate local Gramian G
   ElemMat gramian = gramianProvider_->Eval(cell);
 
   // perform some size checks.
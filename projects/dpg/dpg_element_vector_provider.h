@@ -11,6 +11,7 @@
 
 #include <lf/mesh/mesh.h>
 #include "dpg.h"
+#include "dpg_gramian_cache.h"
 #include "product_element_matrix_provider.h"
 #include "product_element_vector_provider.h"
 
@@ -88,6 +89,26 @@ class DpgElementVectorProvider {
             std::move(extendedStiffnessMatrixProvider)),
         gramianProvider_(std::move(gramianProvider)) {}
 
+  /**
+   * @brief constructor using precomputed factorizations of the local Gramians
+   * @param extendedLoadVectorProvider
+   * evaluates the extended element load vector \f$ l \f$
+   * @param extendedStiffnessMatrixProvider
+   * evaluates the extended element stiffness matrix \f$B \f$
+   * @param gramianCache factorizations of the local Gramians \f$ G \f$, can be
+   * shared with a DpgElementMatrixProvider
+   */
+  DpgElementVectorProvider(
+      std::shared_ptr<ProductElementVectorProvider<SCALAR>>
+          extendedLoadVectorProvider,
+      std::shared_ptr<ProductElementMatrixProvider<SCALAR>>
+          extendedStiffnessMatrixProvider,
+      std::shared_ptr<const GramianFactorizationCache<SCALAR>> gramianCache)
+      : extendedLoadVectorProvider_(std::move(extendedLoadVectorProvider)),
+        extendedStiffnessMatrixProvider_(
+            std::move(extendedStiffnessMatrixProvider)),
+        gramianCache_(std::move(gramianCache)) {}
+
   /**
    * @brief All cells are considered active in the default implementation
    *
@@ -117,6 +138,9 @@ class DpgElementVectorProvider {
       extendedStiffnessMatrixProvider_;
   /** A ProductElementMatrixProvider, that evaluates the local Gramian G */
   std::shared_ptr<ProductElementMatrixProvider<SCALAR>> gramianProvider_;
+  /** Factorizations of the local Gramians, used instead of gramianProvider_
+   * if set */
+  std::shared_ptr<const GramianFactorizationCache<SCALAR>> gramianCache_;
 };
 
 // template deduction hint:
@@ -132,18 +156,27 @@ DpgElementVectorProvider<SCALAR>::Eval(const lf::mesh::Entity& cell) {
   // check for nullptrs
   LF_ASSERT_MSG(extendedLoadVectorProvider_ != nullptr &&
                     extendedStiffnessMatrixProvider_ != nullptr &&
-                    gramianProvider_ != nullptr,
+                    (gramianProvider_ != nullptr || gramianCache_ != nullptr),
                 "nullptr error for some provider");
   LF_ASSERT_MSG(extendedLoadVectorProvider_->isActive(cell) &&
                     extendedStiffnessMatrixProvider_->isActive(cell) &&
-                    gramianProvider_->isActive(cell),
+                    (gramianCache_ != nullptr
+                         ? gramianCache_->isActive(cell)
+                         : gramianProvider_->isActive(cell)),
                 "Eval method called on inactive cell");
 
-  // evaluate extended element vector l, extended stiffness matrix B and local
-  // Gramian G.
+  // evaluate extended element vector l and extended stiffness matrix B
   ElemVec extendedLoadVector = extendedLoadVectorProvider_->Eval(cell);
   ElemMat extendedStiffnessMatrix =
       extendedStiffnessMatrixProvider_->Eval(cell);
+
+  if (gramianCache_ != nullptr) {
+    // reuse the factorization of the local Gramian G
+    return extendedStiffnessMatrix.transpose() *
+           (*gramianCache_)(cell).solve(extendedLoadVector);
+  }
+
+  // evaluate local Gramian G.
   ElemMat gramian = gramianProvider_->Eval(cell);
 
   // perform some size checks.
@@ -0,0 +1,143 @@
+#ifndef PROJECTS_DPG_DPG_GRAMIAN_CACHE
+#define PROJECTS_DPG_DPG_GRAMIAN_CACHE
+
+/**
+ * @file
+ * @brief Cache of factorized local Gramians shared by the DPG element matrix
+ * and element vector providers
+ * @copyright MIT License
+ */
+
+#include <lf/base/parallel.h>
+#include <lf/mesh/mesh.h>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "dpg.h"
+#include "product_element_matrix_provider.h"
+
+namespace projects::dpg {
+
+/**
+ * @brief Stores the \f$ LDL^T \f$ factorization of the local Gramian \f$ G \f$
+ * of every cell of a mesh.
+ * @tparam SCALAR type for the entries of the Gramian. Usually 'double'.
+ *
+ * Both the DPG element matrix \f$ A^K = B^T G^{-1} B \f$ and the DPG element
+ * vector \f$ \phi^K = B^T G^{-1} l \f$ require the solution of linear systems
+ * with the local Gramian \f$ G \f$ on every cell \f$ K \f$. For large enriched
+ * test spaces the factorization of \f$ G \f$ dominates the cost of assembly.
+ * This class factorizes all local Gramians once, so that a
+ * DpgElementMatrixProvider and a DpgElementVectorProvider constructed from the
+ * same cache, as well as repeated assembly of element vectors for different
+ * loads, share the factorizations.
+ *
+ * @note The local Gramians are evaluated concurrently, hence the Eval() method
+ * of the Gramian provider must be safe to call from several threads. This is
+ * the case for all element matrix providers in loc_comp_dpg.h. Pass
+ * `num_threads = 1` otherwise.
+ */
+template <typename SCALAR>
+class GramianFactorizationCache {
+ public:
+  /** @brief Type of the local Gramians */
+  using ElemMat = typename ProductElementMatrixProvider<SCALAR>::ElemMat;
+  /** @brief Type of the stored factorizations */
+  using Factorization = Eigen::LDLT<ElemMat>;
+
+  /** @brief standard constructors */
+  GramianFactorizationCache(const GramianFactorizationCache&) = delete;
+  GramianFactorizationCache(GramianFactorizationCache&&) noexcept = default;
+  GramianFactorizationCache& operator=(const GramianFactorizationCache&) =
+      delete;
+  GramianFactorizationCache& operator=(GramianFactorizationCache&&) = delete;
+
+  /**
+   * @brief Evaluates and factorizes the local Gramians on all active cells
+   * @param gramianProvider evaluates the local Gramian \f$ G \f$
+   * @param mesh_p the mesh on whose cells the Gramians are evaluated
+   * @param num_threads maximal number of threads used
+   */
+  GramianFactorizationCache(
+      std::shared_ptr<ProductElementMatrixProvider<SCALAR>> gramianProvider,
+      std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+      unsigned int num_threads = lf::base::DefaultNumThreads());
+
+  /**
+   * @brief The factorization of the local Gramian on a cell
+   * @param cell an active cell of the mesh passed to the constructor
+   */
+  const Factorization& operator()(const lf::mesh::Entity& cell) const {
+    const std::optional<Factorization>& fac{factorizations_[CellIndex(cell)]};
+    LF_ASSERT_MSG(fac.has_value(), "No Gramian on inactive cell " << cell);
+    return *fac;
+  }
+
+  /**
+   * @brief Tells whether a Gramian has been factorized for a cell
+   * @param cell a cell of the mesh passed to the constructor
+   */
+  [[nodiscard]] bool isActive(const lf::mesh::Entity& cell) const {
+    return factorizations_[CellIndex(cell)].has_value();
+  }
+
+  /** @brief The mesh of the cache */
+  [[nodiscard]] std::shared_ptr<const lf::mesh::Mesh> Mesh() const {
+    return mesh_p_;
+  }
+
+  ~GramianFactorizationCache() = default;
+
+ private:
+  /** index of a cell, which must belong to the mesh of the cache */
+  [[nodiscard]] size_type CellIndex(const lf::mesh::Entity& cell) const {
+    LF_VERIFY_MSG(cell.Codim() == 0 && mesh_p_->Contains(cell),
+                  "Entity " << cell << " is not a cell of the cached mesh");
+    return mesh_p_->Index(cell);
+  }
+
+  /** the mesh on whose cells the Gramians were evaluated */
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p_;
+  /** factorization of the local Gramian for every active cell, indexed by
+   * cell index */
+  std::vector<std::optional<Factorization>> factorizations_;
+};
+
+template <typename SCALAR>
+GramianFactorizationCache<SCALAR>::GramianFactorizationCache(
+    std::shared_ptr<ProductElementMatrixProvider<SCALAR>> gramianProvider,
+    std::shared_ptr<const lf::mesh::Mesh> mesh_p, unsigned int num_threads)
+    : mesh_p_(std::move(mesh_p)) {
+  LF_ASSERT_MSG(gramianProvider != nullptr && mesh_p_ != nullptr,
+                "nullptr error for Gramian provider or mesh");
+  const size_type no_of_cells = mesh_p_->NumEntities(0);
+  factorizations_.resize(no_of_cells);
+  // Every thread fills the factorizations of a contiguous range of cells.
+  // Evaluating and factorizing a Gramian is expensive, a few dozen cells
+  // outweigh the cost of a thread.
+  constexpr size_type min_chunk_size = 64;
+  const auto num_chunks = static_cast<unsigned int>(std::max<size_type>(
+      1, std::min<size_type>(num_threads, no_of_cells / min_chunk_size)));
+  lf::base::ParallelForChunks(
+      no_of_cells, num_chunks,
+      [&](unsigned int /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+          const lf::mesh::Entity& cell{*mesh_p_->EntityByIndex(0, c)};
+          if (!gramianProvider->isActive(cell)) {
+            continue;
+          }
+          const ElemMat gramian = gramianProvider->Eval(cell);
+          LF_ASSERT_MSG(gramian.rows() == gramian.cols(),
+                        "non quadratic gramian of size ("
+                            << gramian.rows() << ", " << gramian.cols()
+                            << ") on cell " << cell << "\n");
+          factorizations_[c].emplace(gramian);
+        }
+      });
+}
+
+}  // namespace projects::dpg
+
+#endif  // PROJECTS_DPG_DPG_GRAMIAN_CACHE
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @brief Check that DPG element matrices and vectors computed from cached
+ * Gramian factorizations agree with those computed without cache.
+ * @copyright MIT License
+ */
+
+#include <lf/mesh/mesh.h>
+#include <lf/mesh/test_utils/test_meshes.h>
+#include <lf/mesh/utils/utils.h>
+
+#include <gtest/gtest.h>
+
+#include "../dpg_element_matrix_provider.h"
+#include "../dpg_element_vector_provider.h"
+#include "../dpg_gramian_cache.h"
+#include "../product_element_matrix_provider_builder.h"
+#include "../product_element_vector_provider_builder.h"
+#include "../product_fe_space_factory.h"
+
+namespace projects::dpg::test {
+
+TEST(GramianFactorizationCache, SameElementMatricesAndVectors) {
+  auto mesh_p = lf::mesh::test_utils::GenerateHybrid2DTestMesh();
+
+  // trial space and enriched test space of a primal DPG method
+  ProductUniformFESpaceFactory<double> factory_trial(mesh_p);
+  auto u = factory_trial.AddH1Component(2);
+  auto q_n = factory_trial.AddFluxComponent(1);
+  auto fe_space_trial = factory_trial.Build();
+  ProductUniformFESpaceFactory<double> factory_test(mesh_p);
+  auto v = factory_test.AddL2Component(3);
+  auto fe_space_test = factory_test.Build();
+
+  auto one_mf = lf::mesh::utils::MeshFunctionConstant(1.0);
+  auto f_mf = lf::mesh::utils::MeshFunctionGlobal(
+      [](const Eigen::Vector2d& x) -> double { return x[0] * x[1]; });
+
+  ProductElementMatrixProviderBuilder stiffness_builder(fe_space_trial,
+                                                        fe_space_test);
+  stiffness_builder.AddDiffusionElementMatrixProvider(u, v, one_mf);
+  stiffness_builder.AddFluxElementMatrixProvider(q_n, v, -one_mf);
+  auto stiffness_provider = stiffness_builder.Build();
+
+  ProductElementMatrixProviderBuilder gramian_builder(fe_space_test,
+                                                      fe_space_test);
+  gramian_builder.AddDiffusionElementMatrixProvider(v, v, one_mf);
+  gramian_builder.AddReactionElementMatrixProvider(v, v, one_mf);
+  auto gramian_provider = gramian_builder.Build();
+
+  ProductElementVectorProviderBuilder rhs_builder(fe_space_test);
+  rhs_builder.AddLoadElementVectorProvider(v, f_mf);
+  auto rhs_provider = rhs_builder.Build();
+
+  DpgElementMatrixProvider<double> mat_provider(stiffness_provider,
+                                                gramian_provider);
+  DpgElementVectorProvider<double> vec_provider(
+      rhs_provider, stiffness_provider, gramian_provider);
+
+  for (const unsigned int num_threads : {1U, 4U}) {
+    auto gramian_cache =
+        std::make_shared<const GramianFactorizationCache<double>>(
+            gramian_provider, mesh_p, num_threads);
+    DpgElementMatrixProvider<double> cached_mat_provider(stiffness_provider,
+                                                         gramian_cache);
+    DpgElementVectorProvider<double> cached_vec_provider(
+        rhs_provider, stiffness_provider, gramian_cache);
+
+    for (const lf::mesh::Entity* const cell : mesh_p->Entities(0)) {
+      EXPECT_TRUE(gramian_cache->isActive(*cell));
+      const Eigen::MatrixXd A = mat_provider.Eval(*cell);
+      const Eigen::MatrixXd A_cached = cached_mat_provider.Eval(*cell);
+      EXPECT_TRUE(A_cached.isApprox(A, 1.0E-12)) << "mismatch on " << *cell;
+      const Eigen::VectorXd phi = vec_provider.Eval(*cell);
+      const Eigen::VectorXd phi_cached = cached_vec_provider.Eval(*cell);
+      EXPECT_TRUE(phi_cached.isApprox(phi, 1.0E-12)) << "mismatch on " << *cell;
+    }
+  }
+}
+
+}  // namespace projects::dpg::test